@@ -17,6 +17,7 @@
 #include "spm.h"
 #include "solver.h"
 #include "bcsc.h"
+#include "bvec.h"
 
 #include "bcsc_z.h"
 #include "bcsc_c.h"
@@ -252,6 +253,58 @@ bcsc_init_centralized_coltab( const spmatrix_t     *spm,
     return valuesize;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @ingroup bcsc_internal
+ *
+ * @brief Compute the cblk index of each column of the local solver matrix.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The solver matrix structure that describe the data distribution.
+ *
+ * @param[in] eltnbr
+ *          The number of columns of the matrix, including the degrees of
+ *          freedom.
+ *
+ *******************************************************************************
+ *
+ * @return The array col2cblk of size eltnbr, such that col2cblk[i] is the index
+ *         of the cblk of the i-th column, or -1 if the column is not local.
+ *         The array must be freed by the caller.
+ *
+ *******************************************************************************/
+static inline pastix_int_t *
+bcsc_init_col2cblk( const SolverMatrix *solvmtx,
+                    pastix_int_t        eltnbr )
+{
+    const SolverCblk *cblk = solvmtx->cblktab;
+    pastix_int_t     *col2cblk;
+    pastix_int_t      itercol, itercblk;
+
+    MALLOC_INTERN( col2cblk, eltnbr, pastix_int_t );
+    for (itercol=0; itercol<eltnbr; itercol++)
+    {
+        col2cblk[itercol] = -1;
+    }
+
+    for (itercblk=0; itercblk<solvmtx->cblknbr; itercblk++, cblk++)
+    {
+        if( cblk->cblktype & (CBLK_FANIN|CBLK_RECV) ){
+            continue;
+        }
+        for (itercol  = cblk->fcolnum;
+             itercol <= cblk->lcolnum;
+             itercol++ )
+        {
+            col2cblk[itercol] = itercblk;
+        }
+    }
+    return col2cblk;
+}
+
 /**
  *******************************************************************************
  *
@@ -272,6 +325,10 @@ bcsc_init_centralized_coltab( const spmatrix_t     *spm,
  * @param[in] initAt
  *          A flag to enable/disable the initialization of A'
  *
+ * @param[in] isched
+ *          The internal scheduler used to build the block csc in parallel, or
+ *          NULL.
+ *
  * @param[inout] bcsc
  *          On entry, the pointer to an allocated bcsc.
  *          On exit, the bcsc stores the input spm with the permutation applied
@@ -283,17 +340,16 @@ bcsc_init_centralized( const spmatrix_t     *spm,
                        const pastix_order_t *ord,
                        const SolverMatrix   *solvmtx,
                              pastix_int_t    initAt,
+                             isched_t       *isched,
                              pastix_bcsc_t  *bcsc )
 {
-    pastix_int_t  itercol, itercblk;
-    pastix_int_t  cblknbr  = solvmtx->cblknbr;
-    pastix_int_t  eltnbr   = spm->gNexp;
     pastix_int_t *col2cblk = NULL;
 
     bcsc->mtxtype = spm->mtxtype;
     bcsc->flttype = spm->flttype;
     bcsc->gN      = spm->gN;
     bcsc->n       = spm->n;
+    bcsc->map     = NULL;
 
     assert( spm->loc2glob == NULL );
 
@@ -301,28 +357,7 @@ bcsc_init_centralized( const spmatrix_t     *spm,
      * Initialize the col2cblk array. col2cblk[i] contains the cblk index of the
      * i-th column. col2cblk[i] = -1 if not local.
      */
-    {
-        SolverCblk *cblk = solvmtx->cblktab;
-
-        MALLOC_INTERN( col2cblk, eltnbr, pastix_int_t );
-        for (itercol=0; itercol<eltnbr; itercol++)
-        {
-            col2cblk[itercol] = -1;
-        }
-
-        for (itercblk=0; itercblk<cblknbr; itercblk++, cblk++)
-        {
-            if( cblk->cblktype & (CBLK_FANIN|CBLK_RECV) ){
-                continue;
-            }
-            for (itercol  = cblk->fcolnum;
-                 itercol <= cblk->lcolnum;
-                 itercol++ )
-            {
-                col2cblk[itercol] = itercblk;
-            }
-        }
-    }
+    col2cblk = bcsc_init_col2cblk( solvmtx, spm->gNexp );
 
     /*
      * Fill in the lower triangular part of the blocked csc with values and
@@ -331,16 +366,16 @@ bcsc_init_centralized( const spmatrix_t     *spm,
      */
     switch( spm->flttype ) {
     case SpmFloat:
-        bcsc_sinit_centralized( spm, ord, solvmtx, col2cblk, initAt, bcsc );
+        bcsc_sinit_centralized( spm, ord, solvmtx, col2cblk, initAt, isched, bcsc );
         break;
     case SpmDouble:
-        bcsc_dinit_centralized( spm, ord, solvmtx, col2cblk, initAt, bcsc );
+        bcsc_dinit_centralized( spm, ord, solvmtx, col2cblk, initAt, isched, bcsc );
         break;
     case SpmComplex32:
-        bcsc_cinit_centralized( spm, ord, solvmtx, col2cblk, initAt, bcsc );
+        bcsc_cinit_centralized( spm, ord, solvmtx, col2cblk, initAt, isched, bcsc );
         break;
     case SpmComplex64:
-        bcsc_zinit_centralized( spm, ord, solvmtx, col2cblk, initAt, bcsc );
+        bcsc_zinit_centralized( spm, ord, solvmtx, col2cblk, initAt, isched, bcsc );
         break;
     case SpmPattern:
     default:
@@ -373,6 +408,10 @@ bcsc_init_centralized( const spmatrix_t     *spm,
  * @param[in] initAt
  *          A flag to enable/disable the initialization of A'
  *
+ * @param[in] isched
+ *          The internal scheduler used to build the block csc in parallel, or
+ *          NULL.
+ *
  * @param[inout] bcsc
  *          On entry, the pointer to an allocated bcsc.
  *          On exit, the bcsc stores the input spm with the permutation applied
@@ -388,6 +427,7 @@ bcscInit( const spmatrix_t     *spm,
           const pastix_order_t *ord,
           const SolverMatrix   *solvmtx,
                 pastix_int_t    initAt,
+                isched_t       *isched,
                 pastix_bcsc_t  *bcsc )
 {
     assert( ord->baseval == 0 );
@@ -397,7 +437,7 @@ bcscInit( const spmatrix_t     *spm,
     clockStart(time);
 
     if ( spm->loc2glob == NULL ) {
-        bcsc_init_centralized( spm, ord, solvmtx, initAt, bcsc );
+        bcsc_init_centralized( spm, ord, solvmtx, initAt, isched, bcsc );
     }
     else {
         fprintf(stderr, "bcscInit: Distributed SPM not yet supported");
@@ -407,6 +447,366 @@ bcscInit( const spmatrix_t     *spm,
     return time;
 }
 
+/**
+ * @brief Free the scatter map of the block csc.
+ */
+static inline void
+bcsc_map_exit( pastix_bcsc_t *bcsc )
+{
+    bcsc_map_t *map = bcsc->map;
+
+    memFree_null( map->spm2L );
+    if ( map->spm2U != NULL ) {
+        memFree_null( map->spm2U );
+    }
+    memFree_null( map->bcsc2ctab );
+    memFree_null( bcsc->map );
+}
+
+/**
+ * @brief Return the position of the value (row, col) in the block csc, and
+ * flag it as taken.
+ *
+ * The rows of each column are sorted, so the position is found by dichotomy.
+ * The first occurrence that is not yet taken is returned, such that duplicated
+ * entries are mapped to distinct values of the block csc. The routine returns
+ * -1 if the column is not local, and sets rc if the value is not found.
+ */
+static inline pastix_int_t
+bcsc_map_position( const pastix_bcsc_t *bcsc,
+                   const SolverMatrix  *solvmtx,
+                   const pastix_int_t  *col2cblk,
+                   pastix_int_t         col,
+                   pastix_int_t         row,
+                   int8_t              *taken,
+                   int                 *rc )
+{
+    const SolverCblk   *cblk;
+    const pastix_int_t *coltab;
+    pastix_int_t        first, last, mid;
+
+    if ( col2cblk[col] == -1 ) {
+        return -1;
+    }
+    cblk   = solvmtx->cblktab + col2cblk[col];
+    coltab = bcsc->cscftab[ cblk->bcscnum ].coltab + ( col - cblk->fcolnum );
+
+    first = coltab[0];
+    last  = coltab[1];
+    while ( first < last ) {
+        mid = first + ( last - first ) / 2;
+        if ( bcsc->rowtab[mid] < row ) {
+            first = mid + 1;
+        }
+        else {
+            last = mid;
+        }
+    }
+
+    while ( (first < coltab[1]) && (bcsc->rowtab[first] == row) && taken[first] ) {
+        first++;
+    }
+    if ( (first == coltab[1]) || (bcsc->rowtab[first] != row) ) {
+        *rc = 1;
+        return -1;
+    }
+
+    taken[first] = 1;
+    return first;
+}
+
+/**
+ * @brief Compute the offsets of the values of a block csc cblk in the coeftab
+ * of the associated cblk.
+ *
+ * This follows the search of cpucblk_zfillin() for the full-rank cblks. The
+ * values of the upper part, the values dropped from the coeftab, and the values
+ * of the compressed cblks are associated to -1.
+ */
+static inline void
+bcsc_map_cblk( const pastix_bcsc_t *bcsc,
+               const SolverMatrix  *solvmtx,
+               const bcsc_cblk_t   *csccblk,
+               pastix_int_t        *bcsc2ctab )
+{
+    const SolverCblk *solvcblk  = solvmtx->cblktab + csccblk->cblknum;
+    const SolverBlok *solvblok;
+    const SolverBlok *lsolvblok = (solvcblk+1)->fblokptr;
+    pastix_int_t      ldd = solvcblk->stride;
+    pastix_int_t      itercoltab, iterval;
+    int               is2d = solvcblk->cblktype & CBLK_LAYOUT_2D;
+
+    if ( solvcblk->cblktype & CBLK_COMPRESSED ) {
+        for (iterval=csccblk->coltab[0]; iterval<csccblk->coltab[csccblk->colnbr]; iterval++) {
+            bcsc2ctab[iterval] = -1;
+        }
+        return;
+    }
+
+    for (itercoltab=0; itercoltab<csccblk->colnbr; itercoltab++)
+    {
+        pastix_int_t frow = csccblk->coltab[itercoltab];
+        pastix_int_t lrow = csccblk->coltab[itercoltab+1];
+        solvblok = solvcblk->fblokptr;
+        if ( is2d ) {
+            ldd = blok_rownbr( solvblok );
+        }
+
+        for (iterval=frow; iterval<lrow; iterval++)
+        {
+            pastix_int_t rownum = bcsc->rowtab[iterval];
+
+            bcsc2ctab[iterval] = -1;
+            if (rownum < (solvcblk->fcolnum+itercoltab)) {
+                continue;
+            }
+
+            while ((solvblok < lsolvblok) &&
+                   ((solvblok->lrownum < rownum) ||
+                    (solvblok->frownum > rownum)))
+            {
+                solvblok++;
+                if ( is2d ) {
+                    ldd = blok_rownbr( solvblok );
+                }
+            }
+
+            if ( solvblok < lsolvblok ) {
+                bcsc2ctab[iterval] = solvblok->coefind
+                    + rownum - solvblok->frownum /* Row shift    */
+                    + itercoltab * ldd;          /* Column shift */
+            }
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Compute the scatter map of the values of the spm.
+ *
+ * The map associates to each value of the spm its position(s) in the block
+ * csc, and to each value of the block csc its offset in the coeftab. When only
+ * the values of the spm change, the block csc and the coeftab can then be
+ * updated with bcscUpdateValues() and coeftabRefill() without rebuilding the
+ * block csc, and without any search.
+ *
+ * The map is computed only for centralized spm with constant degrees of
+ * freedom, and it is freed with the block csc.
+ *
+ *******************************************************************************
+ *
+ * @param[in] spm
+ *          The sparse matrix used to initialize the block csc.
+ *
+ * @param[in] ord
+ *          The ordering applied to the spm to generate the block csc.
+ *
+ * @param[in] solvmtx
+ *          The solver matrix structure that describe the data distribution.
+ *
+ * @param[inout] bcsc
+ *          The block csc initialized from the spm. On exit, the map field is
+ *          set, or NULL if the map can not be computed.
+ *
+ *******************************************************************************/
+void
+bcscMapInit( const spmatrix_t     *spm,
+             const pastix_order_t *ord,
+             const SolverMatrix   *solvmtx,
+             pastix_bcsc_t        *bcsc )
+{
+    bcsc_map_t        *map;
+    const bcsc_cblk_t *blockcol;
+    pastix_int_t      *col2cblk;
+    int8_t            *takenL, *takenU = NULL;
+    pastix_int_t       valuesize, baseval, itercol, i, ival, idofcol, idofrow;
+    int                dof = spm->dof;
+    int                sym = (spm->mtxtype == SpmSymmetric) || (spm->mtxtype == SpmHermitian);
+    int                rc  = 0;
+
+    if ( bcsc->map != NULL ) {
+        bcsc_map_exit( bcsc );
+    }
+    if ( (spm->loc2glob != NULL) || (dof < 1) ) {
+        return;
+    }
+
+    valuesize = 0;
+    if ( bcsc->cscfnbr > 0 ) {
+        blockcol  = bcsc->cscftab + bcsc->cscfnbr - 1;
+        valuesize = blockcol->coltab[ blockcol->colnbr ];
+    }
+
+    MALLOC_INTERN( map, 1, bcsc_map_t );
+    map->nnzexp   = spm->nnzexp;
+    map->spm2U    = NULL;
+    map->ctabinit = 0;
+    MALLOC_INTERN( map->spm2L,     pastix_imax( map->nnzexp, 1 ), pastix_int_t );
+    MALLOC_INTERN( map->bcsc2ctab, pastix_imax( valuesize,   1 ), pastix_int_t );
+
+    MALLOC_INTERN( takenL, pastix_imax( valuesize, 1 ), int8_t );
+    memset( takenL, 0, valuesize * sizeof(int8_t) );
+    if ( sym ) {
+        MALLOC_INTERN( map->spm2U, pastix_imax( map->nnzexp, 1 ), pastix_int_t );
+    }
+    else if ( (bcsc->Uvalues != NULL) && (bcsc->Uvalues != bcsc->Lvalues) ) {
+        MALLOC_INTERN( map->spm2U, pastix_imax( map->nnzexp, 1 ), pastix_int_t );
+        MALLOC_INTERN( takenU, pastix_imax( valuesize, 1 ), int8_t );
+        memset( takenU, 0, valuesize * sizeof(int8_t) );
+    }
+
+    /*
+     * Associate each value of the spm to its position in the block csc. The
+     * pattern of the transposed part is the one of the block csc, as the
+     * pattern of the matrix is symmetric.
+     */
+    col2cblk = bcsc_init_col2cblk( solvmtx, spm->gNexp );
+    baseval  = spm->colptr[0];
+    for (itercol=0; (itercol<spm->gN) && !rc; itercol++)
+    {
+        pastix_int_t itercol2 = ord->permtab[itercol] * dof;
+
+        for (i=spm->colptr[itercol]-baseval; i<spm->colptr[itercol+1]-baseval; i++)
+        {
+            pastix_int_t iterrow  = spm->rowptr[i] - baseval;
+            pastix_int_t iterrow2 = ord->permtab[iterrow] * dof;
+
+            ival = i * dof * dof;
+            for (idofcol = 0; idofcol < dof; idofcol++)
+            {
+                for (idofrow = 0; idofrow < dof; idofrow++, ival++)
+                {
+                    pastix_int_t col = itercol2 + idofcol;
+                    pastix_int_t row = iterrow2 + idofrow;
+
+                    map->spm2L[ival] = bcsc_map_position( bcsc, solvmtx, col2cblk,
+                                                          col, row, takenL, &rc );
+                    if ( map->spm2U == NULL ) {
+                        continue;
+                    }
+                    if ( sym && (iterrow == itercol) ) {
+                        map->spm2U[ival] = -1;
+                    }
+                    else {
+                        map->spm2U[ival] = bcsc_map_position( bcsc, solvmtx, col2cblk, row, col,
+                                                              sym ? takenL : takenU, &rc );
+                    }
+                }
+            }
+        }
+    }
+    memFree_null( col2cblk );
+    memFree_null( takenL );
+    if ( takenU != NULL ) {
+        memFree_null( takenU );
+    }
+
+    /* Associate each value of the block csc to its offset in the coeftab */
+    blockcol = bcsc->cscftab;
+    for (i=0; i<bcsc->cscfnbr; i++, blockcol++) {
+        bcsc_map_cblk( bcsc, solvmtx, blockcol, map->bcsc2ctab );
+    }
+
+    bcsc->map = map;
+    if ( rc ) {
+        errorPrintW( "bcscMapInit: the pattern of the matrix is not symmetric, the scatter map is disabled\n" );
+        bcsc_map_exit( bcsc );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Check if the scatter map of the block csc can be used to update the
+ * values of the block csc with the given spm.
+ *
+ * The structure of the spm is supposed to be the one used to compute the map,
+ * only the dimensions and the types are checked.
+ *
+ *******************************************************************************
+ *
+ * @param[in] spm
+ *          The sparse matrix with the new values.
+ *
+ * @param[in] bcsc
+ *          The block csc.
+ *
+ *******************************************************************************
+ *
+ * @return 1 if the map can be used, 0 otherwise.
+ *
+ *******************************************************************************/
+int
+bcscMapCheck( const spmatrix_t    *spm,
+              const pastix_bcsc_t *bcsc )
+{
+    return ( (bcsc->map         != NULL)              &&
+             (spm->loc2glob     == NULL)              &&
+             (spm->nnzexp       == bcsc->map->nnzexp) &&
+             (spm->gN           == bcsc->gN)          &&
+             ((int)spm->flttype == bcsc->flttype)     &&
+             ((int)spm->mtxtype == bcsc->mtxtype) );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Update the values of the block csc with the values of the spm.
+ *
+ * The values are scattered through the map computed by bcscMapInit(), so the
+ * structure of the block csc is kept and no search is performed.
+ *
+ *******************************************************************************
+ *
+ * @param[in] spm
+ *          The sparse matrix with the new values. It must satisfy
+ *          bcscMapCheck().
+ *
+ * @param[in] isched
+ *          The internal scheduler used to scatter the values in parallel, or
+ *          NULL.
+ *
+ * @param[inout] bcsc
+ *          The block csc to update.
+ *
+ *******************************************************************************
+ *
+ * @return The time spent to update the bcsc structure.
+ *
+ *******************************************************************************/
+double
+bcscUpdateValues( const spmatrix_t *spm,
+                  isched_t         *isched,
+                  pastix_bcsc_t    *bcsc )
+{
+    double time = 0.;
+
+    assert( bcscMapCheck( spm, bcsc ) );
+    clockStart(time);
+
+    switch( spm->flttype ) {
+    case SpmFloat:
+        bcsc_supdate_values( spm, isched, bcsc );
+        break;
+    case SpmDouble:
+        bcsc_dupdate_values( spm, isched, bcsc );
+        break;
+    case SpmComplex32:
+        bcsc_cupdate_values( spm, isched, bcsc );
+        break;
+    case SpmComplex64:
+        bcsc_zupdate_values( spm, isched, bcsc );
+        break;
+    case SpmPattern:
+    default:
+        fprintf(stderr, "bcscUpdateValues: Error unknown floating type for input spm\n");
+    }
+
+    clockStop(time);
+    return time;
+}
+
 /**
  *******************************************************************************
  *
@@ -424,6 +824,10 @@ bcscExit( pastix_bcsc_t *bcsc )
     bcsc_cblk_t *cblk;
     pastix_int_t i;
 
+    if ( bcsc->map != NULL ) {
+        bcsc_map_exit( bcsc );
+    }
+
     if ( bcsc->cscftab == NULL ) {
         return;
     }
@@ -442,3 +846,90 @@ bcscExit( pastix_bcsc_t *bcsc )
 
     memFree_null( bcsc->Lvalues );
 }
+
+/**
+ *******************************************************************************
+ *
+ * @brief Initialize a single precision copy of the values of a block csc.
+ *
+ * The copy shares the structure of the original block csc, and only owns the
+ * converted values. It is used by the mixed-precision mode to fill the
+ * single precision coeftab, and must be released with bcscLowPrecisionExit().
+ *
+ *******************************************************************************
+ *
+ * @param[in] bcsc
+ *          The double precision block csc.
+ *
+ * @param[out] bcsclp
+ *          The single precision block csc sharing the structure of bcsc.
+ *
+ *******************************************************************************
+ *
+ * @retval 0 on success.
+ * @retval 1 if a value of the block csc overflows the single precision.
+ *
+ *******************************************************************************/
+int
+bcscLowPrecisionInit( const pastix_bcsc_t *bcsc,
+                      pastix_bcsc_t       *bcsclp )
+{
+    pastix_int_t nnz = 0;
+    size_t       eltsize;
+    int          rc = 0;
+
+    memcpy( bcsclp, bcsc, sizeof(pastix_bcsc_t) );
+    bcsclp->flttype = bvec_lowprec( bcsc->flttype );
+    bcsclp->map     = NULL;
+    bcsclp->Lvalues = NULL;
+    bcsclp->Uvalues = NULL;
+
+    if ( bcsc->cscfnbr > 0 ) {
+        const bcsc_cblk_t *cblk = bcsc->cscftab + bcsc->cscfnbr - 1;
+        nnz = cblk->coltab[ cblk->colnbr ];
+    }
+    if ( nnz == 0 ) {
+        return 0;
+    }
+
+    eltsize = pastix_size_of( bcsclp->flttype );
+    MALLOC_INTERN( bcsclp->Lvalues, nnz * eltsize, char );
+    rc = bvec_lag2lp( bcsc->flttype, nnz, 1,
+                      bcsc->Lvalues, nnz, bcsclp->Lvalues, nnz );
+
+    if ( bcsc->Uvalues == bcsc->Lvalues ) {
+        bcsclp->Uvalues = bcsclp->Lvalues;
+    }
+    else if ( bcsc->Uvalues != NULL ) {
+        MALLOC_INTERN( bcsclp->Uvalues, nnz * eltsize, char );
+        rc += bvec_lag2lp( bcsc->flttype, nnz, 1,
+                           bcsc->Uvalues, nnz, bcsclp->Uvalues, nnz );
+    }
+
+    return (rc > 0) ? 1 : 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Free the values of a single precision copy of a block csc.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] bcsclp
+ *          The single precision block csc initialized by
+ *          bcscLowPrecisionInit(). The shared structure is not freed.
+ *
+ *******************************************************************************/
+void
+bcscLowPrecisionExit( pastix_bcsc_t *bcsclp )
+{
+    if ( (bcsclp->Uvalues != NULL) &&
+         (bcsclp->Uvalues != bcsclp->Lvalues) ) {
+        memFree_null( bcsclp->Uvalues );
+    }
+    if ( bcsclp->Lvalues != NULL ) {
+        memFree_null( bcsclp->Lvalues );
+    }
+    bcsclp->Uvalues = NULL;
+}
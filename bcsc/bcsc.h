@@ -31,6 +31,20 @@ typedef struct bcsc_cblk_s {
     pastix_int_t *coltab;  /**< Array of indexes of the start of each column in the row and value arrays. */
 } bcsc_cblk_t;
 
+/**
+ * @brief Scatter map of the values of the spm into the block csc and the
+ * coeftab, to refactorize a matrix whose values only have changed.
+ */
+typedef struct bcsc_map_s {
+    pastix_int_t  nnzexp;    /**< Number of values of the spm                                                */
+    pastix_int_t *spm2L;     /**< Position in Lvalues of each value of the spm                               */
+    pastix_int_t *spm2U;     /**< Position of the transposed value of each value of the spm, in Lvalues for
+                                  symmetric matrices, or in Uvalues for general ones. -1 if none, and NULL
+                                  if no transposed value is stored.                                          */
+    pastix_int_t *bcsc2ctab; /**< Offset of each value of the bcsc in the coeftab of its full-rank cblk, or -1 */
+    int           ctabinit;  /**< The coeftab has been allocated with the structure of the block csc         */
+} bcsc_map_t;
+
 /**
  * @brief Internal column block distributed CSC matrix.
  */
@@ -44,16 +58,32 @@ struct pastix_bcsc_s {
     pastix_int_t *rowtab;  /**< Array of rows in the matrix.                                                   */
     void         *Lvalues; /**< Array of values of the matrix A                                                */
     void         *Uvalues; /**< Array of values of the matrix A^t                                              */
+    bcsc_map_t   *map;     /**< Scatter map of the spm values, NULL if not computed                            */
 };
 
 double bcscInit( const spmatrix_t     *spm,
                  const pastix_order_t *ord,
                  const SolverMatrix   *solvmtx,
                  pastix_int_t          initAt,
+                 isched_t             *isched,
                  pastix_bcsc_t        *bcsc );
 
 void   bcscExit( pastix_bcsc_t *bcsc );
 
+void   bcscMapInit( const spmatrix_t     *spm,
+                    const pastix_order_t *ord,
+                    const SolverMatrix   *solvmtx,
+                    pastix_bcsc_t        *bcsc );
+int    bcscMapCheck( const spmatrix_t    *spm,
+                     const pastix_bcsc_t *bcsc );
+double bcscUpdateValues( const spmatrix_t *spm,
+                         isched_t         *isched,
+                         pastix_bcsc_t    *bcsc );
+
+int    bcscLowPrecisionInit( const pastix_bcsc_t *bcsc,
+                             pastix_bcsc_t       *bcsclp );
+void   bcscLowPrecisionExit( pastix_bcsc_t       *bcsclp );
+
 /**
  * @}
  *
@@ -71,6 +101,7 @@ bcsc_init_centralized( const spmatrix_t     *spm,
                        const pastix_order_t *ord,
                        const SolverMatrix   *solvmtx,
                              pastix_int_t    initAt,
+                             isched_t       *isched,
                              pastix_bcsc_t  *bcsc );
 
 void
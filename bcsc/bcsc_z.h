@@ -28,7 +28,11 @@ void bcsc_zinit_centralized( const spmatrix_t     *spm,
                              const SolverMatrix   *solvmtx,
                              const pastix_int_t   *col2cblk,
                                    int             initAt,
+                                   isched_t       *isched,
                                    pastix_bcsc_t  *bcsc );
+void bcsc_zupdate_values( const spmatrix_t *spm,
+                          isched_t         *isched,
+                          pastix_bcsc_t    *bcsc );
 /**
  *   @}
  * @}
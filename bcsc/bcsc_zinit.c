@@ -452,6 +452,534 @@ bcsc_zsort( const pastix_bcsc_t *bcsc,
     }
 }
 
+/**
+ * @brief Arguments of the multi-threaded initialization of the block csc.
+ */
+struct args_bcsc_zinit_s {
+    const spmatrix_t     *spm;       /**< The initial sparse matrix                                */
+    const pastix_order_t *ord;       /**< The ordering applied to the matrix                       */
+    const SolverMatrix   *solvmtx;   /**< The solver matrix structure                              */
+    const pastix_int_t   *col2cblk;  /**< The cblk index of each column                            */
+    pastix_bcsc_t        *bcsc;      /**< The block csc to initialize                              */
+    int                   initAt;    /**< Initialize A^t for general matrices                      */
+    int                   sym;       /**< The matrix is symmetric or hermitian                     */
+    const pastix_int_t   *bcscown;   /**< First bcsc cblk owned by each thread, size world_size+1  */
+    pastix_int_t         *cntmat;    /**< Number of entries sent by each thread to each owner      */
+    pastix_int_t         *totals;    /**< Number of values owned by each thread                    */
+    pastix_int_t         *nodecnt;   /**< Number of entries of each permuted node                  */
+    pastix_int_t         *bucket;    /**< Entries of the transposed part, grouped by owner         */
+    pastix_int_t         *trowtab;   /**< Row tab associated to the transposition of A             */
+};
+
+/**
+ * @brief Return the first column of the range of a thread, such that each range
+ * holds the same number of entries of the spm.
+ */
+static inline pastix_int_t
+bcsc_zinit_range( const pastix_int_t *colptr,
+                  pastix_int_t        n,
+                  int                 rank,
+                  int                 size )
+{
+    pastix_int_t target, first, last, mid;
+
+    if ( rank >= size ) {
+        return n;
+    }
+    target = colptr[0] + (pastix_int_t)( ( (double)( colptr[n] - colptr[0] ) * rank ) / size );
+
+    first = 0;
+    last  = n;
+    while ( first < last ) {
+        mid = first + ( last - first ) / 2;
+        if ( colptr[mid] < target ) {
+            first = mid + 1;
+        }
+        else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Return the thread that owns the given bcsc cblk.
+ */
+static inline int
+bcsc_zinit_owner( const pastix_int_t *bcscown,
+                  int                 size,
+                  pastix_int_t        bcscnum )
+{
+    int first = 0;
+    int last  = size - 1;
+    int mid;
+
+    /* Last thread u such that bcscown[u] <= bcscnum */
+    while ( first < last ) {
+        mid = ( first + last + 1 ) / 2;
+        if ( bcscown[mid] <= bcscnum ) {
+            first = mid;
+        }
+        else {
+            last = mid - 1;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Return the column of the entry i of the spm.
+ *
+ * The entries are visited in increasing order, so the search starts from the
+ * column of the previous entry with an exponential search.
+ */
+static inline pastix_int_t
+bcsc_zinit_find_column( const pastix_int_t *colptr,
+                        pastix_int_t        n,
+                        pastix_int_t        itercol,
+                        pastix_int_t        i )
+{
+    pastix_int_t baseval = colptr[0];
+    pastix_int_t lo      = itercol;
+    pastix_int_t hi      = itercol + 1;
+    pastix_int_t step    = 1;
+    pastix_int_t mid;
+
+    assert( colptr[lo] - baseval <= i );
+    while ( ( hi < n ) && ( colptr[hi] - baseval <= i ) ) {
+        lo    = hi;
+        step *= 2;
+        hi    = pastix_imin( lo + step, n );
+    }
+
+    /* Last column lo such that colptr[lo] <= i */
+    while ( hi - lo > 1 ) {
+        mid = lo + ( hi - lo ) / 2;
+        if ( colptr[mid] - baseval <= i ) {
+            lo = mid;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Add the entries of the transposed part owned by the calling thread.
+ *
+ * The entries of the bucket are ordered by source column as in the sequential
+ * version, such that the values are inserted in the same order.
+ */
+static inline void
+bcsc_zinit_bucket( const struct args_bcsc_zinit_s *arg,
+                   pastix_int_t                    fentry,
+                   pastix_int_t                    lentry,
+                   pastix_int_t                   *rowtab,
+                   pastix_complex64_t             *valtab,
+                   int                             conjugate )
+{
+    const spmatrix_t   *spm      = arg->spm;
+    const pastix_int_t *permtab  = arg->ord->permtab;
+    const pastix_complex64_t *values = (const pastix_complex64_t*)(spm->values);
+    pastix_int_t        baseval  = spm->colptr[0];
+    pastix_int_t        itercol  = 0;
+    pastix_int_t        e, i, ival, idofcol, idofrow;
+    int                 dof      = spm->dof;
+
+    for ( e = fentry; e < lentry; e++ ) {
+        pastix_int_t *coltab;
+        pastix_int_t  fcolnum, itercol2, iterrow2, itercblk;
+
+        i        = arg->bucket[e];
+        itercol  = bcsc_zinit_find_column( spm->colptr, spm->gN, itercol, i );
+        itercol2 = permtab[itercol] * dof;
+        iterrow2 = permtab[ spm->rowptr[i] - baseval ] * dof;
+        itercblk = arg->col2cblk[ iterrow2 ];
+
+        fcolnum = arg->solvmtx->cblktab[itercblk].fcolnum;
+        coltab  = arg->bcsc->cscftab[ arg->solvmtx->cblktab[itercblk].bcscnum ].coltab;
+
+        ival = i * dof * dof;
+        for ( idofcol = 0; idofcol < dof; idofcol++ ) {
+            pastix_int_t colidx = itercol2 + idofcol;
+            pastix_int_t rowidx = iterrow2 - fcolnum;
+            pastix_int_t pos;
+
+            for ( idofrow = 0; idofrow < dof; idofrow++, ival++, rowidx++ ) {
+                pos = coltab[ rowidx ];
+
+                rowtab[ pos ] = colidx;
+#if defined(PRECISION_z) || defined(PRECISION_c)
+                valtab[ pos ] = conjugate ? conj( values[ ival ] ) : values[ ival ];
+#else
+                valtab[ pos ] = values[ ival ];
+#endif
+                coltab[ rowidx ]++;
+            }
+        }
+    }
+    (void)conjugate;
+}
+
+/**
+ * @brief Restore the coltab arrays of the cblks owned by the calling thread.
+ */
+static inline void
+bcsc_zinit_restore( pastix_bcsc_t *bcsc,
+                    pastix_int_t   fbcsc,
+                    pastix_int_t   lbcsc,
+                    pastix_int_t   idxcol )
+{
+    bcsc_cblk_t *blockcol = bcsc->cscftab + fbcsc;
+    pastix_int_t index, iter, idxcoltmp;
+
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        for ( iter = 0; iter <= blockcol->colnbr; iter++ ) {
+            idxcoltmp = blockcol->coltab[iter];
+            blockcol->coltab[iter] = idxcol;
+            idxcol = idxcoltmp;
+        }
+    }
+}
+
+/**
+ * @brief Sort the columns of the cblks owned by the calling thread.
+ */
+static inline void
+bcsc_zinit_sort( const pastix_bcsc_t *bcsc,
+                 pastix_int_t         fbcsc,
+                 pastix_int_t         lbcsc,
+                 pastix_int_t        *rowtab,
+                 pastix_complex64_t  *valtab )
+{
+    const bcsc_cblk_t *blockcol = bcsc->cscftab + fbcsc;
+    pastix_int_t       index, itercol;
+    void              *sortptr[2];
+
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        for ( itercol = 0; itercol < blockcol->colnbr; itercol++ ) {
+            sortptr[0] = (void*)(rowtab + blockcol->coltab[itercol]);
+            sortptr[1] = (void*)(valtab + blockcol->coltab[itercol]);
+
+            z_qsortIntFloatAsc( sortptr, blockcol->coltab[itercol+1] - blockcol->coltab[itercol] );
+        }
+    }
+}
+
+/**
+ * @brief Initialize the block csc with the cblks distributed over the threads.
+ *
+ * Each thread owns a contiguous range of bcsc cblks and is the only one to
+ * write in their coltab, row and value arrays, so no atomic operation is
+ * required:
+ *   1. The entries of the transposed part (A^t for general matrices, the strict
+ *      lower part for symmetric ones) are counted per owner on ranges of
+ *      columns of the spm, and grouped in buckets ordered by source column.
+ *   2. The owners compute the size of their columns, and the insertion offsets
+ *      are obtained with a prefix sum over the owners.
+ *   3. The owners copy the entries of A from the columns given by the inverse
+ *      permutation, and the transposed entries from their bucket.
+ *   4. The owners restore and sort their columns.
+ * The entries are inserted in the same order as the sequential version, so the
+ * generated block csc is bit-identical.
+ */
+static void
+thread_bcsc_zinit( isched_thread_t *ctx, void *args )
+{
+    struct args_bcsc_zinit_s *arg     = (struct args_bcsc_zinit_s *)args;
+    isched_t                 *isched  = ctx->global_ctx;
+    const spmatrix_t         *spm     = arg->spm;
+    const pastix_order_t     *ord     = arg->ord;
+    const SolverMatrix       *solvmtx = arg->solvmtx;
+    pastix_bcsc_t            *bcsc    = arg->bcsc;
+    const pastix_complex64_t *values  = (const pastix_complex64_t*)(spm->values);
+    pastix_complex64_t       *Lvalues;
+    const pastix_int_t       *colptr  = spm->colptr;
+    pastix_int_t              baseval = colptr[0];
+    int                       rank    = ctx->rank;
+    int                       size    = isched->world_size;
+    int                       dof     = spm->dof;
+    pastix_int_t              fcol    = bcsc_zinit_range( colptr, spm->gN, rank,     size );
+    pastix_int_t              lcol    = bcsc_zinit_range( colptr, spm->gN, rank + 1, size );
+    pastix_int_t              fbcsc   = arg->bcscown[rank];
+    pastix_int_t              lbcsc   = arg->bcscown[rank + 1];
+    pastix_int_t             *cnt     = arg->cntmat + rank * size;
+    pastix_int_t             *offset;
+    pastix_int_t              fentry, lentry, idxcol, fvalue;
+    pastix_int_t              itercol, i, u, t, iter, index;
+    bcsc_cblk_t              *blockcol;
+
+    /* 1. Count and group the entries of the transposed part by owner */
+    memset( cnt, 0, size * sizeof(pastix_int_t) );
+    for ( itercol = fcol; itercol < lcol; itercol++ ) {
+        for ( i = colptr[itercol] - baseval; i < colptr[itercol+1] - baseval; i++ ) {
+            pastix_int_t iterrow  = spm->rowptr[i] - baseval;
+            pastix_int_t itercblk = arg->col2cblk[ ord->permtab[iterrow] * dof ];
+
+            if ( (itercblk == -1) || (arg->sym && (iterrow == itercol)) ) {
+                continue;
+            }
+            cnt[ bcsc_zinit_owner( arg->bcscown, size, solvmtx->cblktab[itercblk].bcscnum ) ]++;
+        }
+    }
+    isched_barrier_wait( &(isched->barrier) );
+
+    /* The entries of an owner are stored by increasing source thread */
+    MALLOC_INTERN( offset, size, pastix_int_t );
+    idxcol = 0;
+    fentry = 0;
+    lentry = 0;
+    for ( u = 0; u < size; u++ ) {
+        if ( u == rank ) {
+            fentry = idxcol;
+        }
+        for ( t = 0; t < size; t++ ) {
+            if ( t == rank ) {
+                offset[u] = idxcol;
+            }
+            idxcol += arg->cntmat[ t * size + u ];
+        }
+        if ( u == rank ) {
+            lentry = idxcol;
+        }
+    }
+
+    for ( itercol = fcol; itercol < lcol; itercol++ ) {
+        for ( i = colptr[itercol] - baseval; i < colptr[itercol+1] - baseval; i++ ) {
+            pastix_int_t iterrow  = spm->rowptr[i] - baseval;
+            pastix_int_t itercblk = arg->col2cblk[ ord->permtab[iterrow] * dof ];
+
+            if ( (itercblk == -1) || (arg->sym && (iterrow == itercol)) ) {
+                continue;
+            }
+            u = bcsc_zinit_owner( arg->bcscown, size, solvmtx->cblktab[itercblk].bcscnum );
+            arg->bucket[ offset[u] ] = i;
+            offset[u]++;
+        }
+    }
+    memFree_null( offset );
+
+    /* 2. Compute the size of the owned columns */
+    blockcol = bcsc->cscftab + fbcsc;
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        pastix_int_t fcolnum = solvmtx->cblktab[ blockcol->cblknum ].fcolnum;
+        for ( iter = 0; iter < blockcol->colnbr; iter += dof ) {
+            pastix_int_t node = ( fcolnum + iter ) / dof;
+            pastix_int_t col  = ord->peritab[node];
+            arg->nodecnt[node] = colptr[col+1] - colptr[col];
+        }
+    }
+    isched_barrier_wait( &(isched->barrier) );
+
+    if ( arg->sym ) {
+        for ( i = fentry; i < lentry; i++ ) {
+            pastix_int_t iterrow = spm->rowptr[ arg->bucket[i] ] - baseval;
+            arg->nodecnt[ ord->permtab[iterrow] ]++;
+        }
+    }
+
+    idxcol   = 0;
+    blockcol = bcsc->cscftab + fbcsc;
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        pastix_int_t fcolnum = solvmtx->cblktab[ blockcol->cblknum ].fcolnum;
+
+        blockcol->coltab[0] = idxcol;
+        for ( iter = 0; iter < blockcol->colnbr; iter++ ) {
+            pastix_int_t node = ( fcolnum + (iter - iter % dof) ) / dof;
+            blockcol->coltab[iter+1] = blockcol->coltab[iter] + arg->nodecnt[node] * dof;
+        }
+        idxcol = blockcol->coltab[blockcol->colnbr];
+    }
+    arg->totals[rank] = idxcol;
+    isched_barrier_wait( &(isched->barrier) );
+
+    /* Shift the owned columns by the values of the previous owners */
+    fvalue = 0;
+    for ( u = 0; u < rank; u++ ) {
+        fvalue += arg->totals[u];
+    }
+    blockcol = bcsc->cscftab + fbcsc;
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        for ( iter = 0; iter <= blockcol->colnbr; iter++ ) {
+            blockcol->coltab[iter] += fvalue;
+        }
+    }
+
+    if ( rank == 0 ) {
+        pastix_int_t valuesize = 0;
+        for ( u = 0; u < size; u++ ) {
+            valuesize += arg->totals[u];
+        }
+
+        if ( valuesize > 0 ) {
+            MALLOC_INTERN( bcsc->rowtab,  valuesize, pastix_int_t);
+            MALLOC_INTERN( bcsc->Lvalues, valuesize * pastix_size_of( bcsc->flttype ), char );
+        }
+        else {
+            bcsc->rowtab  = NULL;
+            bcsc->Lvalues = NULL;
+        }
+        bcsc->Uvalues = NULL;
+
+        if ( !arg->sym && arg->initAt ) {
+            MALLOC_INTERN( bcsc->Uvalues, valuesize * pastix_size_of( bcsc->flttype ), char );
+            MALLOC_INTERN( arg->trowtab, valuesize, pastix_int_t);
+        }
+    }
+    isched_barrier_wait( &(isched->barrier) );
+
+    /* 3. Copy the entries of A */
+    Lvalues  = (pastix_complex64_t*)(bcsc->Lvalues);
+    blockcol = bcsc->cscftab + fbcsc;
+    for ( index = fbcsc; index < lbcsc; index++, blockcol++ ) {
+        pastix_int_t  fcolnum = solvmtx->cblktab[ blockcol->cblknum ].fcolnum;
+        pastix_int_t *coltab  = blockcol->coltab;
+
+        for ( iter = 0; iter < blockcol->colnbr; iter += dof ) {
+            pastix_int_t node     = ( fcolnum + iter ) / dof;
+            pastix_int_t itercol2 = node * dof;
+            pastix_int_t ival, idofcol, idofrow;
+
+            itercol = ord->peritab[node];
+            for ( i = colptr[itercol] - baseval; i < colptr[itercol+1] - baseval; i++ ) {
+                pastix_int_t iterrow2 = ord->permtab[ spm->rowptr[i] - baseval ] * dof;
+                ival = i * dof * dof;
+
+                for ( idofcol = 0; idofcol < dof; idofcol++ ) {
+                    pastix_int_t colidx = itercol2 + idofcol - fcolnum;
+                    pastix_int_t rowidx = iterrow2;
+                    pastix_int_t pos    = coltab[ colidx ];
+
+                    for ( idofrow = 0; idofrow < dof;
+                          idofrow++, ival++, rowidx++, pos++ )
+                    {
+                        bcsc->rowtab[ pos ] = rowidx;
+                        Lvalues[ pos ] = values[ ival ];
+                    }
+
+                    coltab[ colidx ] += dof;
+                    assert( coltab[ colidx ] <= coltab[ colidx+1 ] );
+                }
+            }
+        }
+    }
+
+    /* Copy the symmetric part */
+    if ( arg->sym ) {
+        bcsc_zinit_bucket( arg, fentry, lentry, bcsc->rowtab, Lvalues,
+                           spm->mtxtype == SpmHermitian );
+    }
+
+    /* 4. Restore and sort the owned columns */
+    idxcol = fvalue;
+    bcsc_zinit_restore( bcsc, fbcsc, lbcsc, idxcol );
+    bcsc_zinit_sort( bcsc, fbcsc, lbcsc, bcsc->rowtab, Lvalues );
+
+    /* Initialize A^t for general matrices */
+    if ( !arg->sym && arg->initAt ) {
+        bcsc_zinit_bucket( arg, fentry, lentry, arg->trowtab,
+                           (pastix_complex64_t*)(bcsc->Uvalues), 0 );
+        bcsc_zinit_restore( bcsc, fbcsc, lbcsc, idxcol );
+        bcsc_zinit_sort( bcsc, fbcsc, lbcsc, arg->trowtab,
+                         (pastix_complex64_t*)(bcsc->Uvalues) );
+    }
+}
+
+/**
+ * @brief Initialize a centralized block csc with the internal scheduler.
+ *
+ * See thread_bcsc_zinit() for the description of the algorithm. The bcsc cblks
+ * are distributed over the threads in contiguous ranges with the same number
+ * of columns.
+ */
+static inline void
+bcsc_zinit_centralized_threads( const spmatrix_t     *spm,
+                                const pastix_order_t *ord,
+                                const SolverMatrix   *solvmtx,
+                                const pastix_int_t   *col2cblk,
+                                      int             initAt,
+                                      isched_t       *isched,
+                                      pastix_bcsc_t  *bcsc )
+{
+    struct args_bcsc_zinit_s args;
+    const SolverCblk        *cblk;
+    bcsc_cblk_t             *blockcol;
+    pastix_int_t            *bcscown;
+    pastix_int_t             cblknum, colnbr, colsum;
+    int                      size = isched->world_size;
+    int                      u;
+
+    bcsc->flttype = spm->flttype;
+    bcsc->mtxtype = spm->mtxtype;
+    bcsc->cscfnbr = solvmtx->cblknbr - solvmtx->faninnbr - solvmtx->recvnbr;
+    MALLOC_INTERN( bcsc->cscftab, bcsc->cscfnbr, bcsc_cblk_t );
+
+    /* Allocate the coltab arrays, and split the bcsc cblks over the threads */
+    MALLOC_INTERN( bcscown, size + 1, pastix_int_t );
+    colnbr   = 0;
+    cblk     = solvmtx->cblktab;
+    blockcol = bcsc->cscftab;
+    for ( cblknum = 0; cblknum < solvmtx->cblknbr; cblknum++, cblk++ ) {
+        if ( cblk->cblktype & (CBLK_FANIN|CBLK_RECV) ) {
+            continue;
+        }
+        blockcol->cblknum = cblknum;
+        blockcol->colnbr  = cblk_colnbr( cblk );
+        assert( cblk->bcscnum == (blockcol - bcsc->cscftab) );
+        MALLOC_INTERN( blockcol->coltab, blockcol->colnbr + 1, pastix_int_t );
+
+        /* Works only for DoF constant */
+        assert( cblk->fcolnum % spm->dof == 0 );
+
+        colnbr += blockcol->colnbr;
+        blockcol++;
+    }
+
+    u      = 1;
+    colsum = 0;
+    bcscown[0] = 0;
+    for ( cblknum = 0; cblknum < bcsc->cscfnbr; cblknum++ ) {
+        while ( (u < size) && (colsum * size >= colnbr * u) ) {
+            bcscown[u] = cblknum;
+            u++;
+        }
+        colsum += bcsc->cscftab[cblknum].colnbr;
+    }
+    for ( ; u <= size; u++ ) {
+        bcscown[u] = bcsc->cscfnbr;
+    }
+
+    args.spm      = spm;
+    args.ord      = ord;
+    args.solvmtx  = solvmtx;
+    args.col2cblk = col2cblk;
+    args.bcsc     = bcsc;
+    args.initAt   = initAt;
+    args.sym      = (spm->mtxtype == SpmSymmetric) || (spm->mtxtype == SpmHermitian);
+    args.bcscown  = bcscown;
+    args.trowtab  = NULL;
+    MALLOC_INTERN( args.cntmat,  size * size,                 pastix_int_t );
+    MALLOC_INTERN( args.totals,  size,                        pastix_int_t );
+    MALLOC_INTERN( args.nodecnt, spm->gN,                     pastix_int_t );
+    MALLOC_INTERN( args.bucket,  pastix_imax( spm->gnnz, 1 ), pastix_int_t );
+
+    isched_parallel_call( isched, thread_bcsc_zinit, &args );
+
+    if ( args.sym ) {
+        /* In case of SpmHermitian, conj is applied when used to save memory space */
+        bcsc->Uvalues = bcsc->Lvalues;
+    }
+    if ( args.trowtab != NULL ) {
+        memFree_null( args.trowtab );
+    }
+    memFree_null( args.cntmat );
+    memFree_null( args.totals );
+    memFree_null( args.nodecnt );
+    memFree_null( args.bucket );
+    memFree_null( bcscown );
+}
+
 /**
  *******************************************************************************
  *
@@ -475,6 +1003,10 @@ bcsc_zsort( const pastix_bcsc_t *bcsc,
  * @param[in] initAt
  *          A flag to enable/disable the initialization of A'
  *
+ * @param[in] isched
+ *          The internal scheduler used to build the block csc in parallel. If
+ *          NULL, or with a single thread, the sequential version is used.
+ *
  * @param[inout] bcsc
  *          On entry, the pointer to an allocated bcsc.
  *          On exit, the bcsc stores the input spm with the permutation applied
@@ -487,10 +1019,17 @@ bcsc_zinit_centralized( const spmatrix_t     *spm,
                         const SolverMatrix   *solvmtx,
                         const pastix_int_t   *col2cblk,
                               int             initAt,
+                              isched_t       *isched,
                               pastix_bcsc_t  *bcsc )
 {
     pastix_int_t valuesize;
 
+    if ( (isched != NULL) && (isched->world_size > 1) ) {
+        bcsc_zinit_centralized_threads( spm, ord, solvmtx, col2cblk,
+                                        initAt, isched, bcsc );
+        return;
+    }
+
     bcsc->flttype = spm->flttype;
     valuesize = bcsc_init_centralized_coltab( spm, ord, solvmtx, bcsc );
 
@@ -539,3 +1078,116 @@ bcsc_zinit_centralized( const spmatrix_t     *spm,
         bcsc->Uvalues = bcsc->Lvalues;
     }
 }
+
+/**
+ * @brief Arguments of the multi-threaded update of the block csc values.
+ */
+struct args_bcsc_zupdate_s {
+    const spmatrix_t *spm;  /**< The sparse matrix with the new values */
+    pastix_bcsc_t    *bcsc; /**< The block csc to update               */
+};
+
+/**
+ * @brief Scatter the values [first, last[ of the spm in the block csc.
+ */
+static inline void
+bcsc_zupdate_range( const spmatrix_t *spm,
+                    pastix_bcsc_t    *bcsc,
+                    pastix_int_t      first,
+                    pastix_int_t      last )
+{
+    const bcsc_map_t         *map     = bcsc->map;
+    const pastix_complex64_t *values  = (const pastix_complex64_t*)(spm->values);
+    pastix_complex64_t       *Lvalues = (pastix_complex64_t*)(bcsc->Lvalues);
+    pastix_complex64_t       *Tvalues;
+    pastix_int_t              i, pos;
+    int                       conjugate = 0;
+
+    for (i=first; i<last; i++) {
+        pos = map->spm2L[i];
+        if ( pos != -1 ) {
+            Lvalues[pos] = values[i];
+        }
+    }
+
+    if ( map->spm2U == NULL ) {
+        return;
+    }
+
+    /* The transposed part is stored in Lvalues for symmetric matrices */
+    if ( bcsc->mtxtype == SpmGeneral ) {
+        Tvalues = (pastix_complex64_t*)(bcsc->Uvalues);
+    }
+    else {
+        Tvalues   = Lvalues;
+        conjugate = ( bcsc->mtxtype == SpmHermitian );
+    }
+
+    for (i=first; i<last; i++) {
+        pos = map->spm2U[i];
+        if ( pos == -1 ) {
+            continue;
+        }
+#if defined(PRECISION_z) || defined(PRECISION_c)
+        Tvalues[pos] = conjugate ? conj( values[i] ) : values[i];
+#else
+        Tvalues[pos] = values[i];
+#endif
+    }
+    (void)conjugate;
+}
+
+/**
+ * @brief Thread routine of bcsc_zupdate_values() on a static range of values.
+ */
+static void
+thread_bcsc_zupdate( isched_thread_t *ctx, void *args )
+{
+    struct args_bcsc_zupdate_s *arg = (struct args_bcsc_zupdate_s *)args;
+    pastix_int_t nnzexp = arg->bcsc->map->nnzexp;
+    int          rank   = ctx->rank;
+    int          size   = ctx->global_ctx->world_size;
+
+    bcsc_zupdate_range( arg->spm, arg->bcsc,
+                        ( nnzexp * rank       ) / size,
+                        ( nnzexp * (rank + 1) ) / size );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Update the values of a pastix_complex64_t block csc with the scatter
+ * map.
+ *
+ * Each value of the spm is written at the position(s) stored in the map, so
+ * the values are distributed over the threads without any conflict.
+ *
+ *******************************************************************************
+ *
+ * @param[in] spm
+ *          The sparse matrix with the new values.
+ *
+ * @param[in] isched
+ *          The internal scheduler used to scatter the values in parallel, or
+ *          NULL.
+ *
+ * @param[inout] bcsc
+ *          The block csc with a valid map to update.
+ *
+ *******************************************************************************/
+void
+bcsc_zupdate_values( const spmatrix_t *spm,
+                     isched_t         *isched,
+                     pastix_bcsc_t    *bcsc )
+{
+    struct args_bcsc_zupdate_s args;
+
+    if ( (isched == NULL) || (isched->world_size == 1) ) {
+        bcsc_zupdate_range( spm, bcsc, 0, bcsc->map->nnzexp );
+        return;
+    }
+
+    args.spm  = spm;
+    args.bcsc = bcsc;
+    isched_parallel_call( isched, thread_bcsc_zupdate, &args );
+}
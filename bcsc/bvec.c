@@ -13,6 +13,7 @@
  *
  **/
 #include "common.h"
+#include <lapacke.h>
 #include "bvec.h"
 
 /**
@@ -56,3 +57,210 @@ void bvec_free( void *x )
 {
     memFree_null(x);
 }
+
+/**
+ * @brief Maximal number of rows, and leading dimension, of a single LAPACKE
+ * conversion call, such that they fit in a 32-bit lapack_int.
+ */
+#define BVEC_LAG2_MAXROWS ((pastix_int_t)1 << 30)
+
+/**
+ * @brief Convert a double precision matrix to single precision with a single
+ * LAPACKE call.
+ */
+static inline int
+bvec_lag2lp_lapacke( pastix_coeftype_t flttype,
+                     pastix_int_t      m,
+                     pastix_int_t      n,
+                     const void       *A,
+                     pastix_int_t      lda,
+                     void             *B,
+                     pastix_int_t      ldb )
+{
+    switch( flttype ) {
+    case PastixComplex64:
+        return LAPACKE_zlag2c_work( LAPACK_COL_MAJOR, m, n, A, lda, B, ldb );
+    case PastixDouble:
+        return LAPACKE_dlag2s_work( LAPACK_COL_MAJOR, m, n, A, lda, B, ldb );
+    default:
+        assert( 0 );
+    }
+    return 0;
+}
+
+/**
+ * @brief Convert a single precision matrix back to double precision with a
+ * single LAPACKE call.
+ */
+static inline void
+bvec_lp2lag_lapacke( pastix_coeftype_t flttype,
+                     pastix_int_t      m,
+                     pastix_int_t      n,
+                     const void       *B,
+                     pastix_int_t      ldb,
+                     void             *A,
+                     pastix_int_t      lda )
+{
+    switch( flttype ) {
+    case PastixComplex64:
+        LAPACKE_clag2z_work( LAPACK_COL_MAJOR, m, n, B, ldb, A, lda );
+        break;
+    case PastixDouble:
+        LAPACKE_slag2d_work( LAPACK_COL_MAJOR, m, n, B, ldb, A, lda );
+        break;
+    default:
+        assert( 0 );
+    }
+}
+
+/**
+ * @brief Check if the dimensions of a conversion fit in a single LAPACKE call.
+ */
+static inline int
+bvec_lag2_fits( pastix_int_t n,
+                pastix_int_t lda,
+                pastix_int_t ldb )
+{
+    return ( n   <= BVEC_LAG2_MAXROWS ) &&
+           ( lda <= BVEC_LAG2_MAXROWS ) &&
+           ( ldb <= BVEC_LAG2_MAXROWS );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup bcsc
+ *
+ * @brief Convert a double precision matrix to single precision.
+ *
+ * This is used by the mixed-precision mode to give the vectors of the
+ * refinement to the single precision factors. The dimensions of the LAPACKE
+ * kernels may be 32-bit integers, so large matrices, as the values of a block
+ * csc stored as a single column, are converted column by column, by chunks of
+ * at most BVEC_LAG2_MAXROWS rows.
+ *
+ *******************************************************************************
+ *
+ * @param[in] flttype
+ *          The arithmetic of the matrix A: PastixDouble or PastixComplex64.
+ *
+ * @param[in] m
+ *          The number of rows of the matrices A and B.
+ *
+ * @param[in] n
+ *          The number of columns of the matrices A and B.
+ *
+ * @param[in] A
+ *          The double precision matrix of size lda -by- n.
+ *
+ * @param[in] lda
+ *          The leading dimension of the matrix A.
+ *
+ * @param[out] B
+ *          The single precision matrix of size ldb -by- n, in the arithmetic
+ *          bvec_lowprec( flttype ).
+ *
+ * @param[in] ldb
+ *          The leading dimension of the matrix B.
+ *
+ *******************************************************************************
+ *
+ * @retval 0 on success.
+ * @retval 1 if an entry of A overflows the single precision.
+ *
+ *******************************************************************************/
+int
+bvec_lag2lp( pastix_coeftype_t flttype,
+             pastix_int_t      m,
+             pastix_int_t      n,
+             const void       *A,
+             pastix_int_t      lda,
+             void             *B,
+             pastix_int_t      ldb )
+{
+    const char  *Aj = A;
+    char        *Bj = B;
+    size_t       eltA = pastix_size_of( flttype );
+    size_t       eltB = pastix_size_of( bvec_lowprec( flttype ) );
+    pastix_int_t i, j, mb;
+    int          rc = 0;
+
+    if ( bvec_lag2_fits( n, lda, ldb ) ) {
+        return bvec_lag2lp_lapacke( flttype, m, n, A, lda, B, ldb );
+    }
+
+    for ( j=0; j<n; j++, Aj += lda * eltA, Bj += ldb * eltB ) {
+        for ( i=0; i<m; i+=mb ) {
+            mb = pastix_imin( BVEC_LAG2_MAXROWS, m - i );
+            if ( bvec_lag2lp_lapacke( flttype, mb, 1,
+                                      Aj + i * eltA, mb,
+                                      Bj + i * eltB, mb ) )
+            {
+                rc = 1;
+            }
+        }
+    }
+    return rc;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup bcsc
+ *
+ * @brief Convert a single precision matrix back to double precision.
+ *
+ *******************************************************************************
+ *
+ * @param[in] flttype
+ *          The arithmetic of the matrix A: PastixDouble or PastixComplex64.
+ *
+ * @param[in] m
+ *          The number of rows of the matrices A and B.
+ *
+ * @param[in] n
+ *          The number of columns of the matrices A and B.
+ *
+ * @param[in] B
+ *          The single precision matrix of size ldb -by- n, in the arithmetic
+ *          bvec_lowprec( flttype ).
+ *
+ * @param[in] ldb
+ *          The leading dimension of the matrix B.
+ *
+ * @param[out] A
+ *          The double precision matrix of size lda -by- n.
+ *
+ * @param[in] lda
+ *          The leading dimension of the matrix A.
+ *
+ *******************************************************************************/
+void
+bvec_lp2lag( pastix_coeftype_t flttype,
+             pastix_int_t      m,
+             pastix_int_t      n,
+             const void       *B,
+             pastix_int_t      ldb,
+             void             *A,
+             pastix_int_t      lda )
+{
+    const char  *Bj = B;
+    char        *Aj = A;
+    size_t       eltA = pastix_size_of( flttype );
+    size_t       eltB = pastix_size_of( bvec_lowprec( flttype ) );
+    pastix_int_t i, j, mb;
+
+    if ( bvec_lag2_fits( n, lda, ldb ) ) {
+        bvec_lp2lag_lapacke( flttype, m, n, B, ldb, A, lda );
+        return;
+    }
+
+    for ( j=0; j<n; j++, Aj += lda * eltA, Bj += ldb * eltB ) {
+        for ( i=0; i<m; i+=mb ) {
+            mb = pastix_imin( BVEC_LAG2_MAXROWS, m - i );
+            bvec_lp2lag_lapacke( flttype, mb, 1,
+                                 Bj + i * eltB, mb,
+                                 Aj + i * eltA, mb );
+        }
+    }
+}
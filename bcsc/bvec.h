@@ -24,6 +24,30 @@ void *bvec_malloc( size_t size );
 
 void  bvec_free( void *x );
 
+/**
+ * @brief Return the single precision arithmetic of the mixed-precision mode
+ * associated to a double precision one, or the arithmetic itself otherwise.
+ * @param[in] flttype The arithmetic of the problem.
+ * @return The arithmetic of the factors in mixed-precision.
+ */
+static inline pastix_coeftype_t
+bvec_lowprec( pastix_coeftype_t flttype )
+{
+    switch( flttype ) {
+    case PastixComplex64:
+        return PastixComplex32;
+    case PastixDouble:
+        return PastixFloat;
+    default:
+        return flttype;
+    }
+}
+
+int   bvec_lag2lp( pastix_coeftype_t flttype, pastix_int_t m, pastix_int_t n,
+                   const void *A, pastix_int_t lda, void *B, pastix_int_t ldb );
+void  bvec_lp2lag( pastix_coeftype_t flttype, pastix_int_t m, pastix_int_t n,
+                   const void *B, pastix_int_t ldb, void *A, pastix_int_t lda );
+
 #endif /* _bvec_h_ */
 /**
  * @}
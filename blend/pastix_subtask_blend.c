@@ -26,6 +26,7 @@
 #include "extendVector.h"
 #include "blendctrl.h"
 #include "solver.h"
+#include "bcsc.h"
 #include "simu.h"
 #include "blend.h"
 
@@ -179,6 +180,11 @@ pastix_subtask_blend( pastix_data_t *pastix_data )
         solverExit( pastix_data->solvglob );
         memFree_null( pastix_data->solvglob );
     }
+    /* The block csc, and its scatter map, are based on the previous solver */
+    if ( pastix_data->bcsc != NULL ) {
+        bcscExit( pastix_data->bcsc );
+        memFree_null( pastix_data->bcsc );
+    }
     solvmtx = (SolverMatrix*)malloc(sizeof(SolverMatrix));
     solvmtx_glob = (SolverMatrix*)malloc(sizeof(SolverMatrix));
     pastix_data->solvmatr = solvmtx;
@@ -505,6 +511,49 @@ pastix_subtask_blend( pastix_data_t *pastix_data )
     {
         solverRealloc(solvmtx);
         solverRealloc(solvmtx_glob);
+
+        /* Precompute the facing blocks of the updates */
+        solverUpdatePlanInit(solvmtx,      SOLVER_UPDTPLAN_MAXBLOK);
+        solverUpdatePlanInit(solvmtx_glob, SOLVER_UPDTPLAN_MAXBLOK);
+        if( verbose > PastixVerboseYes ) {
+            size_t memplan = solvmtx->updtnbr * sizeof(int32_t);
+            pastix_print( procnum, 0, OUT_BLEND_UPDTPLAN,
+                          pastix_print_value( memplan ),
+                          pastix_print_unit( memplan ) );
+        }
+
+        /*
+         * Cluster the leaf subtrees of the internal dynamic scheduler once for
+         * all the factorizations, while the symbol matrix is still available
+         * to predict the costs. The tail of the elimination tree is excluded
+         * as in the factorization.
+         */
+        if ( (pastix_data->procnbr == 1) &&
+             (dparm[DPARM_SUBTREE_COST] > 0.) )
+        {
+            solver_team_t team;
+            int thrdnbr = pastix_data->isched->world_size;
+
+            solverTeamInit( solvmtx, &team,
+                            (iparm[IPARM_DYNAMIC_TEAM] == 0) ? 1 : thrdnbr );
+
+            MALLOC_INTERN( solvmtx->subtrees, 1, solver_subtrees_t );
+            solverSubtreesInit( solvmtx, symbmtx,
+                                iparm[IPARM_FLOAT], iparm[IPARM_FACTORIZATION],
+                                &team, dparm[DPARM_SUBTREE_COST],
+                                thrdnbr, solvmtx->subtrees );
+            solverTeamExit( &team );
+
+            if ( solvmtx->subtrees->subtnbr == 0 ) {
+                memFree_null( solvmtx->subtrees );
+            }
+            else if ( verbose > PastixVerboseYes ) {
+                solver_subtrees_t *subtrees = solvmtx->subtrees;
+                pastix_print( procnum, 0, OUT_BLEND_SUBTREES,
+                              (long)subtrees->subtnbr,
+                              (long)subtrees->cblkptr[ subtrees->subtnbr ] );
+            }
+        }
 #if defined(PASTIX_DEBUG_BLEND)
         if (!ctrl.ricar) {
             if( verbose > PastixVerboseYes ) {
@@ -60,6 +60,9 @@ solver_size( const SolverMatrix *solvptr )
     if ( solvptr->browtab ) {
         mem += solvptr->brownbr * sizeof( pastix_int_t );
     }
+    if ( solvptr->updttab ) {
+        mem += solvptr->updtnbr * sizeof( int32_t );
+    }
 #if defined(PASTIX_WITH_PARSEC)
     if ( solvptr->parsec_desc ) {
         mem += sizeof( parsec_sparse_matrix_desc_t );
@@ -154,6 +157,9 @@ solverExit(SolverMatrix *solvmtx)
     if(solvmtx->browtab) {
         memFree_null(solvmtx->browtab);
     }
+    if(solvmtx->updttab) {
+        memFree_null(solvmtx->updttab);
+    }
     if(solvmtx->gcbl2loc) {
         memFree_null(solvmtx->gcbl2loc);
     }
@@ -168,6 +174,13 @@ solverExit(SolverMatrix *solvmtx)
         }
     }
     memFree_null(solvmtx->ttsktab);
+    if(solvmtx->idletime) {
+        memFree_null(solvmtx->idletime);
+    }
+    if(solvmtx->subtrees) {
+        solverSubtreesExit(solvmtx->subtrees);
+        memFree_null(solvmtx->subtrees);
+    }
 #if defined(PASTIX_WITH_STARPU)
     {
         if ( solvmtx->starpu_desc_rhs != NULL ) {
@@ -542,6 +555,82 @@ solverRecvExit( SolverMatrix *solvmtx )
     }
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Reset the per-thread idle time counters.
+ *
+ * The counters store the time spent by each thread waiting for the
+ * contributions of the cblks it has to compute. They are allocated on the
+ * first call, and freed with the solver matrix.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The pointer to the solver matrix structure.
+ *
+ *******************************************************************************/
+void
+solverIdleInit( SolverMatrix *solvmtx )
+{
+    pastix_int_t thrdnbr = pastix_imax( 1, solvmtx->thrdnbr );
+
+    if ( solvmtx->idletime == NULL ) {
+        MALLOC_INTERN( solvmtx->idletime, thrdnbr, double );
+    }
+    memset( solvmtx->idletime, 0, thrdnbr * sizeof(double) );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Print the per-thread idle time counters.
+ *
+ * The average and maximal idle times are printed in verbose mode, and the
+ * time of each thread only in extended verbose mode.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The pointer to the solver matrix structure.
+ *
+ * @param[in] procnum
+ *          The rank of the process in the communicator.
+ *
+ * @param[in] verbose
+ *          The verbose level of the instance.
+ *
+ *******************************************************************************/
+void
+solverIdlePrint( const SolverMatrix *solvmtx,
+                 int                 procnum,
+                 pastix_verbose_t    verbose )
+{
+    pastix_int_t i, thrdnbr = pastix_imax( 1, solvmtx->thrdnbr );
+    double idlemax = 0.;
+    double idlesum = 0.;
+
+    if ( solvmtx->idletime == NULL ) {
+        return;
+    }
+
+    for ( i=0; i<thrdnbr; i++ ) {
+        idlemax  = (solvmtx->idletime[i] > idlemax) ? solvmtx->idletime[i] : idlemax;
+        idlesum += solvmtx->idletime[i];
+    }
+
+    pastix_print( procnum, 0, OUT_IDLE_TIME,
+                  idlesum / (double)thrdnbr, idlemax );
+
+    if ( verbose <= PastixVerboseYes ) {
+        return;
+    }
+    for ( i=0; i<thrdnbr; i++ ) {
+        pastix_print( procnum, 0, OUT_IDLE_THREAD,
+                      (int)i, solvmtx->idletime[i] );
+    }
+}
+
 /**
  *@}
  */
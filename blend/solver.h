@@ -26,6 +26,7 @@ struct simuctrl_s;
 typedef struct simuctrl_s SimuCtrl;
 
 #include "pastix_lowrank.h"
+#include "isched_wait.h"
 
 /**
  * @name Cblk properties
@@ -102,19 +103,23 @@ typedef struct task_s {
  * @brief Solver block structure.
  */
 typedef struct solver_blok_s {
-    void        *handler[2]; /**< Runtime data handler                     */
-    pastix_int_t lcblknm;    /**< Local column block                       */
-    pastix_int_t fcblknm;    /**< Facing column block                      */
-    pastix_int_t gbloknm;    /**< Index in global bloktab (UNUSED)         */
-    pastix_int_t frownum;    /**< First row index                          */
-    pastix_int_t lrownum;    /**< Last row index (inclusive)               */
-    pastix_int_t coefind;    /**< Index in coeftab                         */
-    pastix_int_t browind;    /**< Index in browtab                         */
-    int8_t       gpuid;      /**< Store on which GPU the block is computed */
-    int8_t       inlast;     /**< Index of the block among last separator (2), coupling with last separator (1) or other blocks (0) */
+    pastix_atomic_lock_t lock;       /**< Lock to protect the accumulation of updates in the block */
+    void                *handler[2]; /**< Runtime data handler                     */
+    pastix_int_t         lcblknm;    /**< Local column block                       */
+    pastix_int_t         fcblknm;    /**< Facing column block                      */
+    pastix_int_t         gbloknm;    /**< Index in global bloktab (UNUSED)         */
+    pastix_int_t         frownum;    /**< First row index                          */
+    pastix_int_t         lrownum;    /**< Last row index (inclusive)               */
+    pastix_int_t         coefind;    /**< Index in coeftab                         */
+    pastix_int_t         browind;    /**< Index in browtab                         */
+    int8_t               gpuid;      /**< Store on which GPU the block is computed */
+    int8_t               inlast;     /**< Index of the block among last separator (2), coupling with last separator (1) or other blocks (0) */
+    int32_t              rkhist[2];  /**< Rank of the L/U parts at their last compression: -1 if kept full-rank, -2 if never compressed, -3 if kept full-rank two factorizations ago */
 
     /* LR structures */
-    pastix_lrblock_t *LRblock; /**< Store the blok (L/U) in LR format. Allocated for the cblk. */
+    pastix_lrblock_t    *LRblock;    /**< Store the blok (L/U) in LR format. Allocated for the cblk. */
+
+    int32_t             *updtplan;   /**< Index in the facing cblk of the block facing each block of the update generated by this block, NULL if not computed */
 } SolverBlok;
 
 /**
@@ -125,6 +130,9 @@ typedef struct solver_cblk_s  {
     volatile uint32_t    ctrbcnt;    /**< Number of contribution to receive               */
     int8_t               cblktype;   /**< Type of cblk                                    */
     int8_t               gpuid;      /**< Store on which GPU the cblk is computed         */
+    volatile int8_t      ctrbwait;   /**< Set if a thread is parked waiting on ctrbcnt    */
+    int8_t               gemmsmall;  /**< Set if the updates are computed by the small GEMM kernel */
+    int8_t               lrcompact;  /**< Set if the low-rank bases are stored in single precision */
     pastix_int_t         fcolnum;    /**< First column index (Global numbering)           */
     pastix_int_t         lcolnum;    /**< Last column index (Global numbering, inclusive) */
     SolverBlok          *fblokptr;   /**< First block in column (diagonal)                */
@@ -134,6 +142,7 @@ typedef struct solver_cblk_s  {
     pastix_int_t         brown2d;    /**< First 2D-block in row facing the diagonal block in browtab, 0-based */
     pastix_int_t         sndeidx;    /**< Global index of the original supernode the cblk belongs to          */
     pastix_int_t         gcblknum;   /**< Global column block index                                           */
+    pastix_int_t         updtwdth;   /**< Average width of the updates received by the cblk (compression policy) */
     pastix_int_t         bcscnum;    /**< Index in the bcsctab if local cblk, -1 otherwise (FANIN | RECV)      */
     void                *lcoeftab;   /**< Coefficients access vector, lower part  */
     void                *ucoeftab;   /**< Coefficients access vector, upper part  */
@@ -152,6 +161,20 @@ typedef struct starpu_sparse_matrix_desc_s starpu_sparse_matrix_desc_t;
 struct starpu_dense_matrix_desc_s;
 typedef struct starpu_dense_matrix_desc_s starpu_dense_matrix_desc_t;
 
+/**
+ * @brief Right-hand sides of the forward solve fused with the factorization.
+ *
+ * When the structure is attached to the solver matrix, the forward solve of
+ * each cblk is applied at the end of its panel factorization, while the panel
+ * is still in cache, and before the release of the updates it generates.
+ */
+typedef struct solver_fwdsolve_s {
+    pastix_diag_t diag; /**< Specify if L is unit triangular         */
+    int           nrhs; /**< Number of right-hand sides              */
+    void         *b;    /**< Right-hand sides, in the permuted order */
+    int           ldb;  /**< Leading dimension of b                  */
+} solver_fwdsolve_t;
+
 /**
  * @brief Solver column block structure.
  *
@@ -185,11 +208,15 @@ struct solver_matrix_s {
     SolverCblk   * restrict cblktab;       /**< Array of solver column blocks [+1]        */
     SolverBlok   * restrict bloktab;       /**< Array of solver blocks        [+1]        */
     pastix_int_t * restrict browtab;       /**< Array of blocks                           */
+    int32_t                *updttab;       /**< Array of the update plans of the blocks   */
+    pastix_int_t            updtnbr;       /**< Size of the updttab array                 */
 
     pastix_int_t           *gcbl2loc;      /**< Array of local cblknum corresponding to gcblknum */
 
     pastix_lr_t             lowrank;       /**< Low-rank parameters                       */
     pastix_factotype_t      factotype;     /**< General or symmetric factorization?       */
+    pastix_coeftype_t       flttype;       /**< Arithmetic of the coefficients of the factors */
+    pastix_coeftype_t       gemmsmalltype; /**< Arithmetic of the gemmsmall selection, PastixPattern if not done */
     double                  diagthreshold; /**< Diagonal threshold for pivoting           */
     volatile int32_t        nbpivots;      /**< Number of pivots during the factorization */
 
@@ -218,6 +245,10 @@ struct solver_matrix_s {
     pastix_int_t **           ttsktab;              /*+ Task access vector by thread              +*/
     pastix_int_t *            ttsknbr;              /*+ Number of tasks by thread                 +*/
     pastix_queue_t **         computeQueue;         /*+ Queue of task to compute by thread        +*/
+    pastix_deque_t **         computeDeque;         /*+ Work-stealing deque of task by thread     +*/
+    double                   *idletime;             /**< Time spent by each thread waiting on ctrbcnt         */
+    solver_fwdsolve_t        *fwdsolve;             /**< Forward solve fused with the factorization, or NULL  */
+    struct solver_subtrees_s *subtrees;             /**< Leaf subtrees of the dynamic scheduler, or NULL      */
 
     pastix_int_t             *selevtx;              /*+ Array to identify which cblk are pre-selected +*/
 
@@ -326,6 +357,82 @@ cblk_rownbr( const SolverCblk *cblk )
     return rownbr;
 }
 
+/**
+ * @brief     Compute the average width of the updates received by a column
+ *            block.
+ * @param[in] solvmtx
+ *            The pointer to the solverMatrix.
+ * @param[in] cblk
+ *            The pointer to the column block.
+ * @return    The average number of columns of the cblks updating cblk, or the
+ *            number of columns of cblk if it receives no update.
+ */
+static inline pastix_int_t
+cblk_updtwidth( const SolverMatrix *solvmtx,
+                const SolverCblk   *cblk )
+{
+    pastix_int_t i, width = 0;
+    pastix_int_t updtnbr = cblk[1].brownum - cblk->brownum;
+
+    if ( updtnbr <= 0 ) {
+        return cblk_colnbr( cblk );
+    }
+    for (i = cblk->brownum; i < cblk[1].brownum; i++) {
+        const SolverBlok *blok = solvmtx->bloktab + solvmtx->browtab[i];
+        width += cblk_colnbr( solvmtx->cblktab + blok->lcblknm );
+    }
+    return pastix_imax( 1, width / updtnbr );
+}
+
+/**
+ * @brief    Pop a task from the local queue of a thread.
+ *
+ * The work-stealing deque is used if it has been allocated by the dynamic
+ * scheduler, the priority queue otherwise.
+ *
+ * @param[inout] solvmtx
+ *            The pointer to the solverMatrix.
+ * @param[in] rank
+ *            Rank of the computeQueue.
+ * @return    The cblk at the head of the queue if it exists. -1 otherwhise.
+ */
+static inline pastix_int_t
+popQueue( SolverMatrix *solvmtx,
+          int           rank )
+{
+    if ( solvmtx->computeDeque ) {
+        return pdequePop( solvmtx->computeDeque[ rank ] );
+    }
+    return pqueuePop( solvmtx->computeQueue[ rank ] );
+}
+
+/**
+ * @brief    Push a task in the local queue of a thread.
+ *
+ * The work-stealing deque can only be filled by its owner, so rank must be the
+ * rank of the calling thread when the deques are used.
+ *
+ * @param[inout] solvmtx
+ *            The pointer to the solverMatrix.
+ * @param[in] rank
+ *            Rank of the computeQueue.
+ * @param[in] elt
+ *            The task to push.
+ */
+static inline void
+pushQueue( SolverMatrix *solvmtx,
+           int           rank,
+           pastix_int_t  elt )
+{
+    if ( solvmtx->computeDeque ) {
+        pdequePush( solvmtx->computeDeque[ rank ], elt );
+    }
+    else {
+        pastix_queue_t *queue = solvmtx->computeQueue[ rank ];
+        pqueuePush1( queue, elt, queue->size );
+    }
+}
+
 /**
  * @brief    Task stealing method.
  *
@@ -350,9 +457,16 @@ stealQueue( SolverMatrix *solvmtx,
     pastix_int_t    cblknum = -1;
     while( rk != rank )
     {
-        assert( solvmtx->computeQueue[ rk ] );
-        stoleQueue = solvmtx->computeQueue[ rk ];
-        if( (cblknum = pqueuePop(stoleQueue)) != -1 ){
+        if ( solvmtx->computeDeque ) {
+            assert( solvmtx->computeDeque[ rk ] );
+            cblknum = pdequeSteal( solvmtx->computeDeque[ rk ] );
+        }
+        else {
+            assert( solvmtx->computeQueue[ rk ] );
+            stoleQueue = solvmtx->computeQueue[ rk ];
+            cblknum = pqueuePop(stoleQueue);
+        }
+        if( cblknum != -1 ){
             *dest = rk;
             return cblknum;
         }
@@ -361,6 +475,75 @@ stealQueue( SolverMatrix *solvmtx,
     return cblknum;
 }
 
+/**
+ * @brief    Decrement the number of contributions of a cblk.
+ *
+ * If the counter reaches 0, the threads parked on the cblk are waken up.
+ *
+ * @param[inout] cblk
+ *            The column block that received a contribution.
+ * @return    The number of contributions still to receive.
+ */
+static inline int32_t
+cblk_ctrbcnt_dec( SolverCblk *cblk )
+{
+    int32_t ctrbcnt = pastix_atomic_dec_32b( &(cblk->ctrbcnt) );
+    if ( !ctrbcnt && cblk->ctrbwait ) {
+        isched_unpark( &(cblk->ctrbcnt) );
+    }
+    return ctrbcnt;
+}
+
+/**
+ * @brief    Wait for all the contributions of a cblk.
+ *
+ * The thread spins for a bounded number of iterations and is then parked until
+ * the counter reaches 0. The time spent in this function is accumulated in the
+ * idle time of the thread if the counters are enabled.
+ *
+ * @param[inout] solvmtx
+ *            The pointer to the solverMatrix.
+ * @param[inout] cblk
+ *            The column block to wait on.
+ * @param[in] rank
+ *            Rank of the waiting thread.
+ */
+static inline void
+cblk_wait_deps( SolverMatrix *solvmtx,
+                SolverCblk   *cblk,
+                int           rank )
+{
+    uint32_t ctrbcnt = cblk->ctrbcnt;
+    double   time;
+    int      spin = 0;
+
+    if ( !ctrbcnt ) {
+        return;
+    }
+
+    time = clockGet();
+    while( (ctrbcnt = cblk->ctrbcnt) != 0 ) {
+        if ( spin < ISCHED_SPIN_COUNT ) {
+            isched_cpu_relax();
+            spin++;
+            continue;
+        }
+
+        /* Publish the parked status before checking the counter one last time */
+        cblk->ctrbwait = 1;
+        pastix_mfence();
+        ctrbcnt = cblk->ctrbcnt;
+        if ( ctrbcnt ) {
+            isched_park( &(cblk->ctrbcnt), ctrbcnt );
+        }
+    }
+    cblk->ctrbwait = 0;
+
+    if ( solvmtx->idletime ) {
+        solvmtx->idletime[rank] += clockGet() - time;
+    }
+}
+
 /**
  * @brief Check if a block is included inside another one.
  *
@@ -393,6 +576,242 @@ is_block_inside_fblock( const SolverBlok *blok,
 #  endif /* defined(NAPA_SOPALIN) */
 }
 
+/**
+ * @brief Get the block facing a block in the update generated by another block
+ * of the same cblk.
+ *
+ * The update plan of blok is used if it has been computed by
+ * solverUpdatePlanInit(), otherwise the blocks of fcblk are walked from fblok.
+ *
+ * @param[in] blok     The block that generates the update.
+ * @param[in] iterblok The block of the cblk of blok, below blok, that is facing
+ *                     the searched block.
+ * @param[in] fcblk    The cblk facing blok, on which the update is applied.
+ * @param[in] fblok    The block of fcblk from which the search starts without
+ *                     plan. It must be before the searched block.
+ *
+ * @return The block of fcblk that includes the rows of iterblok.
+ */
+static inline SolverBlok *
+blok_facing_blok( const SolverBlok *blok,
+                  const SolverBlok *iterblok,
+                  const SolverCblk *fcblk,
+                  SolverBlok       *fblok )
+{
+    if ( blok->updtplan != NULL ) {
+        fblok = fcblk->fblokptr + blok->updtplan[ iterblok - blok ];
+        assert( is_block_inside_fblock( iterblok, fblok ) );
+        return fblok;
+    }
+
+    while (!is_block_inside_fblock( iterblok, fblok ))
+    {
+        fblok++;
+        assert( fblok < fcblk[1].fblokptr );
+    }
+    return fblok;
+}
+
+/**
+ * @name Block-level tasks of the internal dynamic scheduler
+ * @{
+ *
+ *   The 2D cblks are factorized by the internal dynamic scheduler with a set
+ *   of block-level tasks: the factorization of the diagonal block is done by
+ *   the task of the cblk itself, and it releases one TRSM task per set of
+ *   off-diagonal blocks facing the same cblk, and one GEMM task per couple of
+ *   sets. The task identifiers pushed in the queues are the cblk indexes for
+ *   the cblk tasks, and cblknbr plus the index in the tasktab array for the
+ *   block-level tasks.
+ */
+#define TASK2D_TRSM 0 /**< Triangular solve of a set of blocks                  */
+#define TASK2D_GEMM 1 /**< Update of a facing cblk by a couple of sets of blocks */
+
+/**
+ * @brief Block-level task of a 2D cblk.
+ */
+typedef struct solver_task2d_s {
+    pastix_int_t     cblknum; /**< Index of the cblk the task belongs to                              */
+    pastix_int_t     m;       /**< Rank of the A set of blocks in the cblk                             */
+    pastix_int_t     n;       /**< Rank of the B set of blocks in the cblk (GEMM only)                 */
+    pastix_int_t     blok_mk; /**< Index of the first block of the A set in the cblk                   */
+    pastix_int_t     blok_nk; /**< Index of the first block of the B set in the cblk (GEMM only)       */
+    pastix_int_t     blok_mn; /**< Index of the first block of the C set in the facing cblk (GEMM only) */
+    volatile int32_t ctrbcnt; /**< GEMM: number of TRSM left before the task is ready;
+                                   TRSM: number of GEMM left updating the cblk facing the set          */
+    int8_t           type;    /**< TASK2D_TRSM or TASK2D_GEMM                                          */
+} solver_task2d_t;
+
+/**
+ * @brief Block-level tasks of all the 2D cblks.
+ */
+typedef struct solver_tasks2d_s {
+    pastix_int_t     tasknbr; /**< Number of block-level tasks                                      */
+    pastix_int_t     cblkmin; /**< Index of the first 2D cblk                                       */
+    pastix_int_t    *taskptr; /**< Index of the first task of each cblk from cblkmin (size n+1)      */
+    pastix_int_t    *setnbr;  /**< Number of sets of off-diagonal blocks of each cblk from cblkmin */
+    solver_task2d_t *tasktab; /**< Array of the block-level tasks                                   */
+} solver_tasks2d_t;
+
+pastix_int_t solverTasks2dInit        ( const SolverMatrix *solvmtx, solver_tasks2d_t *tasks2d );
+void         solverTasks2dExit        ( solver_tasks2d_t *tasks2d );
+void         solverTasks2dReleasePanel( SolverMatrix *solvmtx, const solver_tasks2d_t *tasks2d,
+                                        const SolverCblk *cblk, int rank );
+void         solverTasks2dReleaseTrsm ( SolverMatrix *solvmtx, const solver_tasks2d_t *tasks2d,
+                                        const solver_task2d_t *task, int rank );
+void         solverTasks2dReleaseGemm ( SolverMatrix *solvmtx, const solver_tasks2d_t *tasks2d,
+                                        const solver_task2d_t *task, int rank );
+void         solverTasks2dLockGemm    ( SolverMatrix *solvmtx, const solver_task2d_t *task );
+void         solverTasks2dUnlockGemm  ( SolverMatrix *solvmtx, const solver_task2d_t *task );
+/**
+ * @}
+ */
+
+/**
+ * @name Thread teams of the internal dynamic scheduler
+ * @{
+ *
+ *   Near the root of the elimination tree, there are less ready cblks than
+ *   threads. The owner of a cblk of this tail phase publishes the updates
+ *   generated by its off-diagonal blocks in a team job, and the threads that
+ *   do not find any task in the queues join the job to share these updates.
+ */
+
+/**
+ * @brief Function applying the update generated by one off-diagonal block of
+ * the cblk of a team job.
+ */
+typedef void (*solver_team_fct_t)( SolverMatrix *solvmtx,
+                                   void         *args,
+                                   SolverCblk   *cblk,
+                                   SolverBlok   *blok,
+                                   void         *work,
+                                   pastix_int_t  lwork );
+
+/**
+ * @brief Team job shared by the threads of the internal dynamic scheduler.
+ */
+typedef struct solver_team_s {
+    volatile int32_t  busy;     /**< Set while a job is published by an owner                   */
+    volatile int32_t  cblknum;  /**< Index of the cblk of the published job, -1 if none         */
+    volatile int32_t  next;     /**< Index of the next off-diagonal block to update             */
+    volatile int32_t  members;  /**< Number of helpers working on the job                       */
+    int32_t           bloknbr;  /**< Number of off-diagonal blocks of the cblk                  */
+    solver_team_fct_t func;     /**< Update function of one off-diagonal block                  */
+    void             *args;     /**< Arguments of the update function                           */
+    int8_t           *tailtab;  /**< Flag set for the cblks of the tail of the elimination tree */
+} solver_team_t;
+
+pastix_int_t solverTeamInit( const SolverMatrix *solvmtx, solver_team_t *team, int thrdnbr );
+void         solverTeamExit( solver_team_t *team );
+void         solverTeamRun ( SolverMatrix *solvmtx, solver_team_t *team, SolverCblk *cblk,
+                             solver_team_fct_t func, void *args,
+                             void *work, pastix_int_t lwork, int rank );
+int          solverTeamHelp( SolverMatrix *solvmtx, solver_team_t *team,
+                             void *work, pastix_int_t lwork, int rank );
+
+/**
+ * @brief Check if the updates of a cblk are shared with the idle threads.
+ * @param[in] team
+ *          The team structure of the dynamic scheduler.
+ * @param[in] cblknum
+ *          The index of the cblk.
+ * @return 1 if the cblk belongs to the tail of the elimination tree, 0 otherwise.
+ */
+static inline int
+solverTeamIsTail( const solver_team_t *team,
+                  pastix_int_t         cblknum )
+{
+    return (team->tailtab != NULL) && team->tailtab[cblknum];
+}
+/**
+ * @}
+ */
+
+/**
+ * @name Leaf subtrees of the internal dynamic scheduler
+ * @{
+ *
+ *   At the bottom of the elimination tree, the cost of the scheduling of the
+ *   small cblks is of the same order as their computations. The subtrees whose
+ *   predicted cost is below a threshold are thus executed as a single task,
+ *   and only their root is exposed to the scheduler.
+ */
+
+/**
+ * @brief Leaf subtrees clustered in single tasks.
+ */
+typedef struct solver_subtrees_s {
+    pastix_int_t  subtnbr; /**< Number of subtrees                                           */
+    pastix_int_t *subttab; /**< Index of the subtree of each cblk, -1 if not clustered         */
+    pastix_int_t *cblkptr; /**< Index of the first cblk of each subtree in cblktab [+1]        */
+    pastix_int_t *cblktab; /**< Cblks of the subtrees, sorted in increasing order per subtree */
+} solver_subtrees_t;
+
+pastix_int_t solverSubtreesInit( const SolverMatrix    *solvmtx,
+                                 const symbol_matrix_t *symbmtx,
+                                 pastix_coeftype_t      flttype,
+                                 pastix_factotype_t     factotype,
+                                 const solver_team_t   *team,
+                                 double                 threshold,
+                                 int                    thrdnbr,
+                                 solver_subtrees_t     *subtrees );
+void         solverSubtreesHold( SolverMatrix *solvmtx, const solver_subtrees_t *subtrees );
+void         solverSubtreesExit( solver_subtrees_t *subtrees );
+
+/**
+ * @brief Default maximal number of off-diagonal blocks of a cblk to compute
+ * the update plans of its blocks.
+ *
+ * The plans of a cblk with n off-diagonal blocks store n (n + 1) / 2 entries,
+ * so the wide cblks keep the search to bound the memory at 512 KiB per cblk.
+ */
+#define SOLVER_UPDTPLAN_MAXBLOK 512
+
+pastix_int_t solverUpdatePlanInit( SolverMatrix *solvmtx, pastix_int_t maxblok );
+
+/**
+ * @brief Return the subtree of a cblk.
+ * @param[in] subtrees
+ *          The subtrees structure of the dynamic scheduler.
+ * @param[in] cblknum
+ *          The index of the cblk.
+ * @return The index of the subtree of the cblk, -1 if the cblk is not clustered.
+ */
+static inline pastix_int_t
+solverSubtreesGet( const solver_subtrees_t *subtrees,
+                   pastix_int_t             cblknum )
+{
+    return (subtrees->subttab != NULL) ? subtrees->subttab[cblknum] : -1;
+}
+
+/**
+ * @brief Check if a task is ready at the beginning of the factorization.
+ * @param[in] subtrees
+ *          The subtrees structure of the dynamic scheduler.
+ * @param[in] cblknum
+ *          The index of the cblk of the task.
+ * @param[in] ctrbcnt
+ *          The number of contributions of the task.
+ * @return 1 if the task has no contribution and is not clustered, or if the
+ *         cblk is the root of a subtree, 0 otherwise.
+ */
+static inline int
+solverSubtreesIsReady( const solver_subtrees_t *subtrees,
+                       pastix_int_t             cblknum,
+                       pastix_int_t             ctrbcnt )
+{
+    pastix_int_t s = solverSubtreesGet( subtrees, cblknum );
+    if ( s == -1 ) {
+        return ctrbcnt == 0;
+    }
+    /* The root is the last cblk of the subtree */
+    return subtrees->cblktab[ subtrees->cblkptr[s+1] - 1 ] == cblknum;
+}
+/**
+ * @}
+ */
+
 void solverInit( SolverMatrix *solvmtx );
 void solverExit( SolverMatrix *solvmtx );
 
@@ -437,6 +856,11 @@ void solverRecvInit( pastix_coefside_t side,
                      int               flttype );
 void solverRecvExit( SolverMatrix     *solvmtx );
 
+void solverIdleInit ( SolverMatrix       *solvmtx );
+void solverIdlePrint( const SolverMatrix *solvmtx,
+                      int                 procnum,
+                      pastix_verbose_t    verbose );
+
 /*
  * Solver backup
  */
@@ -117,6 +117,19 @@ solver_copy( const SolverMatrix *solvin,
     }
     solvcblk->fblokptr = solvblok;
 
+    /* Copy the update plans */
+    if ( solvin->updttab != NULL ) {
+        MALLOC_INTERN(solvout->updttab, solvout->updtnbr, int32_t);
+        memcpy(solvout->updttab, solvin->updttab,
+               solvout->updtnbr*sizeof(int32_t));
+
+        for (solvblok = solvout->bloktab; solvblok < solvout->bloktab + solvout->bloknbr; solvblok++) {
+            if ( solvblok->updtplan != NULL ) {
+                solvblok->updtplan = solvout->updttab + (solvblok->updtplan - solvin->updttab);
+            }
+        }
+    }
+
     /* Copy ttsktab & ttsknbr */
     if (solvout->bublnbr>0)
     {
@@ -137,6 +150,12 @@ solver_copy( const SolverMatrix *solvin,
         solvout->ttsknbr = NULL;
         solvout->ttsktab = NULL;
     }
+
+    /* The idle time counters are not shared */
+    solvout->idletime = NULL;
+
+    /* The leaf subtrees are not copied, the copy is factorized without them */
+    solvout->subtrees = NULL;
 }
 
 /**
@@ -197,6 +197,7 @@ solverLoad( SolverMatrix *solvptr,
             solverExit (solvptr);
             return     PASTIX_ERR_FILE;
         }
+        blokptr->lock = PASTIX_ATOMIC_UNLOCKED;
 
     }
 
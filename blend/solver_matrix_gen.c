@@ -374,6 +374,9 @@ solverMatrixGen( SolverMatrix          *solvmtx,
     memFree_null(tasklocalnum);
     memFree_null(ftgttab);
 
+    /* Compute the average width of the updates of each cblk */
+    solvMatGen_updt_width( solvmtx );
+
     /* Compute the maximum area of the temporary buffer */
     solvMatGen_max_buffers( solvmtx );
     solvMatGen_stats_last( solvmtx );
@@ -592,6 +595,9 @@ solverMatrixGenSeq( SolverMatrix          *solvmtx,
     solvMatGen_fill_tasktab( solvmtx, isched, simuctrl,
                              NULL, NULL, NULL, ctrl->clustnum, is_dbg );
 
+    /* Compute the average width of the updates of each cblk */
+    solvMatGen_updt_width( solvmtx );
+
     /* Compute the maximum area of the temporary buffer */
     solvMatGen_max_buffers( solvmtx );
     solvMatGen_stats_last( solvmtx );
@@ -687,6 +687,32 @@ solvMatGen_fill_tasktab( SolverMatrix       *solvmtx,
     }
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Compute the average width of the updates received by each cblk.
+ *
+ * This width is used as the inner dimension of the updates in the cost models
+ * of the compression policy (see core_lrpolicy()). It only depends on the
+ * structure, and is computed once when the browtab is complete.
+ *
+ *******************************************************************************
+ *
+ *  @param[inout] solvmtx
+ *           Pointer to the solver matrix.
+ *
+ *******************************************************************************/
+void
+solvMatGen_updt_width( SolverMatrix *solvmtx )
+{
+    SolverCblk  *solvcblk = solvmtx->cblktab;
+    pastix_int_t i;
+
+    for(i=0; i<solvmtx->cblknbr; i++, solvcblk++) {
+        solvcblk->updtwdth = cblk_updtwidth( solvmtx, solvcblk );
+    }
+}
+
 /**
  *******************************************************************************
  *
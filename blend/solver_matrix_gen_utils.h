@@ -81,6 +81,7 @@ solvMatGen_init_blok( SolverBlok  *solvblok,
     assert( stride  >= 0 );
     assert( nbcols  >= 0 );
 
+    solvblok->lock       = PASTIX_ATOMIC_UNLOCKED;
     solvblok->handler[0] = NULL;
     solvblok->handler[1] = NULL;
     solvblok->fcblknm    = fcblknm;
@@ -91,7 +92,10 @@ solvMatGen_init_blok( SolverBlok  *solvblok,
     solvblok->browind    = -1;
     solvblok->gpuid      = GPUID_UNDEFINED;
     solvblok->inlast     = 0;
+    solvblok->rkhist[0]  = -2;
+    solvblok->rkhist[1]  = -2;
     solvblok->LRblock    = NULL;
+    solvblok->updtplan   = NULL;
 }
 
 /**
@@ -155,6 +159,9 @@ solvMatGen_init_cblk( SolverCblk          *solvcblk,
     solvcblk->ctrbcnt    = -1;
     solvcblk->cblktype   = (cblknum == -1) ? 0 : candcblk->cblktype;
     solvcblk->gpuid      = GPUID_UNDEFINED;
+    solvcblk->ctrbwait   = 0;
+    solvcblk->gemmsmall  = 0;
+    solvcblk->lrcompact  = 0;
     solvcblk->fcolnum    = fcolnum;
     solvcblk->lcolnum    = lcolnum;
     solvcblk->fblokptr   = fblokptr;
@@ -325,6 +332,7 @@ void solvMatGen_fill_tasktab( SolverMatrix       *solvmtx,
                               int                 is_dbg );
 
 void solvMatGen_stats_last( SolverMatrix *solvmtx );
+void solvMatGen_updt_width( SolverMatrix *solvmtx );
 void solvMatGen_max_buffers( SolverMatrix *solvmtx );
 
 void solver_recv_update_fanin( solver_cblk_recv_t   **faninptr,
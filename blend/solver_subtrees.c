@@ -0,0 +1,276 @@
+/**
+ *
+ * @file solver_subtrees.c
+ *
+ * PaStiX leaf subtrees of the internal dynamic scheduler.
+ *
+ * @copyright 2004-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include "common.h"
+#include "symbol.h"
+#include "solver.h"
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Initialize the subtrees structure, and cluster the leaf subtrees of
+ * the elimination tree.
+ *
+ * The cost of each cblk is predicted by pastixSymbolGetTimes(), and a subtree
+ * is clustered if its cost is below the threshold, and below the fraction
+ * 1/(4 thrdnbr) of the total cost to preserve the load balance. The subtrees
+ * with a 2D cblk, a cblk of the Schur complement, or a cblk of the tail of the
+ * elimination tree are not clustered, as well as the subtrees of a single
+ * cblk.
+ *
+ * A subtree does not receive any contribution from outside, so it is ready at
+ * the beginning of the factorization. The cblks of a subtree are all factorized
+ * in increasing order by the thread that pops the root, see
+ * solverSubtreesHold().
+ *
+ * The clustering only depends on the analysis, and is computed once at the end
+ * of the blend step.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] symbmtx
+ *          The symbol matrix structure used to predict the costs.
+ *
+ * @param[in] flttype
+ *          The arithmetic of the factorization.
+ *
+ * @param[in] factotype
+ *          The factorization algorithm.
+ *
+ * @param[in] team
+ *          The team structure of the scheduler to exclude the tail cblks.
+ *
+ * @param[in] threshold
+ *          The maximal predicted cost of a subtree. If threshold <= 0., no
+ *          subtree is clustered.
+ *
+ * @param[in] thrdnbr
+ *          The number of threads of the scheduler.
+ *
+ * @param[out] subtrees
+ *          The subtrees structure to initialize.
+ *
+ *******************************************************************************
+ *
+ * @return The number of clustered subtrees.
+ *
+ *******************************************************************************/
+pastix_int_t
+solverSubtreesInit( const SolverMatrix    *solvmtx,
+                    const symbol_matrix_t *symbmtx,
+                    pastix_coeftype_t      flttype,
+                    pastix_factotype_t     factotype,
+                    const solver_team_t   *team,
+                    double                 threshold,
+                    int                    thrdnbr,
+                    solver_subtrees_t     *subtrees )
+{
+    const SolverCblk *cblk;
+    double           *cblkcost, *blokcost, *subtcost;
+    int8_t           *eligible;
+    pastix_int_t     *parent, *cblknbr;
+    pastix_int_t      k, p, s;
+    pastix_int_t      total = 0;
+    double            totalcost = 0.;
+
+    memset( subtrees, 0, sizeof(solver_subtrees_t) );
+
+    if ( (threshold <= 0.) || (symbmtx == NULL) || (solvmtx->cblknbr == 0) ) {
+        return 0;
+    }
+
+    /* Predict the cost of each cblk */
+    MALLOC_INTERN( cblkcost, symbmtx->cblknbr, double );
+    MALLOC_INTERN( blokcost, symbmtx->bloknbr, double );
+    pastixSymbolGetTimes( symbmtx, flttype, factotype, cblkcost, blokcost );
+    memFree_null( blokcost );
+
+    MALLOC_INTERN( subtcost, solvmtx->cblknbr, double       );
+    MALLOC_INTERN( eligible, solvmtx->cblknbr, int8_t       );
+    MALLOC_INTERN( parent,   solvmtx->cblknbr, pastix_int_t );
+    MALLOC_INTERN( cblknbr,  solvmtx->cblknbr, pastix_int_t );
+
+    for( k=0; k<solvmtx->cblknbr; k++ ) {
+        subtcost[k] = 0.;
+        eligible[k] = 1;
+        cblknbr[k]  = 0;
+    }
+
+    /*
+     * Accumulate the cost and the size of the subtrees. The father of a cblk is
+     * always after the cblk.
+     */
+    cblk = solvmtx->cblktab;
+    for( k=0; k<solvmtx->cblknbr; k++, cblk++ ) {
+        assert( cblk->gcblknum < symbmtx->cblknbr );
+        subtcost[k] += cblkcost[ cblk->gcblknum ];
+        cblknbr[k]  += 1;
+        totalcost   += cblkcost[ cblk->gcblknum ];
+
+        if ( (cblk->cblktype & (CBLK_TASKS_2D | CBLK_IN_SCHUR | CBLK_FANIN | CBLK_RECV)) ||
+             solverTeamIsTail( team, k ) )
+        {
+            eligible[k] = 0;
+        }
+
+        parent[k] = -1;
+        if ( cblk[0].fblokptr + 1 < cblk[1].fblokptr ) {
+            p = cblk->fblokptr[1].fcblknm;
+            assert( p > k );
+            parent[k]    = p;
+            subtcost[p] += subtcost[k];
+            cblknbr[p]  += cblknbr[k];
+            eligible[p]  = eligible[p] && eligible[k];
+        }
+    }
+    memFree_null( cblkcost );
+
+    totalcost /= 4. * thrdnbr;
+    threshold  = (threshold < totalcost) ? threshold : totalcost;
+    for( k=0; k<solvmtx->cblknbr; k++ ) {
+        eligible[k] = eligible[k] && (subtcost[k] <= threshold);
+    }
+
+    /*
+     * Flag the roots of the subtrees, and propagate the index of the subtree
+     * to the descendants, from the root of the elimination tree.
+     */
+    MALLOC_INTERN( subtrees->subttab, solvmtx->cblknbr, pastix_int_t );
+    for( k=solvmtx->cblknbr-1; k>=0; k-- ) {
+        p = parent[k];
+        if ( (p != -1) && (subtrees->subttab[p] != -1) ) {
+            subtrees->subttab[k] = subtrees->subttab[p];
+        }
+        else if ( eligible[k] && (cblknbr[k] > 1) &&
+                  ((p == -1) || !eligible[p]) )
+        {
+            subtrees->subttab[k] = subtrees->subtnbr;
+            subtrees->subtnbr++;
+        }
+        else {
+            subtrees->subttab[k] = -1;
+        }
+    }
+
+    memFree_null( subtcost );
+    memFree_null( eligible );
+    memFree_null( parent   );
+
+    if ( subtrees->subtnbr == 0 ) {
+        memFree_null( cblknbr );
+        solverSubtreesExit( subtrees );
+        return 0;
+    }
+
+    /* Build the list of the cblks of each subtree in increasing order */
+    MALLOC_INTERN( subtrees->cblkptr, subtrees->subtnbr+1, pastix_int_t );
+    memset( subtrees->cblkptr, 0, (subtrees->subtnbr+1) * sizeof(pastix_int_t) );
+
+    for( k=0; k<solvmtx->cblknbr; k++ ) {
+        s = subtrees->subttab[k];
+        if ( s == -1 ) {
+            continue;
+        }
+        subtrees->cblkptr[s+1]++;
+        total++;
+    }
+    for( s=0; s<subtrees->subtnbr; s++ ) {
+        subtrees->cblkptr[s+1] += subtrees->cblkptr[s];
+    }
+    assert( subtrees->cblkptr[subtrees->subtnbr] == total );
+
+    MALLOC_INTERN( subtrees->cblktab, total, pastix_int_t );
+    memset( cblknbr, 0, subtrees->subtnbr * sizeof(pastix_int_t) );
+    for( k=0; k<solvmtx->cblknbr; k++ ) {
+        s = subtrees->subttab[k];
+        if ( s == -1 ) {
+            continue;
+        }
+        subtrees->cblktab[ subtrees->cblkptr[s] + cblknbr[s] ] = k;
+        cblknbr[s]++;
+    }
+    memFree_null( cblknbr );
+
+    return subtrees->subtnbr;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Prevent the release of the clustered cblks by their dependencies.
+ *
+ * The contribution counters of the clustered cblks are incremented such that
+ * they never reach 0 and are never pushed by the release of the dependencies.
+ * As the counters are restored before each factorization, this must be called
+ * by each factorization with the subtrees.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure. On exit, the counters of the clustered
+ *          cblks are incremented.
+ *
+ * @param[in] subtrees
+ *          The subtrees structure.
+ *
+ *******************************************************************************/
+void
+solverSubtreesHold( SolverMatrix            *solvmtx,
+                    const solver_subtrees_t *subtrees )
+{
+    pastix_int_t i;
+
+    if ( subtrees->subtnbr == 0 ) {
+        return;
+    }
+
+    for( i=0; i<subtrees->cblkptr[subtrees->subtnbr]; i++ ) {
+        solvmtx->cblktab[ subtrees->cblktab[i] ].ctrbcnt++;
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Free the subtrees structure.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] subtrees
+ *          The subtrees structure to free.
+ *
+ *******************************************************************************/
+void
+solverSubtreesExit( solver_subtrees_t *subtrees )
+{
+    if ( subtrees->subttab ) {
+        memFree_null( subtrees->subttab );
+    }
+    if ( subtrees->cblkptr ) {
+        memFree_null( subtrees->cblkptr );
+    }
+    if ( subtrees->cblktab ) {
+        memFree_null( subtrees->cblktab );
+    }
+    subtrees->subtnbr = 0;
+}
@@ -0,0 +1,448 @@
+/**
+ *
+ * @file solver_tasks2d.c
+ *
+ * PaStiX block-level tasks of the internal dynamic scheduler.
+ *
+ * @copyright 2004-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include "common.h"
+#include "queue.h"
+#include "solver.h"
+#include "kernels_trace.h"
+
+/**
+ * @brief Return the number of sets of off-diagonal blocks facing the same cblk.
+ */
+static inline pastix_int_t
+solver_cblk_setnbr( const SolverCblk *cblk )
+{
+    const SolverBlok *blok = cblk[0].fblokptr + 1;
+    const SolverBlok *lblk = cblk[1].fblokptr;
+    pastix_int_t      setnbr = 0;
+
+    for( ; blok < lblk; blok++ ) {
+        if ( (blok + 1 == lblk) ||
+             (blok[0].fcblknm != blok[1].fcblknm) )
+        {
+            setnbr++;
+        }
+    }
+    return setnbr;
+}
+
+/**
+ * @brief Return the index of the first block of fcblk facing the same cblk as
+ * blokA.
+ */
+static inline pastix_int_t
+solver_task2d_blok_mn( const SolverCblk *fcblk,
+                       const SolverBlok *blokA )
+{
+    const SolverBlok *blokC = fcblk[0].fblokptr;
+    const SolverBlok *lblkC = fcblk[1].fblokptr;
+
+    while( (blokC < lblkC) && (blokC->fcblknm != blokA->fcblknm) ) {
+        blokC++;
+    }
+    assert( blokC < lblkC );
+    assert( is_block_inside_fblock( blokA, blokC ) );
+    (void)lblkC;
+
+    return blokC - fcblk->fblokptr;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Build the block-level tasks of the 2D cblks.
+ *
+ * One TRSM task is created per set of off-diagonal blocks facing the same cblk,
+ * and one GEMM task per couple (m, n), n <= m, of sets. The dependency
+ * counters are initialized for a new factorization, so the structure must be
+ * built again for each factorization.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[out] tasks2d
+ *          The structure that stores the block-level tasks. The arrays are set
+ *          to NULL if no block-level task is required.
+ *
+ *******************************************************************************
+ *
+ * @return The number of block-level tasks.
+ *
+ *******************************************************************************/
+pastix_int_t
+solverTasks2dInit( const SolverMatrix *solvmtx,
+                   solver_tasks2d_t   *tasks2d )
+{
+    const SolverCblk *cblk, *fcblk;
+    const SolverBlok *blok, *lblk;
+    solver_task2d_t  *task, *trsm;
+    pastix_int_t      k, m, n, cblknbr2d, setnbr;
+    pastix_int_t      tasknbr = 0;
+
+    memset( tasks2d, 0, sizeof(solver_tasks2d_t) );
+    if ( solvmtx->cblkmin2d >= solvmtx->cblknbr ) {
+        return 0;
+    }
+
+    cblknbr2d = solvmtx->cblknbr - solvmtx->cblkmin2d;
+    tasks2d->cblkmin = solvmtx->cblkmin2d;
+    MALLOC_INTERN( tasks2d->taskptr, cblknbr2d+1, pastix_int_t );
+    MALLOC_INTERN( tasks2d->setnbr,  cblknbr2d,   pastix_int_t );
+
+    /* Count the number of tasks per cblk */
+    cblk = solvmtx->cblktab + solvmtx->cblkmin2d;
+    for( k=0; k<cblknbr2d; k++, cblk++ ) {
+        tasks2d->taskptr[k] = tasknbr;
+        tasks2d->setnbr[k]  = 0;
+
+        if ( !(cblk->cblktype & CBLK_TASKS_2D) ||
+              (cblk->cblktype & CBLK_IN_SCHUR) )
+        {
+            continue;
+        }
+
+        setnbr = solver_cblk_setnbr( cblk );
+        tasks2d->setnbr[k] = setnbr;
+        tasknbr += setnbr + (setnbr * (setnbr + 1)) / 2;
+    }
+    tasks2d->taskptr[cblknbr2d] = tasknbr;
+
+    if ( tasknbr == 0 ) {
+        solverTasks2dExit( tasks2d );
+        return 0;
+    }
+
+    tasks2d->tasknbr = tasknbr;
+    MALLOC_INTERN( tasks2d->tasktab, tasknbr, solver_task2d_t );
+
+    /* Initialize the tasks */
+    cblk = solvmtx->cblktab + solvmtx->cblkmin2d;
+    for( k=0; k<cblknbr2d; k++, cblk++ ) {
+        setnbr = tasks2d->setnbr[k];
+        if ( setnbr == 0 ) {
+            continue;
+        }
+
+        /* TRSM: one per set of blocks, pointing to the first block of the set */
+        trsm = tasks2d->tasktab + tasks2d->taskptr[k];
+        task = trsm;
+        blok = cblk[0].fblokptr + 1;
+        lblk = cblk[1].fblokptr;
+        for( m=0; m<setnbr; m++, task++ ) {
+            task->cblknum = cblk - solvmtx->cblktab;
+            task->m       = m;
+            task->n       = m;
+            task->blok_mk = blok - cblk->fblokptr;
+            task->blok_nk = task->blok_mk;
+            task->blok_mn = -1;
+            task->ctrbcnt = setnbr - m;
+            task->type    = TASK2D_TRSM;
+
+            /* Move to the next set */
+            while( (blok + 1 < lblk) &&
+                   (blok[0].fcblknm == blok[1].fcblknm) )
+            {
+                blok++;
+            }
+            blok++;
+        }
+        assert( blok == lblk );
+
+        /* GEMM: stored by rows, (m, n) is at the index m * (m+1) / 2 + n */
+        for( m=0; m<setnbr; m++ ) {
+            for( n=0; n<=m; n++, task++ ) {
+                blok  = cblk->fblokptr + trsm[n].blok_mk;
+                fcblk = solvmtx->cblktab + blok->fcblknm;
+
+                task->cblknum = cblk - solvmtx->cblktab;
+                task->m       = m;
+                task->n       = n;
+                task->blok_mk = trsm[m].blok_mk;
+                task->blok_nk = trsm[n].blok_mk;
+                task->blok_mn = solver_task2d_blok_mn( fcblk, cblk->fblokptr + task->blok_mk );
+                task->ctrbcnt = (m == n) ? 1 : 2;
+                task->type    = TASK2D_GEMM;
+            }
+        }
+        assert( task == tasks2d->tasktab + tasks2d->taskptr[k+1] );
+    }
+
+    return tasknbr;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Free the block-level tasks structure.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] tasks2d
+ *          The structure to free.
+ *
+ *******************************************************************************/
+void
+solverTasks2dExit( solver_tasks2d_t *tasks2d )
+{
+    if ( tasks2d->taskptr ) {
+        memFree_null( tasks2d->taskptr );
+    }
+    if ( tasks2d->setnbr ) {
+        memFree_null( tasks2d->setnbr );
+    }
+    if ( tasks2d->tasktab ) {
+        memFree_null( tasks2d->tasktab );
+    }
+    tasks2d->tasknbr = 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Release the TRSM tasks of a 2D cblk once its diagonal block is
+ * factorized.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[in] cblk
+ *          The 2D cblk whose diagonal block has been factorized.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+void
+solverTasks2dReleasePanel( SolverMatrix           *solvmtx,
+                           const solver_tasks2d_t *tasks2d,
+                           const SolverCblk       *cblk,
+                           int                     rank )
+{
+    pastix_int_t k = (cblk - solvmtx->cblktab) - tasks2d->cblkmin;
+    pastix_int_t m, trsmidx;
+
+    assert( (k >= 0) && (k < solvmtx->cblknbr - tasks2d->cblkmin) );
+    trsmidx = solvmtx->cblknbr + tasks2d->taskptr[k];
+
+    /* Push in reverse order for the first sets to be popped first from a deque */
+    for( m=tasks2d->setnbr[k]-1; m>=0; m-- ) {
+        pushQueue( solvmtx, rank, trsmidx + m );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Release the GEMM tasks depending on a TRSM task.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[in] task
+ *          The TRSM task that has been completed.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+void
+solverTasks2dReleaseTrsm( SolverMatrix           *solvmtx,
+                          const solver_tasks2d_t *tasks2d,
+                          const solver_task2d_t  *task,
+                          int                     rank )
+{
+    pastix_int_t     k       = task->cblknum - tasks2d->cblkmin;
+    pastix_int_t     setnbr  = tasks2d->setnbr[k];
+    pastix_int_t     gemmidx = tasks2d->taskptr[k] + setnbr;
+    pastix_int_t     m       = task->m;
+    pastix_int_t     i, n, idx;
+    solver_task2d_t *gemm;
+
+    assert( task->type == TASK2D_TRSM );
+
+    /* GEMM (m, n) with n <= m */
+    for( n=0; n<=m; n++ ) {
+        idx  = gemmidx + (m * (m+1)) / 2 + n;
+        gemm = tasks2d->tasktab + idx;
+        if ( !pastix_atomic_dec_32b( &(gemm->ctrbcnt) ) ) {
+            pushQueue( solvmtx, rank, solvmtx->cblknbr + idx );
+        }
+    }
+
+    /* GEMM (i, m) with i > m */
+    for( i=m+1; i<setnbr; i++ ) {
+        idx  = gemmidx + (i * (i+1)) / 2 + m;
+        gemm = tasks2d->tasktab + idx;
+        if ( !pastix_atomic_dec_32b( &(gemm->ctrbcnt) ) ) {
+            pushQueue( solvmtx, rank, solvmtx->cblknbr + idx );
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Release the dependencies of the facing cblk after a GEMM task.
+ *
+ * When all the GEMM tasks updating the cblk facing the set n are completed,
+ * the contribution counter of this cblk is decreased once per block of the set,
+ * as it would be done by the 1D update of the cblk.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[in] task
+ *          The GEMM task that has been completed.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+void
+solverTasks2dReleaseGemm( SolverMatrix           *solvmtx,
+                          const solver_tasks2d_t *tasks2d,
+                          const solver_task2d_t  *task,
+                          int                     rank )
+{
+    pastix_int_t      k    = task->cblknum - tasks2d->cblkmin;
+    solver_task2d_t  *trsm = tasks2d->tasktab + tasks2d->taskptr[k] + task->n;
+    const SolverCblk *cblk;
+    const SolverBlok *blok, *lblk;
+    SolverCblk       *fcblk;
+
+    assert( task->type == TASK2D_GEMM );
+
+    if ( pastix_atomic_dec_32b( &(trsm->ctrbcnt) ) ) {
+        return;
+    }
+
+    cblk  = solvmtx->cblktab + task->cblknum;
+    blok  = cblk[0].fblokptr + task->blok_nk;
+    lblk  = cblk[1].fblokptr;
+    fcblk = solvmtx->cblktab + blok->fcblknm;
+
+    for( ; (blok < lblk) && (solvmtx->cblktab + blok->fcblknm == fcblk); blok++ ) {
+        if ( !cblk_ctrbcnt_dec( fcblk ) ) {
+            pushQueue( solvmtx, rank, fcblk - solvmtx->cblktab );
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Lock the blocks of the facing cblk updated by a GEMM task.
+ *
+ * The blocks are locked in ascending order to avoid deadlocks with the other
+ * GEMM tasks, while the 1D updates lock a single block at a time.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] task
+ *          The GEMM task that will update the facing cblk.
+ *
+ *******************************************************************************/
+void
+solverTasks2dLockGemm( SolverMatrix          *solvmtx,
+                       const solver_task2d_t *task )
+{
+    const SolverCblk *cblk  = solvmtx->cblktab + task->cblknum;
+    const SolverBlok *blokA = cblk->fblokptr + task->blok_mk;
+    const SolverBlok *blokB = cblk->fblokptr + task->blok_nk;
+    SolverCblk       *fcblk = solvmtx->cblktab + blokB->fcblknm;
+    SolverBlok       *blokC = fcblk->fblokptr + task->blok_mn;
+    const SolverBlok *lblkC = fcblk[1].fblokptr;
+
+    assert( task->type == TASK2D_GEMM );
+
+    if ( kernels_lock_cblk ) {
+        kernel_update_lock( &(fcblk->lock), &(fcblk->lock) );
+        return;
+    }
+
+    for( ; (blokC < lblkC) && (blokC->fcblknm == blokA->fcblknm); blokC++ ) {
+        kernel_update_lock( &(fcblk->lock), &(blokC->lock) );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Unlock the blocks locked by solverTasks2dLockGemm().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[in] task
+ *          The GEMM task that updated the facing cblk.
+ *
+ *******************************************************************************/
+void
+solverTasks2dUnlockGemm( SolverMatrix          *solvmtx,
+                         const solver_task2d_t *task )
+{
+    const SolverCblk *cblk  = solvmtx->cblktab + task->cblknum;
+    const SolverBlok *blokA = cblk->fblokptr + task->blok_mk;
+    const SolverBlok *blokB = cblk->fblokptr + task->blok_nk;
+    SolverCblk       *fcblk = solvmtx->cblktab + blokB->fcblknm;
+    SolverBlok       *blokC = fcblk->fblokptr + task->blok_mn;
+    const SolverBlok *lblkC = fcblk[1].fblokptr;
+
+    assert( task->type == TASK2D_GEMM );
+
+    if ( kernels_lock_cblk ) {
+        kernel_update_unlock( &(fcblk->lock), &(fcblk->lock) );
+        return;
+    }
+
+    for( ; (blokC < lblkC) && (blokC->fcblknm == blokA->fcblknm); blokC++ ) {
+        kernel_update_unlock( &(fcblk->lock), &(blokC->lock) );
+    }
+}
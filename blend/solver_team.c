@@ -0,0 +1,300 @@
+/**
+ *
+ * @file solver_team.c
+ *
+ * PaStiX thread teams of the internal dynamic scheduler.
+ *
+ * @copyright 2004-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include "common.h"
+#include "queue.h"
+#include "solver.h"
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Initialize the team structure and flag the cblks of the tail of the
+ * elimination tree.
+ *
+ * The depth of each cblk in the elimination tree is computed from the first
+ * off-diagonal block of the cblks, and a cblk belongs to the tail of the tree
+ * if there are less cblks than threads at its depth. Only the cblks with at
+ * least two off-diagonal blocks are flagged, as a single update can not be
+ * shared.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[out] team
+ *          The team structure to initialize.
+ *
+ * @param[in] thrdnbr
+ *          The number of threads of the scheduler.
+ *
+ *******************************************************************************
+ *
+ * @return The number of cblks in the tail of the elimination tree.
+ *
+ *******************************************************************************/
+pastix_int_t
+solverTeamInit( const SolverMatrix *solvmtx,
+                solver_team_t      *team,
+                int                 thrdnbr )
+{
+    const SolverCblk *cblk;
+    pastix_int_t     *depth, *levelnbr;
+    pastix_int_t      k, parent, bloknbr;
+    pastix_int_t      tailnbr = 0;
+
+    memset( team, 0, sizeof(solver_team_t) );
+    team->cblknum = -1;
+
+    if ( (thrdnbr < 2) || (solvmtx->cblknbr == 0) ) {
+        return 0;
+    }
+
+    MALLOC_INTERN( depth,    solvmtx->cblknbr, pastix_int_t );
+    MALLOC_INTERN( levelnbr, solvmtx->cblknbr, pastix_int_t );
+    memset( levelnbr, 0, solvmtx->cblknbr * sizeof(pastix_int_t) );
+
+    /* The father of a cblk is always after the cblk */
+    cblk = solvmtx->cblktab + solvmtx->cblknbr - 1;
+    for( k=solvmtx->cblknbr-1; k>=0; k--, cblk-- ) {
+        if ( cblk[0].fblokptr + 1 < cblk[1].fblokptr ) {
+            parent = cblk->fblokptr[1].fcblknm;
+            assert( parent > k );
+            depth[k] = depth[parent] + 1;
+        }
+        else {
+            depth[k] = 0;
+        }
+        levelnbr[ depth[k] ]++;
+    }
+
+    MALLOC_INTERN( team->tailtab, solvmtx->cblknbr, int8_t );
+    cblk = solvmtx->cblktab;
+    for( k=0; k<solvmtx->cblknbr; k++, cblk++ ) {
+        bloknbr = cblk[1].fblokptr - cblk[0].fblokptr - 1;
+        team->tailtab[k] = ( (levelnbr[ depth[k] ] < thrdnbr) &&
+                             (bloknbr > 1) &&
+                             !(cblk->cblktype & CBLK_IN_SCHUR) );
+        tailnbr += team->tailtab[k];
+    }
+
+    memFree_null( depth );
+    memFree_null( levelnbr );
+
+    if ( tailnbr == 0 ) {
+        solverTeamExit( team );
+    }
+    return tailnbr;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Free the team structure.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] team
+ *          The team structure to free.
+ *
+ *******************************************************************************/
+void
+solverTeamExit( solver_team_t *team )
+{
+    if ( team->tailtab ) {
+        memFree_null( team->tailtab );
+    }
+}
+
+/**
+ * @brief Update the off-diagonal blocks of the current job until all of them
+ * are taken, and release the dependencies of the facing cblks.
+ */
+static inline void
+solver_team_loop( SolverMatrix  *solvmtx,
+                  solver_team_t *team,
+                  SolverCblk    *cblk,
+                  void          *work,
+                  pastix_int_t   lwork,
+                  int            rank )
+{
+    SolverBlok *blok;
+    SolverCblk *fcblk;
+    int32_t     i;
+
+    /* Check the counter before incrementing it to keep it bounded while the
+     * idle threads poll a job whose blocks are all taken */
+    while( team->next < team->bloknbr ) {
+        i = pastix_atomic_inc_32b( &(team->next) ) - 1;
+        if ( i >= team->bloknbr ) {
+            break;
+        }
+        blok  = cblk->fblokptr + 1 + i;
+        fcblk = solvmtx->cblktab + blok->fcblknm;
+
+        team->func( solvmtx, team->args, cblk, blok, work, lwork );
+
+        /* The deques can only be filled by their owner, so the facing cblk is
+         * pushed in the queue of the thread that applied the last update */
+        if ( !cblk_ctrbcnt_dec( fcblk ) ) {
+            pushQueue( solvmtx, rank, blok->fcblknm );
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Apply the updates of a cblk with the help of the idle threads.
+ *
+ * The job is published for the idle threads, and the calling thread applies
+ * the updates with them. The function returns when all the updates are
+ * applied. If another job is already published, all the updates are applied
+ * by the calling thread.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[inout] team
+ *          The team structure.
+ *
+ * @param[inout] cblk
+ *          The factorized cblk whose off-diagonal blocks generate the updates.
+ *
+ * @param[in] func
+ *          The function applying the update of one off-diagonal block.
+ *
+ * @param[in] args
+ *          The arguments given to func.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+void
+solverTeamRun( SolverMatrix     *solvmtx,
+               solver_team_t    *team,
+               SolverCblk       *cblk,
+               solver_team_fct_t func,
+               void             *args,
+               void             *work,
+               pastix_int_t      lwork,
+               int               rank )
+{
+    SolverBlok *blok = cblk[0].fblokptr + 1;
+    SolverBlok *lblk = cblk[1].fblokptr;
+    SolverCblk *fcblk;
+
+    if ( !pastix_atomic_cas_32b( (volatile uint32_t *)&(team->busy), 0, 1 ) ) {
+        for( ; blok < lblk; blok++ ) {
+            fcblk = solvmtx->cblktab + blok->fcblknm;
+            func( solvmtx, args, cblk, blok, work, lwork );
+            if ( !cblk_ctrbcnt_dec( fcblk ) ) {
+                pushQueue( solvmtx, rank, blok->fcblknm );
+            }
+        }
+        return;
+    }
+
+    /*
+     * Publish the job. The number of helpers is not reset, as a thread that
+     * read the index of the previous job may still register and unregister.
+     */
+    team->next    = 0;
+    team->bloknbr = lblk - blok;
+    team->func    = func;
+    team->args    = args;
+    pastix_mfence();
+    team->cblknum = cblk - solvmtx->cblktab;
+
+    solver_team_loop( solvmtx, team, cblk, work, lwork, rank );
+
+    /* Close the job, and wait for the helpers to complete their updates */
+    team->cblknum = -1;
+    pastix_mfence();
+    while( team->members > 0 ) {
+        isched_cpu_relax();
+    }
+    team->busy = 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Join the published team job, if any.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure.
+ *
+ * @param[inout] team
+ *          The team structure.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************
+ *
+ * @return 1 if a job has been joined, 0 otherwise.
+ *
+ *******************************************************************************/
+int
+solverTeamHelp( SolverMatrix  *solvmtx,
+                solver_team_t *team,
+                void          *work,
+                pastix_int_t   lwork,
+                int            rank )
+{
+    int32_t cblknum = team->cblknum;
+
+    if ( cblknum == -1 ) {
+        return 0;
+    }
+
+    /* Register before checking that the job is still published */
+    pastix_atomic_inc_32b( &(team->members) );
+    if ( team->cblknum != cblknum ) {
+        pastix_atomic_dec_32b( &(team->members) );
+        return 0;
+    }
+
+    solver_team_loop( solvmtx, team, solvmtx->cblktab + cblknum,
+                      work, lwork, rank );
+
+    pastix_atomic_dec_32b( &(team->members) );
+    return 1;
+}
@@ -0,0 +1,124 @@
+/**
+ *
+ * @file solver_updates.c
+ *
+ * PaStiX update plans of the supernodal GEMM kernels.
+ *
+ * @copyright 2004-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include "common.h"
+#include "solver.h"
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup blend_dev_solver_null
+ *
+ * @brief Compute the update plans of the off-diagonal blocks.
+ *
+ * The update generated by an off-diagonal block blok is the product of the
+ * blocks (blok .. cblk[1].fblokptr-1) of its cblk by blok, and it is added to
+ * the cblk facing blok. The plan of blok stores, for each of these blocks, the
+ * index relative to fcblk->fblokptr of the facing block that includes its
+ * rows. The plans depend only on the symbolic structure, so the GEMM kernels
+ * get the facing blocks with blok_facing_blok() without walking the blocks of
+ * the facing cblk at each factorization.
+ *
+ * A block whose update can not be mapped on the facing cblk, or whose cblk has
+ * more than maxblok off-diagonal blocks, keeps a NULL plan, and the kernels
+ * fall back on the search.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure. On exit, the updttab array is
+ *          allocated, and the updtplan field of the off-diagonal blocks is set.
+ *
+ * @param[in] maxblok
+ *          The maximal number of off-diagonal blocks of a cblk to compute the
+ *          plans of its blocks, SOLVER_UPDTPLAN_MAXBLOK by default. If maxblok
+ *          is 0, no plan is computed.
+ *
+ *******************************************************************************
+ *
+ * @return The number of entries of the update plans.
+ *
+ *******************************************************************************/
+pastix_int_t
+solverUpdatePlanInit( SolverMatrix *solvmtx,
+                      pastix_int_t  maxblok )
+{
+    SolverCblk   *cblk, *fcblk;
+    SolverBlok   *blok, *lblok, *fblok, *lfblok;
+    SolverBlok   *iterblok;
+    int32_t      *plan;
+    pastix_int_t  k, bloknbr;
+    pastix_int_t  updtnbr = 0;
+
+    if ( solvmtx->updttab != NULL ) {
+        memFree_null( solvmtx->updttab );
+    }
+    solvmtx->updtnbr = 0;
+
+    /* The plan of a block has one entry per block below it in the cblk */
+    cblk = solvmtx->cblktab;
+    for( k=0; k<solvmtx->cblknbr; k++, cblk++ ) {
+        bloknbr = cblk[1].fblokptr - cblk[0].fblokptr - 1;
+        if ( bloknbr <= maxblok ) {
+            updtnbr += ( bloknbr * (bloknbr + 1) ) / 2;
+        }
+
+        for( blok=cblk[0].fblokptr; blok<cblk[1].fblokptr; blok++ ) {
+            blok->updtplan = NULL;
+        }
+    }
+
+    if ( updtnbr == 0 ) {
+        return 0;
+    }
+
+    MALLOC_INTERN( solvmtx->updttab, updtnbr, int32_t );
+    solvmtx->updtnbr = updtnbr;
+
+    plan = solvmtx->updttab;
+    cblk = solvmtx->cblktab;
+    for( k=0; k<solvmtx->cblknbr; k++, cblk++ ) {
+        lblok = cblk[1].fblokptr;
+
+        if ( (lblok - cblk[0].fblokptr - 1) > maxblok ) {
+            continue;
+        }
+
+        for( blok=cblk[0].fblokptr+1; blok<lblok; blok++, plan += lblok - blok + 1 ) {
+            if ( blok->fcblknm < 0 ) {
+                continue;
+            }
+            fcblk  = solvmtx->cblktab + blok->fcblknm;
+            fblok  = fcblk[0].fblokptr;
+            lfblok = fcblk[1].fblokptr;
+
+            for( iterblok=blok; iterblok<lblok; iterblok++ ) {
+                while( (fblok < lfblok) && !is_block_inside_fblock( iterblok, fblok ) ) {
+                    fblok++;
+                }
+                if ( fblok == lfblok ) {
+                    break;
+                }
+                plan[ iterblok - blok ] = fblok - fcblk[0].fblokptr;
+            }
+
+            if ( iterblok == lblok ) {
+                blok->updtplan = plan;
+            }
+        }
+    }
+    assert( plan == solvmtx->updttab + updtnbr );
+
+    return updtnbr;
+}
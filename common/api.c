@@ -23,6 +23,7 @@
 #include "pastix/order.h"
 #include "solver.h"
 #include "bcsc.h"
+#include "coeftab.h"
 #include "isched.h"
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -449,11 +450,16 @@ pastixInitParam( pastix_int_t *iparm,
     iparm[IPARM_FACTORIZATION]         = PastixFactLU;
     iparm[IPARM_STATIC_PIVOTING]       = 0;
     iparm[IPARM_FREE_CSCUSER]          = 0;
+    iparm[IPARM_REUSE_SCATTER_MAP]     = 0;
+    iparm[IPARM_MIXED]                 = 0;
+    iparm[IPARM_UPDATE_LOCK_CBLK]      = 0;
+    iparm[IPARM_UPDATE_MODE]           = PastixUpdateModeAuto;
     iparm[IPARM_SCHUR_FACT_MODE]       = PastixFactModeLocal;
 
     /* Solve */
     iparm[IPARM_SCHUR_SOLV_MODE]       = PastixSolvModeLocal;
     iparm[IPARM_APPLYPERM_WS]          = 1;
+    iparm[IPARM_SOLVE_LOWPREC]         = 0;
 
     /* Refinement */
     iparm[IPARM_REFINEMENT]            = PastixRefineGMRES;
@@ -465,6 +471,9 @@ pastixInitParam( pastix_int_t *iparm,
     iparm[IPARM_SCHEDULER]             = PastixSchedStatic;
     iparm[IPARM_THREAD_NBR]            = -1;
     iparm[IPARM_AUTOSPLIT_COMM]        = 0;
+    iparm[IPARM_DYNAMIC_QUEUE]         = PastixDynQueueHeap;
+    iparm[IPARM_DYNAMIC_TEAM]          = 1;
+    iparm[IPARM_NUMA_INIT]             = 0;
 
     /* GPU */
     iparm[IPARM_GPU_NBR]               = 0;
@@ -478,6 +487,9 @@ pastixInitParam( pastix_int_t *iparm,
     iparm[IPARM_COMPRESS_METHOD]       = PastixCompressMethodPQRCP;
     iparm[IPARM_COMPRESS_ORTHO]        = PastixCompressOrthoCGS;
     iparm[IPARM_COMPRESS_PRESELECT]    = -1;
+    iparm[IPARM_COMPRESS_LOWPREC]      = 0;
+    iparm[IPARM_COMPRESS_POLICY]       = 0;
+    iparm[IPARM_COMPRESS_SKETCH]       = 0;
 
     /* MPI modes */
 #if defined(PASTIX_WITH_MPI)
@@ -535,6 +547,7 @@ pastixInitParam( pastix_int_t *iparm,
     dparm[DPARM_A_NORM]             = -1.;
     dparm[DPARM_COMPRESS_TOLERANCE] = 0.01;
     dparm[DPARM_COMPRESS_MIN_RATIO] =  1.;
+    dparm[DPARM_SUBTREE_COST]       =  5e-5;
 }
 
 /**
@@ -797,6 +810,7 @@ pastixInitWithAffinity( pastix_data_t **pastix_data,
 
     pastix->bcsc       = NULL;
     pastix->solvmatr   = NULL;
+    pastix->solvlowp   = NULL;
 
     pastix->cpu_models = NULL;
     pastix->gpu_models = NULL;
@@ -891,6 +905,8 @@ pastixFinalize( pastix_data_t **pastix_data )
         memFree_null( pastix->symbmtx );
     }
 
+    coeftabLowPrecisionExit( pastix );
+
     if ( pastix->solvmatr != NULL )
     {
         solverExit( pastix->solvmatr );
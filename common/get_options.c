@@ -95,10 +95,15 @@ parse_iparm( const char *iparm )
 
     if(0 == strcasecmp("iparm_factorization",         iparm)) { return IPARM_FACTORIZATION; }
     if(0 == strcasecmp("iparm_free_cscuser",          iparm)) { return IPARM_FREE_CSCUSER; }
+    if(0 == strcasecmp("iparm_reuse_scatter_map",     iparm)) { return IPARM_REUSE_SCATTER_MAP; }
+    if(0 == strcasecmp("iparm_mixed",                 iparm)) { return IPARM_MIXED; }
+    if(0 == strcasecmp("iparm_update_lock_cblk",      iparm)) { return IPARM_UPDATE_LOCK_CBLK; }
+    if(0 == strcasecmp("iparm_update_mode",           iparm)) { return IPARM_UPDATE_MODE; }
     if(0 == strcasecmp("iparm_schur_fact_mode",       iparm)) { return IPARM_SCHUR_FACT_MODE; }
 
     if(0 == strcasecmp("iparm_schur_solv_mode",       iparm)) { return IPARM_SCHUR_SOLV_MODE; }
     if(0 == strcasecmp("iparm_applyperm_ws",          iparm)) { return IPARM_APPLYPERM_WS; }
+    if(0 == strcasecmp("iparm_solve_lowprec",         iparm)) { return IPARM_SOLVE_LOWPREC; }
 
     if(0 == strcasecmp("iparm_refinement",            iparm)) { return IPARM_REFINEMENT; }
     if(0 == strcasecmp("iparm_itermax",               iparm)) { return IPARM_ITERMAX; }
@@ -107,6 +112,9 @@ parse_iparm( const char *iparm )
     if(0 == strcasecmp("iparm_scheduler",             iparm)) { return IPARM_SCHEDULER; }
     if(0 == strcasecmp("iparm_thread_nbr",            iparm)) { return IPARM_THREAD_NBR; }
     if(0 == strcasecmp("iparm_autosplit_comm",        iparm)) { return IPARM_AUTOSPLIT_COMM; }
+    if(0 == strcasecmp("iparm_dynamic_queue",         iparm)) { return IPARM_DYNAMIC_QUEUE; }
+    if(0 == strcasecmp("iparm_dynamic_team",          iparm)) { return IPARM_DYNAMIC_TEAM; }
+    if(0 == strcasecmp("iparm_numa_init",             iparm)) { return IPARM_NUMA_INIT; }
 
     if(0 == strcasecmp("iparm_gpu_nbr",               iparm)) { return IPARM_GPU_NBR; }
     if(0 == strcasecmp("iparm_gpu_memory_percentage", iparm)) { return IPARM_GPU_MEMORY_PERCENTAGE; }
@@ -119,6 +127,9 @@ parse_iparm( const char *iparm )
     if(0 == strcasecmp("iparm_compress_ortho",        iparm)) { return IPARM_COMPRESS_ORTHO; }
     if(0 == strcasecmp("iparm_compress_reltol",       iparm)) { return IPARM_COMPRESS_RELTOL; }
     if(0 == strcasecmp("iparm_compress_preselect",    iparm)) { return IPARM_COMPRESS_PRESELECT; }
+    if(0 == strcasecmp("iparm_compress_lowprec",      iparm)) { return IPARM_COMPRESS_LOWPREC; }
+    if(0 == strcasecmp("iparm_compress_policy",       iparm)) { return IPARM_COMPRESS_POLICY; }
+    if(0 == strcasecmp("iparm_compress_sketch",       iparm)) { return IPARM_COMPRESS_SKETCH; }
 
     if(0 == strcasecmp("iparm_modify_parameter",      iparm)) { return IPARM_MODIFY_PARAMETER; }
     if(0 == strcasecmp("iparm_start_task",            iparm)) { return IPARM_START_TASK; }
@@ -157,6 +168,7 @@ parse_dparm( const char *dparm )
     if(0 == strcasecmp("dparm_epsilon_magn_ctrl",  dparm)) { return DPARM_EPSILON_MAGN_CTRL;  }
     if(0 == strcasecmp("dparm_compress_tolerance", dparm)) { return DPARM_COMPRESS_TOLERANCE; }
     if(0 == strcasecmp("dparm_compress_min_ratio", dparm)) { return DPARM_COMPRESS_MIN_RATIO; }
+    if(0 == strcasecmp("dparm_subtree_cost",       dparm)) { return DPARM_SUBTREE_COST;       }
     return -1;
 }
 
@@ -279,6 +291,13 @@ parse_enums( const char *string )
     if(0 == strcasecmp("pastixschedparsec",     string)) { return PastixSchedParsec;     }
     if(0 == strcasecmp("pastixschedstarpu",     string)) { return PastixSchedStarPU;     }
 
+    if(0 == strcasecmp("pastixdynqueueheap",    string)) { return PastixDynQueueHeap;    }
+    if(0 == strcasecmp("pastixdynqueuedeque",   string)) { return PastixDynQueueDeque;   }
+
+    if(0 == strcasecmp("pastixupdatemodeauto",     string)) { return PastixUpdateModeAuto;     }
+    if(0 == strcasecmp("pastixupdatemodefused",    string)) { return PastixUpdateModeFused;    }
+    if(0 == strcasecmp("pastixupdatemodebuffered", string)) { return PastixUpdateModeBuffered; }
+
     if(0 == strcasecmp("pastixcompressnever",      string)) { return PastixCompressNever;      }
     if(0 == strcasecmp("pastixcompresswhenbegin",  string)) { return PastixCompressWhenBegin;  }
     if(0 == strcasecmp("pastixcompresswhenend",    string)) { return PastixCompressWhenEnd;    }
@@ -44,52 +44,56 @@ isched_barrier_init(isched_barrier_t* barrier,
                     const void* attr,
                     unsigned int count)
 {
-    int rc;
-
-    if( 0 != (rc = pthread_mutex_init(&(barrier->mutex), attr)) ) {
-        return rc;
-    }
-
     barrier->count      = count;
+    barrier->spincount  = ISCHED_SPIN_COUNT;
     barrier->curcount   = 0;
     barrier->generation = 0;
-    if( 0 != (rc = pthread_cond_init(&(barrier->cond), NULL)) ) {
-        pthread_mutex_destroy( &(barrier->mutex) );
-        return rc;
-    }
+    barrier->sleepers   = 0;
+
+    (void)attr;
     return 0;
 }
 
 int
 isched_barrier_wait(isched_barrier_t* barrier)
 {
-    int generation;
+    uint32_t generation = barrier->generation;
+    int      spin;
+
+    /* Make sure the generation is read before arriving */
+    pastix_mfence();
 
-    pthread_mutex_lock( &(barrier->mutex) );
-    if( (barrier->curcount + 1) == barrier->count) {
-        barrier->generation++;
+    if ( pastix_atomic_inc_32b( &(barrier->curcount) ) == barrier->count ) {
+        /* Last thread: reset the counter and flip the sense */
         barrier->curcount = 0;
-        pthread_cond_broadcast( &(barrier->cond) );
-        pthread_mutex_unlock( &(barrier->mutex) );
+        pastix_atomic_inc_32b( (volatile int32_t*)&(barrier->generation) );
+        if ( barrier->sleepers > 0 ) {
+            isched_unpark( &(barrier->generation) );
+        }
         return 1;
     }
-    barrier->curcount++;
-    generation = barrier->generation;
-    for(;;) {
-        pthread_cond_wait( &(barrier->cond), &(barrier->mutex) );
-        if( generation != barrier->generation ) {
-            break;
+
+    /* Spin for a while */
+    for( spin = 0; spin < barrier->spincount; spin++ ) {
+        if ( barrier->generation != generation ) {
+            return 0;
         }
+        isched_cpu_relax();
     }
-    pthread_mutex_unlock( &(barrier->mutex) );
+
+    /* Park until the release */
+    pastix_atomic_inc_32b( &(barrier->sleepers) );
+    while( barrier->generation == generation ) {
+        isched_park( &(barrier->generation), generation );
+    }
+    pastix_atomic_dec_32b( &(barrier->sleepers) );
     return 0;
 }
 
 int
 isched_barrier_destroy(isched_barrier_t* barrier)
 {
-    pthread_mutex_destroy( &(barrier->mutex) );
-    pthread_cond_destroy( &(barrier->cond) );
+    assert( barrier->sleepers == 0 );
     barrier->count    = 0;
     barrier->curcount = 0;
     return 0;
@@ -125,9 +129,14 @@ isched_thread_init(void *ptr)
     thread_ctx->rank       = isched->rank;
     thread_ctx->bindto     = isched->bindto;
 
+    thread_ctx->numaid     = -1;
+
     /* Set thread affinity for the worker */
     if ( isched->bindto >= 0 ) {
-        isched_topo_bind_on_core_index( isched->bindto % isched->global_ctx->world_size );
+        int core = isched->bindto % isched->global_ctx->world_size;
+        if ( isched_topo_bind_on_core_index( core ) >= 0 ) {
+            thread_ctx->numaid = isched_topo_numa_id( core );
+        }
     }
 
     if ( thread_ctx->rank != 0 ) {
@@ -157,17 +166,16 @@ void *
 isched_parallel_section(isched_thread_t *ctx)
 {
     isched_t *isched = ctx->global_ctx;
+    uint32_t  epoch  = isched->epoch;
     int action;
 
     /* Wait for everyone but the master thread to enter this section */
     isched_barrier_wait( &(isched->barrier) );
 
     while(1) {
-        pthread_mutex_lock( &(isched->statuslock) );
-        while ((action = isched->status) == ISCHED_ACT_STAND_BY)
-            pthread_cond_wait( &(isched->statuscond), &(isched->statuslock) );
-        pthread_mutex_unlock( &(isched->statuslock) );
-        isched_barrier_wait( &(isched->barrier) );
+        /* Wait for the master to publish a new action */
+        epoch = isched_wait_epoch( isched, epoch );
+        action = isched->status;
 
         switch (action) {
             case ISCHED_ACT_PARALLEL:
@@ -223,9 +231,9 @@ isched_t *ischedInit(int cores, const int *coresbind)
         return NULL;
     }
 
-    pthread_mutex_init(&(isched->statuslock), NULL);
-    pthread_cond_init( &(isched->statuscond), NULL);
-    isched->status = ISCHED_ACT_STAND_BY;
+    isched->status   = ISCHED_ACT_STAND_BY;
+    isched->epoch    = 0;
+    isched->sleepers = 0;
 
     isched->pfunc = NULL;
     isched->pargs = NULL;
@@ -249,8 +257,17 @@ isched_t *ischedInit(int cores, const int *coresbind)
         isched->world_size = 1;
     }
 
+    isched->numanbr = isched_topo_numa_nbr();
+
+    /* Set the number of polling iterations before a waiting thread is parked */
+    isched->spincount = pastix_getenv_get_value_int( "PASTIX_ISCHED_SPINCOUNT", ISCHED_SPIN_COUNT );
+    if ( isched->spincount < 0 ) {
+        isched->spincount = 0;
+    }
+
     /* Initialize barrier */
     isched_barrier_init( &(isched->barrier), NULL, isched->world_size );
+    isched->barrier.spincount = isched->spincount;
 
     /* If the given coresbind is NULL, try to get one from the environment */
     if (coresbind == NULL) {
@@ -314,12 +331,7 @@ int ischedFinalize(isched_t *isched)
     void *exitcodep;
 
     /* Make sure the threads exit the parallel function */
-    pthread_mutex_lock(&isched->statuslock);
-    isched->status = ISCHED_ACT_FINALIZE;
-    pthread_mutex_unlock(&isched->statuslock);
-    pthread_cond_broadcast(&isched->statuscond);
-    isched_barrier_wait(&(isched->barrier));
-    isched->status = ISCHED_ACT_STAND_BY;
+    isched_post_action( isched, ISCHED_ACT_FINALIZE );
 
     // Join threads
     for (core = 1; core < isched->world_size; core++) {
@@ -18,6 +18,7 @@
 #define _isched_h_
 
 #include "isched_barrier.h"
+#include "isched_wait.h"
 
 BEGIN_C_DECLS
 
@@ -37,6 +38,7 @@ typedef struct isched_thread_s {
     isched_t        *global_ctx;
     int              rank;
     int              bindto;
+    int              numaid;    /**< NUMA node of the thread, -1 if not bound */
 } isched_thread_t;
 
 /**
@@ -44,11 +46,16 @@ typedef struct isched_thread_s {
  */
 struct isched_s {
     int              world_size;
+    int              numanbr;   /**< Number of NUMA nodes of the machine */
+
+    int              spincount; /**< Number of polling iterations before parking */
 
     isched_barrier_t barrier;
-    pthread_mutex_t  statuslock;
-    pthread_cond_t   statuscond;
-    volatile int     status;
+
+    volatile uint32_t epoch;    /**< Incremented each time a new action is posted */
+    volatile int32_t  sleepers; /**< Number of threads parked on the epoch        */
+    volatile int      status;
+    char              pad[ISCHED_CACHE_LINE - sizeof(uint32_t) - sizeof(int32_t) - sizeof(int)];
 
     pthread_t       *tids;
     isched_thread_t *master;
@@ -64,12 +71,16 @@ struct isched_s {
 #define isched_topo_bind_on_core_index isched_hwloc_bind_on_core_index
 #define isched_topo_unbind             isched_hwloc_unbind
 #define isched_topo_world_size         isched_hwloc_world_size
+#define isched_topo_numa_id            isched_hwloc_numa_id
+#define isched_topo_numa_nbr           isched_hwloc_numa_nbr
 #else
 #define isched_topo_init               isched_nohwloc_init
 #define isched_topo_destroy            isched_nohwloc_destroy
 #define isched_topo_bind_on_core_index isched_nohwloc_bind_on_core_index
 #define isched_topo_unbind             isched_nohwloc_unbind
 #define isched_topo_world_size         isched_nohwloc_world_size
+#define isched_topo_numa_id            isched_nohwloc_numa_id
+#define isched_topo_numa_nbr           isched_nohwloc_numa_nbr
 #endif
 
 int  isched_topo_init(void);
@@ -77,18 +88,91 @@ int  isched_topo_destroy(void);
 int  isched_topo_bind_on_core_index(int);
 int  isched_topo_unbind();
 int  isched_topo_world_size();
+int  isched_topo_numa_id(int);
+int  isched_topo_numa_nbr();
+
+/**
+ * @brief Wait for the master thread to post a new action.
+ *
+ * The calling thread polls the epoch for spincount iterations, and is then
+ * parked until the epoch is incremented by isched_post_action().
+ *
+ * @param[in] isched
+ *          The scheduler context.
+ *
+ * @param[in] epoch
+ *          The last epoch seen by the calling thread.
+ *
+ * @return The new epoch.
+ */
+static inline uint32_t
+isched_wait_epoch( isched_t *isched, uint32_t epoch )
+{
+    int spin;
+
+    for( spin = 0; spin < isched->spincount; spin++ ) {
+        if ( isched->epoch != epoch ) {
+            goto posted;
+        }
+        isched_cpu_relax();
+    }
+
+    pastix_atomic_inc_32b( &(isched->sleepers) );
+    while( isched->epoch == epoch ) {
+        isched_park( &(isched->epoch), epoch );
+    }
+    pastix_atomic_dec_32b( &(isched->sleepers) );
+
+  posted:
+    /* Make sure the action is read after the epoch */
+    pastix_mfence();
+    return isched->epoch;
+}
+
+/**
+ * @brief Post a new action to the worker threads.
+ *
+ * @param[inout] isched
+ *          The scheduler context.
+ *
+ * @param[in] action
+ *          The action to perform by the worker threads.
+ */
+static inline void
+isched_post_action( isched_t *isched, int action )
+{
+    isched->status = action;
+
+    /* Publish the action before the epoch */
+    pastix_mfence();
+    pastix_atomic_inc_32b( (volatile int32_t*)&(isched->epoch) );
+    if ( isched->sleepers > 0 ) {
+        isched_unpark( &(isched->epoch) );
+    }
+}
 
+/**
+ * @brief Execute a function on all the threads of the scheduler.
+ *
+ * The worker threads are released through the epoch without any entry barrier,
+ * and a single barrier is used to join all the threads at the end of the
+ * call.
+ *
+ * @param[inout] isched
+ *          The scheduler context.
+ *
+ * @param[in] func
+ *          The function to execute.
+ *
+ * @param[in] args
+ *          The arguments given to the function.
+ */
 static inline void
 isched_parallel_call( isched_t *isched, void (*func)(isched_thread_t*, void*), void *args )
 {
-    pthread_mutex_lock(&isched->statuslock);
-    isched->pfunc  = func;
-    isched->pargs  = args;
-    isched->status = ISCHED_ACT_PARALLEL;
-    pthread_mutex_unlock(&isched->statuslock);
-    pthread_cond_broadcast(&isched->statuscond);
-    isched_barrier_wait( &(isched->barrier) );
-    isched->status = ISCHED_ACT_STAND_BY;
+    isched->pfunc = func;
+    isched->pargs = args;
+    isched_post_action( isched, ISCHED_ACT_PARALLEL );
     func( isched->master, args );
     isched_barrier_wait( &(isched->barrier) );
 }
@@ -18,6 +18,7 @@
 #define _isched_barrier_h_
 
 #include <unistd.h>
+#include <stdint.h>
 #include <pthread.h>
 
 /* The Linux includes are completely screwed up right now. Even if they
@@ -38,12 +39,28 @@ typedef pthread_barrier_t isched_barrier_t;
 
 #else
 
+/**
+ * @brief Size of a cache line used to pad the shared fields of the barrier.
+ */
+#define ISCHED_CACHE_LINE 64
+
+/**
+ * @brief Sense-reversing barrier.
+ *
+ * The last thread to arrive resets the counter and flips the sense of the
+ * barrier by incrementing the generation. The other threads spin on the
+ * generation for spincount iterations, and are then parked until the release.
+ * Each shared field is stored on its own cache line to avoid false sharing.
+ */
 typedef struct isched_barrier_s {
-    int                 count;
-    volatile int        curcount;
-    volatile int        generation;
-    pthread_mutex_t     mutex;
-    pthread_cond_t      cond;
+    int               count;      /**< Number of threads taking part to the barrier        */
+    int               spincount;  /**< Number of polling iterations before parking         */
+    char              pad0[ISCHED_CACHE_LINE - 2 * sizeof(int)];
+    volatile int32_t  curcount;   /**< Number of threads arrived in the current generation */
+    char              pad1[ISCHED_CACHE_LINE - sizeof(int32_t)];
+    volatile uint32_t generation; /**< Sense of the barrier, incremented at each release   */
+    volatile int32_t  sleepers;   /**< Number of threads parked on the generation          */
+    char              pad2[ISCHED_CACHE_LINE - sizeof(uint32_t) - sizeof(int32_t)];
 } isched_barrier_t;
 
 int isched_barrier_init(isched_barrier_t *barrier, const void *pthread_mutex_attr, unsigned int count);
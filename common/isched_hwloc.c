@@ -117,6 +117,30 @@ int isched_hwloc_world_size()
     return isched_hwloc_nb_cores_per_obj( HWLOC_OBJ_MACHINE, 0 );
 }
 
+int isched_hwloc_numa_id(int core_id)
+{
+    hwloc_obj_t core, node;
+
+    core = hwloc_get_obj_by_type( topology, HWLOC_OBJ_CORE, core_id );
+    if ( core == NULL ) {
+        return -1;
+    }
+
+    /* Get the first NUMA node covering the core */
+    node = hwloc_get_next_obj_covering_cpuset_by_type( topology, core->cpuset,
+                                                       HWLOC_OBJ_NUMANODE, NULL );
+    if ( node == NULL ) {
+        return 0;
+    }
+    return node->logical_index;
+}
+
+int isched_hwloc_numa_nbr()
+{
+    int nbr = hwloc_get_nbobjs_by_type( topology, HWLOC_OBJ_NUMANODE );
+    return (nbr > 0) ? nbr : 1;
+}
+
 int isched_hwloc_bind_on_core_index(int cpu_index)
 {
     hwloc_obj_t    core;     /* Hwloc object    */
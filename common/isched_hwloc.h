@@ -99,6 +99,11 @@ int isched_hwloc_socket_id(int core_id);
  */
 int isched_hwloc_numa_id(int core_id);
 
+/**
+ * Return the number of NUMA nodes of the machine (at least 1).
+ */
+int isched_hwloc_numa_nbr();
+
 /**
  * Return the depth of the first core hardware ancestor: NUMA node or socket.
  */
@@ -88,6 +88,17 @@ int isched_nohwloc_world_size()
     return sys_corenbr;
 }
 
+int isched_nohwloc_numa_id(int cpu)
+{
+    (void)cpu;
+    return 0;
+}
+
+int isched_nohwloc_numa_nbr()
+{
+    return 1;
+}
+
 int isched_nohwloc_bind_on_core_index(int cpu)
 {
     if( -1 == cpu ) { /* Don't try binding if not required */
@@ -0,0 +1,102 @@
+/**
+ *
+ * @file isched_wait.h
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * PaStiX internal scheduler waiting routines.
+ *
+ * These routines implement a hybrid spin-then-park waiting scheme on a 32 bits
+ * word: the thread first polls the value with a pause instruction for a
+ * bounded number of iterations, and then parks itself in the kernel (futex on
+ * Linux, yield otherwise) until the value is modified and the thread is waken
+ * up.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ */
+#ifndef _isched_wait_h_
+#define _isched_wait_h_
+
+#include <stdint.h>
+#include <limits.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <sched.h>
+#endif
+
+/**
+ * @brief Default number of polling iterations before a waiting thread is parked.
+ *
+ * With the pause hint of 10 to 140 cycles depending on the processor, 4096
+ * iterations last from about ten to a couple of hundred microseconds. This is
+ * above the latency of a futex wake-up, and of the order of the short tasks at
+ * the bottom of the elimination tree: a thread waiting for a task that is
+ * released shortly does not pay the system calls, while a thread idle for
+ * longer is parked before wasting a core. The value can be overridden with
+ * the PASTIX_ISCHED_SPINCOUNT environment variable.
+ */
+#define ISCHED_SPIN_COUNT 4096
+
+/**
+ * @brief Hint the processor that the thread is in a spin-wait loop.
+ */
+static inline void
+isched_cpu_relax( void )
+{
+#if defined(PASTIX_ARCH_X86) || defined(PASTIX_ARCH_X86_64)
+    __asm__ __volatile__ ( "pause" ::: "memory" );
+#else
+    __asm__ __volatile__ ( "" ::: "memory" );
+#endif
+}
+
+/**
+ * @brief Park the calling thread while the word pointed by addr is equal to value.
+ *
+ * The function may return spuriously, so the caller must check the condition
+ * again.
+ *
+ * @param[in] addr
+ *          The address of the 32 bits word to wait on.
+ *
+ * @param[in] value
+ *          The value that was read in addr, the thread is parked only if addr
+ *          still holds this value.
+ */
+static inline void
+isched_park( volatile uint32_t *addr,
+             uint32_t           value )
+{
+#if defined(__linux__)
+    syscall( SYS_futex, (uint32_t *)addr, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0 );
+#else
+    if ( *addr == value ) {
+        sched_yield();
+    }
+#endif
+}
+
+/**
+ * @brief Wake up all the threads parked on the word pointed by addr.
+ *
+ * @param[in] addr
+ *          The address of the 32 bits word the threads are waiting on.
+ */
+static inline void
+isched_unpark( volatile uint32_t *addr )
+{
+#if defined(__linux__)
+    syscall( SYS_futex, (uint32_t *)addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+#else
+    (void)addr;
+#endif
+}
+
+#endif /* _isched_wait_h_ */
@@ -82,6 +82,33 @@ modelsGetCost3Param( const double *coefs, pastix_int_t M, pastix_int_t N, pastix
     return (time < 0.) ? 0. : time;
 }
 
+/**
+ * @brief Check if the cost of a GEMM kernel is dominated by its call overhead.
+ *
+ * The arithmetic part of the model (a7 * M * N * K) is the time of the update
+ * at the asymptotic speed of the kernel. The update is considered as small if
+ * the time predicted by the full model is more than twice this part, i.e. if
+ * the optimized BLAS kernel is predicted to run below half of its asymptotic
+ * speed, in which case calling it does not pay off.
+ *
+ * @param[in] coefs The coefficients array of the GEMM model
+ * @param[in] M The number of rows in the C matrix
+ * @param[in] N The number of columns in the C matrix
+ * @param[in] K The third dimension of the matrix product
+ * @return 1 if the update is small, 0 otherwise.
+ */
+static inline int
+modelsGemmIsSmall( const double *coefs, pastix_int_t M, pastix_int_t N, pastix_int_t K )
+{
+    double arith;
+
+    if ( coefs[7] <= 0. ) {
+        return 0;
+    }
+    arith = coefs[7] * (double)M * (double)N * (double)K;
+    return modelsGetCost3Param( coefs, M, N, K ) > 2. * arith;
+}
+
 pastix_model_t *pastixModelsNew();
 void pastixModelsFree( pastix_model_t *model );
 void pastixModelsLoad( pastix_data_t *pastix_data );
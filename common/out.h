@@ -143,6 +143,10 @@
     "    Building solver structure\n"
 #define OUT_BLEND_SOLVER_TIME                           \
     "    Solver built in                       %e s\n"
+#define OUT_BLEND_UPDTPLAN                              \
+    "    Update plans memory space             %6.2lf %co\n"
+#define OUT_BLEND_SUBTREES                              \
+    "    Leaf subtrees of the dynamic scheduler %5ld (%ld cblks)\n"
 #define OUT_BLEND_TIME                                  \
     "    Time for mapping/scheduling           %e s\n"
 
@@ -171,11 +175,35 @@
 #define OUT_COEFTAB_TIME                                \
     "    Time to initialize coeftab            %e s\n"
 
+#define OUT_COEFTAB_NUMA                                \
+    "    Coefficients initialized per NUMA node (%s):\n"
+
+#define OUT_COEFTAB_NODE                                \
+    "      Node %3d                            %.3g %co\n"
+
+#define OUT_COEFTAB_UNBOUND                             \
+    "      Unbound threads                     %.3g %co\n"
+
+#define OUT_COEFTAB_LOWPREC                             \
+    "    Single precision copy of the factors  %.3g %co\n"
+
 #define OUT_SOPALIN_TIME                                                \
     "    Time to factorize                     %e s (%5.2lf %cFlop/s)\n" \
     "    Number of operations                       %5.2lf %cFlops\n"   \
     "    Number of static pivots               %8ld\n"
 
+#define OUT_IDLE_TIME                                                   \
+    "    Idle time waiting for contributions   %e s (max %e s)\n"
+
+#define OUT_IDLE_THREAD                                 \
+    "      Thread %3d                          %e s\n"
+
+#define OUT_LOCK_WAIT                                                   \
+    "    Time waiting for the %5s update locks %e s (%ld contended)\n"
+
+#define OUT_LR_SKETCH                                                   \
+    "    Compressibility sketches %ld (%ld rejected): %6.2lf %cFlops spent, %6.2lf %cFlops of compression avoided\n"
+
 #define OUT_LOWRANK_SUMMARY                                     \
     "    Compression:\n"                                        \
     "      Elements removed             %8ld / %8ld\n"          \
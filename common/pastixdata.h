@@ -38,6 +38,8 @@ typedef struct pastix_bcsc_s pastix_bcsc_t;
 struct pastix_model_s;
 typedef struct pastix_model_s pastix_model_t;
 
+struct kernels_trace_s;
+
 /**
  *
  * @ingroup pastix_users
@@ -84,10 +86,13 @@ struct pastix_data_s {
     pastix_bcsc_t   *bcsc;               /**< Csc after reordering grouped by cblk                                */
     SolverMatrix    *solvmatr;           /**< Solver informations associated to the matrix problem - Local        */
     SolverMatrix    *solvglob;           /**< Solver informations associated to the matrix problem - Global       */
+    SolverMatrix    *solvlowp;           /**< Single precision copy of the factors used by the solves, or NULL    */
 
     pastix_model_t  *cpu_models;         /**< CPU model coefficients for the kernels                              */
     pastix_model_t  *gpu_models;         /**< GPU model coefficients for the kernels                              */
 
+    struct kernels_trace_s *trace;       /**< Per-thread kernel statistics of the running factorization           */
+
     char            *dir_global;         /**< Unique directory name to store output files                         */
     char            *dir_local;          /**< Unique directory name to store output specific to a MPI process     */
 
@@ -0,0 +1,176 @@
+/**
+ * @file async.c
+ *
+ * @brief An example that starts the numerical factorization and the solve
+ *        without waiting for their completion, and polls the requests while
+ *        the calling thread is free for other work.
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ * @ingroup pastix_examples
+ * @code
+ *
+ */
+#include <pastix.h>
+#include <spm.h>
+#include <unistd.h>
+
+int main (int argc, char **argv)
+{
+    pastix_data_t    *pastix_data = NULL; /*< Pointer to the storage structure required by pastix */
+    pastix_int_t      iparm[IPARM_SIZE];  /*< Integer in/out parameters for pastix                */
+    double            dparm[DPARM_SIZE];  /*< Floating in/out parameters for pastix               */
+    pastix_request_t *request = NULL;     /*< Handle of the pending asynchronous task             */
+    spm_driver_t      driver;
+    char             *filename;
+    spmatrix_t       *spm, spm2;
+    void             *x, *b, *x0 = NULL;
+    size_t            size;
+    long              npoll = 0;
+    int               check = 1;
+    int               nrhs  = 1;
+    int               rc    = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      &check, &driver, &filename );
+
+    /**
+     * Startup PaStiX
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    /**
+     * Read the sparse matrix with the driver
+     */
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free( filename );
+
+    spmPrintInfo( spm, stdout );
+
+    rc = spmCheckAndCorrect( spm, &spm2 );
+    if ( rc != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    /**
+     * Generate a Fake values array if needed for the numerical part
+     */
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    /**
+     * Perform ordering, symbolic factorization, and analyze steps
+     */
+    pastix_task_analyze( pastix_data, spm );
+
+    /**
+     * Normalize A matrix (optional, but recommended for low-rank functionality)
+     */
+    double normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /**
+     * Generates the b and x vector such that A * x = b
+     * Compute the norms of the initial vectors if checking purpose.
+     * This is done before the factorization, as the spm can not be accessed
+     * while the factorization is pending.
+     */
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x = malloc( size );
+    b = malloc( size );
+
+    if ( check )
+    {
+        if ( check > 1 ) {
+            x0 = malloc( size );
+        }
+        spmGenRHS( SpmRhsRndX, nrhs, spm, x0, spm->n, b, spm->n );
+        memcpy( x, b, size );
+    }
+    else {
+        spmGenRHS( SpmRhsRndB, nrhs, spm, NULL, spm->n, x, spm->n );
+
+        /* Apply also normalization to b vectors */
+        spmScalVector( spm->flttype, 1./normA, spm->n * nrhs, b, 1 );
+
+        /* Save b for refinement */
+        memcpy( b, x, size );
+    }
+
+    /**
+     * Start the numerical factorization, and poll its completion
+     */
+    rc = pastix_task_numfact_async( pastix_data, spm, &request );
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "async: unable to start the factorization (%d)\n", rc );
+        goto end;
+    }
+
+    while ( !pastixRequestTest( request ) ) {
+        /* The calling thread is free to do other work here */
+        npoll++;
+        usleep( 1000 );
+    }
+
+    rc = pastixRequestWait( &request );
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "async: the factorization failed (%d)\n", rc );
+        goto end;
+    }
+    fprintf( stdout, "async: factorization completed after %ld polls\n", npoll );
+
+    /**
+     * Solve the linear system asynchronously, wait for it, and perform the
+     * optional refinement
+     */
+    rc = pastix_task_solve_async( pastix_data, nrhs, x, spm->n, &request );
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "async: unable to start the solve (%d)\n", rc );
+        goto end;
+    }
+
+    rc = pastixRequestWait( &request );
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "async: the solve failed (%d)\n", rc );
+        goto end;
+    }
+    pastix_task_refine( pastix_data, spm->n, nrhs, b, spm->n, x, spm->n );
+
+    if ( check )
+    {
+        rc = spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm, x0, spm->n, b, spm->n, x, spm->n );
+    }
+
+  end:
+    if ( x0 ) {
+        free( x0 );
+    }
+    spmExit( spm );
+    free( spm );
+    free( x );
+    free( b );
+    pastixFinalize( &pastix_data );
+
+    return rc;
+}
+
+/**
+ * @endcode
+ */
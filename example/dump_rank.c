@@ -228,7 +228,7 @@ int main (int argc, char **argv)
 
     pastix_subtask_sopalin( pastix_data );
 
-    core_get_rklimit = core_get_rklimit_test;
+    pastix_data->solvmatr->lowrank.core_rklimit = core_get_rklimit_test;
 
     {
         pastix_int_t total;
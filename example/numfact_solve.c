@@ -0,0 +1,146 @@
+/**
+ * @file numfact_solve.c
+ *
+ * @brief An example that solves the system with the forward solve fused with
+ *        the factorization, and checks the solution against the one of the
+ *        separate factorization and solve.
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ * @ingroup pastix_examples
+ * @code
+ *
+ */
+#include <pastix.h>
+#include <spm.h>
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /*< Pointer to the storage structure required by pastix */
+    pastix_int_t    iparm[IPARM_SIZE];  /*< Integer in/out parameters for pastix                */
+    double          dparm[DPARM_SIZE];  /*< Floating in/out parameters for pastix               */
+    spm_driver_t    driver;
+    char           *filename;
+    spmatrix_t     *spm, spm2;
+    void           *x, *xref, *b, *x0 = NULL;
+    size_t          size;
+    int             check = 1;
+    int             nrhs  = 2;
+    int             rc    = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      &check, &driver, &filename );
+
+    /**
+     * Startup PaStiX
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    /**
+     * Read the sparse matrix with the driver
+     */
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free( filename );
+
+    spmPrintInfo( spm, stdout );
+
+    rc = spmCheckAndCorrect( spm, &spm2 );
+    if ( rc != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    /**
+     * Generate a Fake values array if needed for the numerical part
+     */
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    /**
+     * Perform ordering, symbolic factorization, and analyze steps
+     */
+    pastix_task_analyze( pastix_data, spm );
+
+    /**
+     * Normalize A matrix (optional, but recommended for low-rank functionality)
+     */
+    double normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /**
+     * Generates the b and x vector such that A * x = b
+     * Compute the norms of the initial vectors if checking purpose.
+     */
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x    = malloc( size );
+    xref = malloc( size );
+    b    = malloc( size );
+
+    if ( check > 1 ) {
+        x0 = malloc( size );
+    }
+    spmGenRHS( SpmRhsRndX, nrhs, spm, x0, spm->n, b, spm->n );
+
+    /**
+     * Reference solution: separate factorization and solve
+     */
+    memcpy( xref, b, size );
+    pastix_task_numfact( pastix_data, spm );
+    pastix_task_solve( pastix_data, nrhs, xref, spm->n );
+    pastix_task_refine( pastix_data, spm->n, nrhs, b, spm->n, xref, spm->n );
+
+    /**
+     * Factorization with the fused forward solve, on the same right-hand sides
+     */
+    memcpy( x, b, size );
+    rc = pastix_task_numfact_solve( pastix_data, spm, nrhs, x, spm->n );
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "numfact_solve: the fused factorization and solve failed (%d)\n", rc );
+        goto end;
+    }
+    pastix_task_refine( pastix_data, spm->n, nrhs, b, spm->n, x, spm->n );
+
+    if ( check )
+    {
+        /* Residual of the reference solution */
+        rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm,
+                           x0, spm->n, b, spm->n, xref, spm->n );
+
+        /* Residual of the fused solution, and forward error to the reference one */
+        rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm,
+                           xref, spm->n, b, spm->n, x, spm->n );
+    }
+
+  end:
+    if ( x0 ) {
+        free( x0 );
+    }
+    spmExit( spm );
+    free( spm );
+    free( x );
+    free( xref );
+    free( b );
+    pastixFinalize( &pastix_data );
+
+    return rc;
+}
+
+/**
+ * @endcode
+ */
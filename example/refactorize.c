@@ -0,0 +1,205 @@
+/**
+ * @file refactorize.c
+ *
+ * @brief An example that factorizes a matrix, modifies its values, and
+ *        factorizes it again with the same analysis. With
+ *        IPARM_REUSE_SCATTER_MAP, the second factorization goes through the
+ *        scatter map of the first one, and its solution is checked against
+ *        the one of a factorization without the map.
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ * @ingroup pastix_examples
+ * @code
+ *
+ */
+#include <pastix.h>
+#include <spm.h>
+
+/**
+ * Function: scale_diag
+ *
+ * Scale the diagonal of a CSC matrix with one degree of freedom per vertex.
+ * With alpha > 1, the matrix stays positive definite if it was.
+ */
+static void scale_diag( spmatrix_t *spm, double alpha )
+{
+    spm_int_t j, k;
+    spm_int_t baseval = spm->baseval;
+
+    for (j = 0; j < spm->n; j++) {
+        for (k = spm->colptr[j] - baseval; k < spm->colptr[j+1] - baseval; k++) {
+            if ( (spm->rowptr[k] - baseval) != j ) {
+                continue;
+            }
+            switch( spm->flttype ) {
+            case SpmFloat:
+                ((float *)(spm->values))[k] *= alpha;
+                break;
+            case SpmComplex32:
+                ((spm_complex32_t *)(spm->values))[k] *= alpha;
+                break;
+            case SpmComplex64:
+                ((spm_complex64_t *)(spm->values))[k] *= alpha;
+                break;
+            case SpmDouble:
+            default:
+                ((double *)(spm->values))[k] *= alpha;
+            }
+        }
+    }
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /*< Pointer to the storage structure required by pastix */
+    pastix_int_t    iparm[IPARM_SIZE];  /*< Integer in/out parameters for pastix                */
+    double          dparm[DPARM_SIZE];  /*< Floating in/out parameters for pastix               */
+    spm_driver_t    driver;
+    char           *filename;
+    spmatrix_t     *spm, spm2;
+    void           *x, *xref, *b, *x0 = NULL;
+    size_t          size;
+    int             check = 1;
+    int             nrhs  = 1;
+    int             rc    = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      &check, &driver, &filename );
+
+    /**
+     * Startup PaStiX
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    /**
+     * Read the sparse matrix with the driver
+     */
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free( filename );
+
+    spmPrintInfo( spm, stdout );
+
+    rc = spmCheckAndCorrect( spm, &spm2 );
+    if ( rc != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    if ( spm->dof != 1 ) {
+        fprintf( stderr, "refactorize: only matrices with one degree of freedom are supported\n" );
+        spmExit( spm );
+        free( spm );
+        pastixFinalize( &pastix_data );
+        return EXIT_FAILURE;
+    }
+    spmConvert( SpmCSC, spm );
+
+    /**
+     * Generate a Fake values array if needed for the numerical part
+     */
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    /**
+     * Perform ordering, symbolic factorization, and analyze steps
+     */
+    pastix_task_analyze( pastix_data, spm );
+
+    /**
+     * Normalize A matrix (optional, but recommended for low-rank functionality)
+     */
+    double normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /**
+     * The solutions are checked without refinement, so that wrong factors are
+     * not hidden by the iterative method.
+     */
+    if ( dparm[DPARM_EPSILON_REFINEMENT] < 0. ) {
+        dparm[DPARM_EPSILON_REFINEMENT] =
+            ( (spm->flttype == SpmFloat) || (spm->flttype == SpmComplex32) ) ? 1e-6 : 1e-12;
+    }
+
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x    = malloc( size );
+    xref = malloc( size );
+    b    = malloc( size );
+    if ( check > 1 ) {
+        x0 = malloc( size );
+    }
+
+    /**
+     * First factorization, that computes the scatter map if requested
+     */
+    pastix_task_numfact( pastix_data, spm );
+
+    spmGenRHS( SpmRhsRndX, nrhs, spm, x0, spm->n, b, spm->n );
+    memcpy( x, b, size );
+    pastix_task_solve( pastix_data, nrhs, x, spm->n );
+
+    if ( check ) {
+        rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm, x0, spm->n, b, spm->n, x, spm->n );
+    }
+
+    /**
+     * Modify the values, keep the structure, and factorize again through the
+     * scatter map if requested
+     */
+    scale_diag( spm, 1.5 );
+
+    pastix_task_numfact( pastix_data, spm );
+
+    spmGenRHS( SpmRhsRndX, nrhs, spm, x0, spm->n, b, spm->n );
+    memcpy( x, b, size );
+    pastix_task_solve( pastix_data, nrhs, x, spm->n );
+
+    /**
+     * Reference factorization of the modified values without the scatter map
+     */
+    iparm[IPARM_REUSE_SCATTER_MAP] = 0;
+    pastix_task_numfact( pastix_data, spm );
+
+    memcpy( xref, b, size );
+    pastix_task_solve( pastix_data, nrhs, xref, spm->n );
+
+    if ( check ) {
+        /* Residual of the reference solution */
+        rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm, x0, spm->n, b, spm->n, xref, spm->n );
+
+        /* Residual of the solution with the map, and forward error to the reference one */
+        rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm, xref, spm->n, b, spm->n, x, spm->n );
+    }
+
+    spmExit( spm );
+    free( spm );
+    free( x );
+    free( xref );
+    free( b );
+    if ( x0 ) {
+        free( x0 );
+    }
+    pastixFinalize( &pastix_data );
+
+    return rc;
+}
+
+/**
+ * @endcode
+ */
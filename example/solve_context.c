@@ -0,0 +1,219 @@
+/**
+ * @file solve_context.c
+ *
+ * @brief An example that factorizes the matrix once, and then runs two solves
+ *        concurrently on the same factorization, each within its own solve
+ *        context and with its own right-hand sides.
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ * @ingroup pastix_examples
+ * @code
+ *
+ */
+#include <pthread.h>
+#include <pastix.h>
+#include <spm.h>
+
+/**
+ *  Struct: solve_param
+ *
+ *  Structure containing the right-hand sides solved by each thread.
+ */
+typedef struct solve_param {
+    pastix_solve_context_t *context;
+    spm_rhstype_t           rhstype;
+    pastix_int_t            nrhs;
+    pastix_int_t            ldx;
+    void                   *b;
+    void                   *x;
+    void                   *x0;
+    int                     rc;
+} solve_param_t;
+
+/**
+ * Function: solve_ctx
+ *
+ * Thread routine to solve the system within the context of the thread
+ *
+ * Parameters:
+ *   arg - a pointer to a <solve_param> structure.
+ */
+static void *solve_ctx(void *arg)
+{
+    solve_param_t *param = (solve_param_t *)arg;
+
+    param->rc = pastix_task_solve_context( param->context, param->nrhs,
+                                           param->x, param->ldx );
+    return NULL;
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /*< Pointer to the storage structure required by pastix */
+    pastix_int_t    iparm[IPARM_SIZE];  /*< Integer in/out parameters for pastix                */
+    double          dparm[DPARM_SIZE];  /*< Floating in/out parameters for pastix               */
+    spm_driver_t    driver;
+    char           *filename;
+    spmatrix_t     *spm, spm2;
+    solve_param_t   param[2];
+    pthread_t       threads[2];
+    size_t          size;
+    int             check = 1;
+    int             rc    = 0;
+    int             i;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      &check, &driver, &filename );
+
+    /**
+     * Startup PaStiX
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+#if defined(PASTIX_WITH_MPI)
+    {
+        int size, rank;
+        MPI_Comm_size( MPI_COMM_WORLD, &size );
+        MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+        if( size > 1 ) {
+            if ( rank == 0 ) {
+                fprintf( stderr, "\nWarning: Solve contexts don't work with multiple MPI instances\n" );
+                fprintf( stderr, "Quitting now\n" );
+            }
+            pastixFinalize( &pastix_data );
+            free( filename );
+            exit(0);
+        }
+    }
+#endif
+
+    /**
+     * Read the sparse matrix with the driver
+     */
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free( filename );
+
+    spmPrintInfo( spm, stdout );
+
+    rc = spmCheckAndCorrect( spm, &spm2 );
+    if ( rc != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    /**
+     * Generate a Fake values array if needed for the numerical part
+     */
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    /**
+     * Perform ordering, symbolic factorization, and analyze steps
+     */
+    pastix_task_analyze( pastix_data, spm );
+
+    /**
+     * Normalize A matrix (optional, but recommended for low-rank functionality)
+     */
+    double normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /**
+     * Perform the numerical factorization
+     */
+    pastix_task_numfact( pastix_data, spm );
+
+    /**
+     * Create one context per solving thread, and generate different right-hand
+     * sides for each of them: random solutions for the first one, and
+     * x(i) = i for the second one. The threads of the contexts are not
+     * bound, such that the system can spread the two contexts over the cores.
+     * A disjoint binding of each context can be given instead of NULL.
+     */
+    param[0].rhstype = SpmRhsRndX;
+    param[0].nrhs    = 1;
+    param[1].rhstype = SpmRhsI;
+    param[1].nrhs    = 2;
+
+    rc = 0;
+    for (i = 0; i < 2; i++)
+    {
+        size = pastix_size_of( spm->flttype ) * spm->n * param[i].nrhs;
+        param[i].ldx = spm->n;
+        param[i].x   = malloc( size );
+        param[i].b   = malloc( size );
+        param[i].x0  = ( check > 1 ) ? malloc( size ) : NULL;
+        param[i].rc  = 0;
+        param[i].context = NULL;
+
+        spmGenRHS( param[i].rhstype, param[i].nrhs, spm,
+                   param[i].x0, spm->n, param[i].b, spm->n );
+        memcpy( param[i].x, param[i].b, size );
+
+        rc |= pastixSolveContextInit( pastix_data, -1, NULL, &(param[i].context) );
+    }
+    if ( rc != PASTIX_SUCCESS ) {
+        fprintf( stderr, "solve_context: unable to create the solve contexts\n" );
+        goto end;
+    }
+
+    /**
+     * Solve both systems concurrently on the same factorization
+     */
+    for (i = 0; i < 2; i++) {
+        pthread_create( &threads[i], NULL, solve_ctx, (void *)&param[i] );
+    }
+    for (i = 0; i < 2; i++) {
+        pthread_join( threads[i], NULL );
+        rc |= param[i].rc;
+    }
+
+    /**
+     * Check both solutions
+     */
+    if ( check )
+    {
+        for (i = 0; i < 2; i++) {
+            rc |= spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], param[i].nrhs, spm,
+                               param[i].x0, spm->n, param[i].b, spm->n,
+                               param[i].x,  spm->n );
+        }
+    }
+
+  end:
+    for (i = 0; i < 2; i++)
+    {
+        pastixSolveContextFinalize( &(param[i].context) );
+        free( param[i].x );
+        free( param[i].b );
+        if ( param[i].x0 ) {
+            free( param[i].x0 );
+        }
+    }
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_data );
+
+    return rc;
+}
+
+/**
+ * @endcode
+ */
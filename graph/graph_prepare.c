@@ -111,6 +111,279 @@ graphSort( pastix_graph_t *graph )
     }
 }
 
+/**
+ * @brief Arguments of the multi-threaded preparation of a centralized graph.
+ */
+struct args_graph_prepare_s {
+    pastix_int_t        n;          /**< Number of vertices                                */
+    const pastix_int_t *ia;         /**< Index of the first edge of each vertex            */
+    const pastix_int_t *ja;         /**< Edges of the original graph                       */
+    int                 symmetrize; /**< Add the missing symmetric edges if true           */
+    pastix_int_t       *nbradd;     /**< Number of edges added to each vertex              */
+    pastix_int_t       *edgepart;   /**< Number of edges of the vertex range of each thread */
+    pastix_int_t       *addpart;    /**< Number of edges added by each thread              */
+    pastix_int_t       *newia;      /**< Index of the first edge of the prepared graph     */
+    pastix_int_t       *newja;      /**< Edges of the prepared graph                       */
+};
+
+/**
+ * @brief Return the first vertex of the range of a thread, such that each
+ * range holds the same number of edges.
+ */
+static inline pastix_int_t
+graph_prepare_range( const pastix_int_t *ia,
+                     pastix_int_t        n,
+                     int                 rank,
+                     int                 size )
+{
+    pastix_int_t target, first, last, mid;
+
+    if ( rank >= size ) {
+        return n;
+    }
+    target = ia[0] + (pastix_int_t)( ( (double)( ia[n] - ia[0] ) * rank ) / size );
+
+    /* First vertex i such that ia[i] >= target */
+    first = 0;
+    last  = n;
+    while ( first < last ) {
+        mid = first + ( last - first ) / 2;
+        if ( ia[mid] < target ) {
+            first = mid + 1;
+        }
+        else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Atomically add d to a counter of edges, and return the new value.
+ */
+static inline pastix_int_t
+graph_prepare_atomic_add( pastix_int_t *location,
+                          pastix_int_t  d )
+{
+#if defined(PASTIX_INT64)
+    return (pastix_int_t)pastix_atomic_add_64b( (volatile uint64_t *)location, (uint64_t)d );
+#else
+    return (pastix_int_t)pastix_atomic_add_32b( (volatile int32_t *)location, (int32_t)d );
+#endif
+}
+
+/**
+ * @brief Check if the edge (j, i) exists in the graph.
+ */
+static inline int
+graph_prepare_has_edge( const pastix_int_t *ia,
+                        const pastix_int_t *ja,
+                        pastix_int_t        j,
+                        pastix_int_t        i,
+                        int                 baseval )
+{
+    pastix_int_t k;
+
+    for ( k = ia[j] - baseval; k < ia[j + 1] - baseval; k++ ) {
+        if ( ja[k] == i + baseval ) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Symmetrize, remove the diagonal and sort a vertex range of the graph.
+ *
+ * The edges are streamed once from the original arrays to the final ones:
+ *   1. the missing symmetric edges are counted per vertex,
+ *   2. the new index array is computed with a prefix sum over the ranges,
+ *   3. the off-diagonal edges are copied at the end of each vertex, and the
+ *      missing edges are added in front of them,
+ *   4. the edges of each vertex are sorted.
+ */
+static void
+thread_graph_prepare( isched_thread_t *ctx, void *args )
+{
+    struct args_graph_prepare_s *arg  = (struct args_graph_prepare_s *)args;
+    isched_t                    *isched = ctx->global_ctx;
+    const pastix_int_t          *ia   = arg->ia;
+    const pastix_int_t          *ja   = arg->ja;
+    pastix_int_t                 n    = arg->n;
+    int                          rank = ctx->rank;
+    int                          size = isched->world_size;
+    int                          baseval = ia[0];
+    pastix_int_t                 fcol, lcol, i, j, k, r;
+    pastix_int_t                 offset, nbedges, addnbr;
+
+    fcol = graph_prepare_range( ia, n, rank,     size );
+    lcol = graph_prepare_range( ia, n, rank + 1, size );
+
+    /* Count the missing symmetric edges */
+    if ( arg->symmetrize ) {
+        for ( i = fcol; i < lcol; i++ ) {
+            for ( k = ia[i] - baseval; k < ia[i + 1] - baseval; k++ ) {
+                j = ja[k] - baseval;
+                if ( ( j != i ) && !graph_prepare_has_edge( ia, ja, j, i, baseval ) ) {
+                    graph_prepare_atomic_add( arg->nbradd + j, 1 );
+                }
+            }
+        }
+        isched_barrier_wait( &( isched->barrier ) );
+    }
+
+    /* Store the number of edges of each vertex in newia */
+    nbedges = 0;
+    addnbr  = 0;
+    for ( i = fcol; i < lcol; i++ ) {
+        arg->newia[i] = 0;
+        for ( k = ia[i] - baseval; k < ia[i + 1] - baseval; k++ ) {
+            if ( ( ja[k] - baseval ) != i ) {
+                arg->newia[i]++;
+            }
+        }
+        if ( arg->symmetrize ) {
+            arg->newia[i] += arg->nbradd[i];
+            addnbr        += arg->nbradd[i];
+        }
+        nbedges += arg->newia[i];
+    }
+    arg->edgepart[rank] = nbedges;
+    arg->addpart[rank]  = addnbr;
+    isched_barrier_wait( &( isched->barrier ) );
+
+    /* Prefix sum */
+    offset = baseval;
+    addnbr = 0;
+    for ( r = 0; r < size; r++ ) {
+        if ( r < rank ) {
+            offset += arg->edgepart[r];
+        }
+        addnbr += arg->addpart[r];
+    }
+    for ( i = fcol; i < lcol; i++ ) {
+        nbedges       = arg->newia[i];
+        arg->newia[i] = offset;
+        offset       += nbedges;
+    }
+    if ( rank == size - 1 ) {
+        arg->newia[n] = offset;
+        MALLOC_INTERN( arg->newja, pastix_imax( offset - baseval, 1 ), pastix_int_t );
+    }
+    isched_barrier_wait( &( isched->barrier ) );
+
+    /* Copy the off-diagonal edges, and add the missing ones */
+    for ( i = fcol; i < lcol; i++ ) {
+        pastix_int_t *newja = arg->newja + arg->newia[i + 1] - baseval;
+
+        if ( ( arg->newia[i] == arg->newia[i + 1] ) && ( ia[i] == ia[i + 1] ) && ( addnbr > 0 ) ) {
+            pastix_print_error( "graphSymmetrize: unknown %ld is fully disconnected (even from itself)\n",
+                                (long)i );
+            continue;
+        }
+
+        /* Copy backward to keep the original order of the edges */
+        for ( k = ia[i + 1] - baseval - 1; k >= ia[i] - baseval; k-- ) {
+            if ( ( ja[k] - baseval ) != i ) {
+                newja--;
+                *newja = ja[k];
+            }
+        }
+
+        if ( !arg->symmetrize ) {
+            continue;
+        }
+        for ( k = ia[i] - baseval; k < ia[i + 1] - baseval; k++ ) {
+            j = ja[k] - baseval;
+            if ( ( j != i ) && !graph_prepare_has_edge( ia, ja, j, i, baseval ) ) {
+                r = graph_prepare_atomic_add( arg->nbradd + j, -1 );
+                assert( r >= 0 );
+                arg->newja[ arg->newia[j] - baseval + r ] = i + baseval;
+            }
+        }
+    }
+
+    /*
+     * Sort the edges of each vertex. As in the sequential version, a
+     * symmetric graph without missing edges keeps its original order.
+     */
+    if ( arg->symmetrize && ( addnbr == 0 ) ) {
+        return;
+    }
+    isched_barrier_wait( &( isched->barrier ) );
+
+    for ( i = fcol; i < lcol; i++ ) {
+        assert( !arg->symmetrize || ( arg->nbradd[i] == 0 ) );
+        intSort1asc1( arg->newja + arg->newia[i] - baseval,
+                      arg->newia[i + 1] - arg->newia[i] );
+    }
+}
+
+/**
+ * @brief Multi-threaded preparation of a centralized graph.
+ *
+ * This is equivalent to graphSymmetrize() or to a copy followed by graphSort(),
+ * and then graphNoDiag(), but the edges are copied only once and the work is
+ * distributed over ranges of vertices with the same number of edges. The
+ * generated graph is identical to the sequential one.
+ *
+ * @param[in] isched
+ *          The internal scheduler.
+ *
+ * @param[in] n
+ *          The number of vertices.
+ *
+ * @param[in] ia
+ *          Array of size n+1 of the index of the first edge of each vertex.
+ *
+ * @param[in] ja
+ *          Array of size ia[n]-ia[0] of the edges.
+ *
+ * @param[in] symmetrize
+ *          If true, the missing symmetric edges are added.
+ *
+ * @param[inout] graph
+ *          On exit, holds the prepared graph.
+ */
+static inline void
+graph_prepare_threads( isched_t           *isched,
+                       pastix_int_t        n,
+                       const pastix_int_t *ia,
+                       const pastix_int_t *ja,
+                       int                 symmetrize,
+                       pastix_graph_t     *graph )
+{
+    struct args_graph_prepare_s args;
+
+    args.n          = n;
+    args.ia         = ia;
+    args.ja         = ja;
+    args.symmetrize = symmetrize;
+    args.nbradd     = NULL;
+    args.newja      = NULL;
+
+    if ( symmetrize ) {
+        MALLOC_INTERN( args.nbradd, n, pastix_int_t );
+        memset( args.nbradd, 0, n * sizeof(pastix_int_t) );
+    }
+    MALLOC_INTERN( args.edgepart, isched->world_size, pastix_int_t );
+    MALLOC_INTERN( args.addpart,  isched->world_size, pastix_int_t );
+    MALLOC_INTERN( args.newia,    n+1,                pastix_int_t );
+
+    isched_parallel_call( isched, thread_graph_prepare, &args );
+
+    if ( symmetrize ) {
+        memFree_null( args.nbradd );
+    }
+    memFree_null( args.edgepart );
+    memFree_null( args.addpart );
+
+    graph->n        = n;
+    graph->colptr   = args.newia;
+    graph->rows     = args.newja;
+    graph->loc2glob = NULL;
+}
+
 /**
  *******************************************************************************
  *
@@ -121,6 +394,9 @@ graphSort( pastix_graph_t *graph )
  * This routine will also symmetrize the graph, remove duplicates,
  * remove the diagonal elements, and keep only the lower part.
  *
+ * If the internal scheduler has more than one thread, the centralized graph is
+ * prepared in parallel, and the edges are copied only once.
+ *
  *******************************************************************************
  *
  * @param[inout] pastix_data
@@ -176,42 +452,61 @@ graphPrepare(      pastix_data_t   *pastix_data,
          */
         if (loc2glob == NULL)
         {
+            isched_t *isched    = pastix_data->isched;
+            int       symmetric = (spm->mtxtype == SpmSymmetric) ||
+                                  (spm->mtxtype == SpmHermitian);
+
             tmpgraph->gN = spm->gN;
 
             /*
-             * TODO: change test for requirement from the user to correct his
-             * mistakes
+             * The multi-threaded version fuses the symmetrization or the sort
+             * with the removal of the diagonal
              */
-            if ( (spm->mtxtype == SpmSymmetric) ||
-                 (spm->mtxtype == SpmHermitian) )
+            if ( (isched != NULL) && (isched->world_size > 1) && (n > 0) )
             {
-                if (iparm[IPARM_VERBOSE] > PastixVerboseNo)
-                    pastix_print(procnum, 0, "%s", OUT_ORDER_SYMGRAPH);
+                if (iparm[IPARM_VERBOSE] > PastixVerboseNo) {
+                    pastix_print(procnum, 0, "%s", symmetric ? OUT_ORDER_SYMGRAPH : OUT_ORDER_SORT);
+                    pastix_print(procnum, 0, "%s", OUT_ORDER_NODIAG);
+                }
 
-                graphSymmetrize( n, colptr, rows, loc2glob, tmpgraph );
-                assert( n == tmpgraph->n );
+                graph_prepare_threads( isched, n, colptr, rows, symmetric, tmpgraph );
             }
             else
             {
-                pastix_int_t nnz = colptr[n]-colptr[0];
-                tmpgraph->n = n;
-                MALLOC_INTERN(tmpgraph->colptr, (n+1), pastix_int_t);
-                MALLOC_INTERN(tmpgraph->rows,   nnz,   pastix_int_t);
-                memcpy(tmpgraph->colptr, colptr, (n+1)*sizeof(pastix_int_t));
-                memcpy(tmpgraph->rows,   rows,     nnz*sizeof(pastix_int_t));
+                /*
+                 * TODO: change test for requirement from the user to correct his
+                 * mistakes
+                 */
+                if ( symmetric )
+                {
+                    if (iparm[IPARM_VERBOSE] > PastixVerboseNo)
+                        pastix_print(procnum, 0, "%s", OUT_ORDER_SYMGRAPH);
 
-                if (iparm[IPARM_VERBOSE] > PastixVerboseNo) {
-                    pastix_print(procnum, 0, "%s", OUT_ORDER_SORT);
+                    graphSymmetrize( n, colptr, rows, loc2glob, tmpgraph );
+                    assert( n == tmpgraph->n );
                 }
-                graphSort( tmpgraph );
-            }
-
-            {
-                if (iparm[IPARM_VERBOSE] > PastixVerboseNo) {
-                    pastix_print(procnum, 0, "%s", OUT_ORDER_NODIAG);
+                else
+                {
+                    pastix_int_t nnz = colptr[n]-colptr[0];
+                    tmpgraph->n = n;
+                    MALLOC_INTERN(tmpgraph->colptr, (n+1), pastix_int_t);
+                    MALLOC_INTERN(tmpgraph->rows,   nnz,   pastix_int_t);
+                    memcpy(tmpgraph->colptr, colptr, (n+1)*sizeof(pastix_int_t));
+                    memcpy(tmpgraph->rows,   rows,     nnz*sizeof(pastix_int_t));
+
+                    if (iparm[IPARM_VERBOSE] > PastixVerboseNo) {
+                        pastix_print(procnum, 0, "%s", OUT_ORDER_SORT);
+                    }
+                    graphSort( tmpgraph );
                 }
 
-                graphNoDiag( tmpgraph );
+                {
+                    if (iparm[IPARM_VERBOSE] > PastixVerboseNo) {
+                        pastix_print(procnum, 0, "%s", OUT_ORDER_NODIAG);
+                    }
+
+                    graphNoDiag( tmpgraph );
+                }
             }
         }
 #if defined(PASTIX_DISTRIBUTED) && 0
@@ -91,6 +91,11 @@ int pastix_task_solve  ( pastix_data_t      *pastix_data,
                          pastix_int_t        nrhs,
                          void               *b,
                          pastix_int_t        ldb );
+int pastix_task_numfact_solve( pastix_data_t *pastix_data,
+                               spmatrix_t    *spm,
+                               pastix_int_t   nrhs,
+                               void          *b,
+                               pastix_int_t   ldb );
 int pastix_task_refine( pastix_data_t *pastix_data,
                         pastix_int_t n, pastix_int_t nrhs,
                         void *b, pastix_int_t ldb,
@@ -146,6 +151,37 @@ int pastix_subtask_refine( pastix_data_t *pastix_data,
                            pastix_int_t n, pastix_int_t nrhs,
                            const void *b, pastix_int_t ldb,
                                  void *x, pastix_int_t ldx );
+
+/*
+ * Asynchronous factorization and solve
+ *
+ * The tasks are executed by a helper pthread that issues the MPI calls, so MPI
+ * must be initialized with MPI_THREAD_MULTIPLE. The asynchronous routines
+ * return PASTIX_ERR_MPI with a lower thread level.
+ */
+int pastix_task_numfact_async( pastix_data_t     *pastix_data,
+                               spmatrix_t        *spm,
+                               pastix_request_t **request );
+int pastix_task_solve_async  ( pastix_data_t     *pastix_data,
+                               pastix_int_t       nrhs,
+                               void              *b,
+                               pastix_int_t       ldb,
+                               pastix_request_t **request );
+int pastixRequestTest( const pastix_request_t  *request );
+int pastixRequestWait( pastix_request_t       **request );
+
+/*
+ * Concurrent solves on a factorized problem
+ */
+int  pastixSolveContextInit    ( pastix_data_t           *pastix_data,
+                                 int                      thrdnbr,
+                                 const int               *bindtab,
+                                 pastix_solve_context_t **context );
+void pastixSolveContextFinalize( pastix_solve_context_t **context );
+int  pastix_task_solve_context ( pastix_solve_context_t  *context,
+                                 pastix_int_t             nrhs,
+                                 void                    *b,
+                                 pastix_int_t             ldb );
 /*
  * Schur complement manipulation routines.
  */
@@ -92,11 +92,16 @@ typedef enum pastix_iparm_e {
     IPARM_FACTORIZATION,         /**< Factorization mode                                             Default: PastixFactLU              IN  */
     IPARM_STATIC_PIVOTING,       /**< Static pivoting                                                Default: -                         OUT */
     IPARM_FREE_CSCUSER,          /**< Free user CSC                                                  Default: 0                         IN  */
+    IPARM_REUSE_SCATTER_MAP,     /**< Reuse the scatter map of the values when only the values change Default: 0                         IN  */
+    IPARM_MIXED,                 /**< Factorize in single precision and refine in double precision   Default: 0                         IN  */
+    IPARM_UPDATE_LOCK_CBLK,      /**< Lock the facing cblk instead of the facing blocks of an update Default: 0                         IN  */
+    IPARM_UPDATE_MODE,           /**< Mode of the 1D updates (@see pastix_update_mode_t)             Default: PastixUpdateModeAuto      IN  */
     IPARM_SCHUR_FACT_MODE,       /**< Specify if the Schur is factorized (@see pastix_fact_mode_t)   Default: PastixFactModeLocal       IN  */
 
     /* Solve */
     IPARM_SCHUR_SOLV_MODE,       /**< Specify the solve parts to apply (@see pastix_solv_mode_t)     Default: PastixSolvModeLocal       IN  */
     IPARM_APPLYPERM_WS,          /**< Enable/disable extra workspace for a thread-safe swap          Default: 1                         IN  */
+    IPARM_SOLVE_LOWPREC,         /**< Solve with a single precision copy of the factors              Default: 0                         IN  */
 
     /* Refinement */
     IPARM_REFINEMENT,            /**< Refinement mode                                                Default: PastixRefineGMRES         IN  */
@@ -108,6 +113,9 @@ typedef enum pastix_iparm_e {
     IPARM_SCHEDULER,             /**< Scheduler mode                                                 Default: PastixSchedStatic         IN  */
     IPARM_THREAD_NBR,            /**< Number of threads per process (-1 for auto detect)             Default: -1                        IN  */
     IPARM_AUTOSPLIT_COMM,        /**< Automaticaly split communicator to have one MPI task by node   Default: 0                         IN  */
+    IPARM_DYNAMIC_QUEUE,         /**< Ready task structure of the dynamic scheduler                  Default: PastixDynQueueHeap        IN  */
+    IPARM_DYNAMIC_TEAM,          /**< Share the updates of the tail cblks with the idle threads      Default: 1                         IN  */
+    IPARM_NUMA_INIT,             /**< Allocate and first-touch the coefficients on the owner's node  Default: 0                         IN  */
 
     /* GPU */
     IPARM_GPU_NBR,               /**< Number of GPU devices                                          Default: 0                         IN  */
@@ -122,6 +130,9 @@ typedef enum pastix_iparm_e {
     IPARM_COMPRESS_ORTHO,        /**< Orthogonalization method                                       Default: PastixCompressOrthoCGS    IN  */
     IPARM_COMPRESS_RELTOL,       /**< Enable/Disable relative tolerance                              Default: 0                         IN  */
     IPARM_COMPRESS_PRESELECT,    /**< Enable/Disable compression of preselected blocks               Default: -1 (automatic)            IN  */
+    IPARM_COMPRESS_LOWPREC,      /**< Store the low-rank bases in single precision                   Default: 0                         IN  */
+    IPARM_COMPRESS_POLICY,       /**< Per-block compression policy driven by the cost models         Default: 0                         IN  */
+    IPARM_COMPRESS_SKETCH,       /**< Test the compressibility with a random sketch before QRCP      Default: 0                         IN  */
 
     /* MPI modes */
     IPARM_THREAD_COMM_MODE,      /**< Threaded communication mode                                    Default: PastixThreadMultiple      IN  */
@@ -162,6 +173,7 @@ typedef enum pastix_dparm_e {
     DPARM_A_NORM,                /**< ||A||_f norm                                      Default: -                OUT */
     DPARM_COMPRESS_TOLERANCE,    /**< Tolerance for low-rank kernels                    Default: 0.01             IN  */
     DPARM_COMPRESS_MIN_RATIO,    /**< Min ratio for rank w.r.t. strict rank             Default: 1.0              IN  */
+    DPARM_SUBTREE_COST,          /**< Max predicted cost of a leaf subtree task (dyn.)  Default: 5e-5             IN  */
     DPARM_SIZE
 } pastix_dparm_t;
 
@@ -300,6 +312,23 @@ typedef enum pastix_scheduler_e {
     PastixSchedDynamic    = 4, /**< Shared memory with dynamic scheduler */
 } pastix_scheduler_t;
 
+/**
+ * @brief Ready task structure of the dynamic scheduler
+ */
+typedef enum pastix_dynqueue_e {
+    PastixDynQueueHeap  = 0, /**< Per-thread priority heaps protected by a lock */
+    PastixDynQueueDeque = 1  /**< Per-thread lock-free work-stealing deques    */
+} pastix_dynqueue_t;
+
+/**
+ * @brief Mode of application of the updates between two 1D cblks
+ */
+typedef enum pastix_update_mode_e {
+    PastixUpdateModeAuto     = 0, /**< Selected per update from its contiguous runs of rows */
+    PastixUpdateModeFused    = 1, /**< One GEMM per contiguous run of rows in the facing cblk */
+    PastixUpdateModeBuffered = 2  /**< One GEMM in the work buffer followed by the scatter   */
+} pastix_update_mode_t;
+
 /**
  * @brief Ordering strategy
  */
@@ -139,6 +139,14 @@ typedef spmatrix_t pastix_spm_t;
 struct pastix_data_s;
 typedef struct pastix_data_s pastix_data_t;
 
+/* Context of the concurrent solves on a factorized problem */
+struct pastix_solve_context_s;
+typedef struct pastix_solve_context_s pastix_solve_context_t;
+
+/* Handle of the asynchronous factorization and solve */
+struct pastix_request_s;
+typedef struct pastix_request_s pastix_request_t;
+
 /* Graph structure (No values) */
 struct pastix_graph_s;
 typedef struct pastix_graph_s pastix_graph_t;
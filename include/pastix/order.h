@@ -130,6 +130,10 @@ int  pastixOrderAddIsolate( pastix_order_t     *ordeptr,
 void orderDraw( pastix_data_t *pastix_data,
                 pastix_int_t   min_cblk );
 
+int  orderAmalgamate( pastix_data_t  *pastix_data,
+                      pastix_graph_t *graph,
+                      pastix_order_t *orderptr );
+
 pastix_int_t
 orderSupernodes( const pastix_graph_t *graph,
                  pastix_order_t       *order,
@@ -23,6 +23,7 @@
 #include "kernels_trace.h"
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+static pastix_complex64_t mzone = -1.0;
 static pastix_complex64_t zone  =  1.0;
 static pastix_complex64_t zzero =  0.0;
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -158,7 +159,7 @@ core_zlrfree( pastix_lrblock_t *A )
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to core_get_rklimit(M, N)
+ *          -1, set to min(M, N)
  *
  *******************************************************************************
  *
@@ -173,7 +174,7 @@ core_zlrsze( int copy, pastix_int_t M, pastix_int_t N,
              pastix_int_t rklimit )
 {
     /* If no limit on the rank is given, let's take min(M, N) */
-    rklimit = (rklimit == -1) ? core_get_rklimit( M, N ) : rklimit;
+    rklimit = (rklimit == -1) ? pastix_imin( M, N ) : rklimit;
 
     /* If no extra memory allocated, let's fix rkmax to rk */
     newrkmax = (newrkmax == -1) ? newrk : newrkmax;
@@ -470,7 +471,8 @@ core_zlrcpy( const pastix_lr_t *lowrank,
 
         core_zlr2ge( PastixNoTrans, M2, N2, B, work, M2 );
 
-        lowrank->core_ge2lr( lowrank->use_reltol, lowrank->tolerance, -1, M2, N2, work, M2, B );
+        lowrank->core_ge2lr( lowrank, lowrank->use_reltol, lowrank->tolerance,
+                             core_get_rklimit( lowrank, M2, N2 ), M2, N2, work, M2, B );
 
         free(work);
     }
@@ -700,6 +702,153 @@ core_zlrconcatenate_v( pastix_trans_t transA1, pastix_complex64_t alpha,
     (void) alpha;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Estimate the rank of a matrix with a random sketch.
+ *
+ * An orthonormal basis Q of the range of A is built by blocks of 8 samples
+ * A w, with w gaussian vectors, as in the adaptive range finder of: Finding
+ * Structure with Randomness: Probabilistic Algorithms for Constructing
+ * Approximate Matrix Decompositions. N. Halko, P. G. Martinsson, and
+ * J. A. Tropp.
+ *
+ * Each new block of samples, projected on the orthogonal of Q, gives an
+ * estimate of the frobenius norm of the residual A - Q Q^h A, since
+ * E(||(I - Q Q^h) A w||^2) is proportional to ||(I - Q Q^h) A||_F^2. The
+ * process stops when this norm test is below the tolerance, and the size of
+ * the basis is the estimated rank, or when the basis exceeds rklimit by the
+ * oversampling of 5 vectors, and the matrix is declared incompressible.
+ *
+ * The sketch only uses matrix-matrix products on A, and its products with A
+ * cost at most 2 m n (rklimit + 20) flops, to be compared to the partial QR
+ * with column pivoting up to rklimit that fails on incompressible matrices.
+ *
+ *******************************************************************************
+ *
+ * @param[in] tol
+ *          The absolute tolerance on the frobenius norm of the residual.
+ *          tol >= 0.
+ *
+ * @param[in] rklimit
+ *          The maximum rank to store the matrix in low-rank format.
+ *
+ * @param[in] m
+ *          Number of rows of the matrix A.
+ *
+ * @param[in] n
+ *          Number of columns of the matrix A.
+ *
+ * @param[in] A
+ *          The matrix of dimension lda-by-n to test.
+ *
+ * @param[in] lda
+ *          The leading dimension of the matrix A. lda >= max(1, m)
+ *
+ * @param[out] flops
+ *          On exit, the number of flops of the sketch.
+ *
+ *******************************************************************************
+ *
+ * @return The estimated rank of A, -1 if A is not compressible within rklimit,
+ *         or -2 if rklimit is too close to min(m, n) for the sketch to pay off,
+ *         in which case nothing is computed.
+ *
+ *******************************************************************************/
+int
+core_zlrsketch( double tol, pastix_int_t rklimit,
+                pastix_int_t m, pastix_int_t n,
+                const pastix_complex64_t *A, pastix_int_t lda,
+                pastix_fixdbl_t *flops )
+{
+    int                 SEED[4] = {26, 67, 52, 197};
+    pastix_int_t        bs    = 8;
+    pastix_int_t        p     = 5;
+    pastix_int_t        kmax  = ( (rklimit + p + bs - 1) / bs + 1 ) * bs;
+    pastix_int_t        lwork = bs * bs;
+    pastix_int_t        k;
+    pastix_complex64_t *zwork, *Q, *Y, *omega, *W, *tau, *work;
+    double              norm, var;
+    int                 ret;
+
+    *flops = 0.;
+    if ( kmax > pastix_imin( m, n ) ) {
+        return -2;
+    }
+
+#if defined(PRECISION_c) || defined(PRECISION_z)
+    /* The real and imaginary parts of the gaussian vectors are independent */
+    var = 2.;
+#else
+    var = 1.;
+#endif
+
+    zwork = malloc( (m * kmax + n * bs + kmax * bs + bs + lwork) * sizeof(pastix_complex64_t) );
+    Q     = zwork;
+    omega = Q + m * kmax;
+    W     = omega + n * bs;
+    tau   = W + kmax * bs;
+    work  = tau + bs;
+
+    k = 0;
+    while ( 1 ) {
+        Y = Q + k * m;
+
+        /* Sample a new block: Y = A * Omega */
+        LAPACKE_zlarnv_work( 3, SEED, n * bs, omega );
+        cblas_zgemm( CblasColMajor, CblasNoTrans, CblasNoTrans,
+                     m, bs, n,
+                     CBLAS_SADDR(zone),  A,     lda,
+                                         omega, n,
+                     CBLAS_SADDR(zzero), Y,     m );
+        *flops += FLOPS_ZGEMM( m, bs, n );
+
+        /* Project it on the orthogonal of Q, twice for stability */
+        if ( k > 0 ) {
+            int i;
+            for ( i = 0; i < 2; i++ ) {
+                cblas_zgemm( CblasColMajor, CblasConjTrans, CblasNoTrans,
+                             k, bs, m,
+                             CBLAS_SADDR(zone),  Q, m,
+                                                 Y, m,
+                             CBLAS_SADDR(zzero), W, k );
+                cblas_zgemm( CblasColMajor, CblasNoTrans, CblasNoTrans,
+                             m, bs, k,
+                             CBLAS_SADDR(mzone), Q, m,
+                                                 W, k,
+                             CBLAS_SADDR(zone),  Y, m );
+            }
+            *flops += 2. * ( FLOPS_ZGEMM( k, bs, m ) + FLOPS_ZGEMM( m, bs, k ) );
+        }
+
+        /* Norm test on the residual estimated by the projected samples */
+        norm = LAPACKE_zlange_work( LAPACK_COL_MAJOR, 'f', m, bs,
+                                    Y, m, NULL );
+        if ( (norm * norm) <= (tol * tol * var * (double)bs) ) {
+            break;
+        }
+        if ( k >= (rklimit + p) ) {
+            k = -1;
+            break;
+        }
+
+        /* Extend the basis */
+        ret = LAPACKE_zgeqrf_work( LAPACK_COL_MAJOR, m, bs,
+                                   Y, m, tau, work, lwork );
+        assert( ret == 0 );
+        ret = LAPACKE_zungqr_work( LAPACK_COL_MAJOR, m, bs, bs,
+                                   Y, m, tau, work, lwork );
+        assert( ret == 0 );
+        *flops += FLOPS_ZGEQRF( m, bs ) + FLOPS_ZUNGQR( m, bs, bs );
+
+        k += bs;
+    }
+
+    free( zwork );
+    (void)ret;
+    return k;
+}
+
 /**
  *******************************************************************************
  *
@@ -716,13 +865,16 @@ core_zlrconcatenate_v( pastix_trans_t transA1, pastix_complex64_t alpha,
  *          QR decomposition function used to compute the rank revealing
  *          factorization and create the low-rank form of A.
  *
+ * @param[in] lowrank
+ *          The structure with low-rank parameters.
+ *
  * @param[in] tol
  *          The tolerance used as a criterion to eliminate information from the
  *          full rank matrix
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to min(m, n) / PASTIX_LR_MINRATIO.
+ *          -1, set to min(m, n).
  *
  * @param[in] m
  *          Number of rows of the matrix A, and of the low rank matrix Alr.
@@ -743,7 +895,7 @@ core_zlrconcatenate_v( pastix_trans_t transA1, pastix_complex64_t alpha,
  *******************************************************************************/
 pastix_fixdbl_t
 core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
-                  int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+                  const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                   pastix_int_t m, pastix_int_t n,
                   const void *Avoid, pastix_int_t lda,
                   pastix_lrblock_t *Alr )
@@ -758,7 +910,7 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
     pastix_int_t       *jpvt;
     pastix_int_t        zsize, rsize;
     pastix_complex64_t *zwork;
-    pastix_fixdbl_t     flops;
+    pastix_fixdbl_t     flops = 0.;
 
     double norm = LAPACKE_zlange_work( LAPACK_COL_MAJOR, 'f', m, n,
                                        A, lda, NULL );
@@ -769,7 +921,7 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
     }
 
     /* work */
-    rklimit = ( rklimit < 0 ) ? core_get_rklimit( m, n ) : rklimit;
+    rklimit = ( rklimit < 0 ) ? pastix_imin( m, n ) : rklimit;
     if ( tol < 0. ) {
         tol = -1.;
     }
@@ -777,6 +929,33 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
         tol = tol * norm;
     }
 
+    /**
+     * Test the compressibility of A with a random sketch, to skip the
+     * rank-revealing QR of the incompressible blocks, and to size the sample
+     * of the randomized methods from the estimated rank
+     */
+    if ( lowrank->use_sketch && (tol >= 0.) ) {
+        int rkest = core_zlrsketch( tol, rklimit, m, n, A, lda, &flops );
+
+        if ( rkest == -1 ) {
+            kernel_trace_sketch( 1, flops, FLOPS_ZGEQRF( m, rklimit ) +
+                                 FLOPS_ZUNMQR( m, n-rklimit, rklimit, PastixLeft ) );
+
+            core_zlralloc( m, n, -1, Alr );
+            ret = LAPACKE_zlacpy_work( LAPACK_COL_MAJOR, 'A', m, n,
+                                       A, lda, Alr->u, Alr->rkmax );
+            assert(ret == 0);
+            return flops;
+        }
+        if ( rkest >= 0 ) {
+            kernel_trace_sketch( 0, flops, 0. );
+
+            if ( (rrqrfct == core_zrqrcp) || (rrqrfct == core_ztqrcp) ) {
+                nb = pastix_imax( nb, rkest + 5 );
+            }
+        }
+    }
+
     ret = rrqrfct( tol, rklimit, 0, nb,
                    m, n, NULL, m,
                    NULL, NULL,
@@ -819,10 +998,10 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
                      jpvt, tau,
                      work, lwork, rwork );
     if (newrk == -1) {
-        flops = FLOPS_ZGEQRF( m, n );
+        flops += FLOPS_ZGEQRF( m, n );
     }
     else {
-        flops = FLOPS_ZGEQRF( m, newrk ) + FLOPS_ZUNMQR( m, n-newrk, newrk, PastixLeft );
+        flops += FLOPS_ZGEQRF( m, newrk ) + FLOPS_ZUNMQR( m, n-newrk, newrk, PastixLeft );
     }
 
     /**
@@ -904,13 +1083,16 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
  *          QR decomposition function used to compute the rank revealing
  *          factorization and create the low-rank form of A.
  *
+ * @param[in] lowrank
+ *          The structure with low-rank parameters.
+ *
  * @param[in] tol
  *          The tolerance used as a criterion to eliminate information from the
  *          full rank matrix
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to min(m, n) / PASTIX_LR_MINRATIO.
+ *          -1, set to min(m, n).
  *
  * @param[in] m
  *          Number of rows of the matrix A, and of the low rank matrix Alr.
@@ -931,7 +1113,7 @@ core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
  *******************************************************************************/
 pastix_fixdbl_t
 core_zge2lr_qrrt( core_zrrqr_rt_t rrqrfct,
-                  int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+                  const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                   pastix_int_t m, pastix_int_t n,
                   const void *Avoid, pastix_int_t lda,
                   pastix_lrblock_t *Alr )
@@ -954,6 +1136,9 @@ core_zge2lr_qrrt( core_zrrqr_rt_t rrqrfct,
     trans = 'T';
 #endif
 
+    /* The low-rank parameters are only used by the QRCP methods */
+    (void)lowrank;
+
     double norm = LAPACKE_zlange_work( LAPACK_COL_MAJOR, 'f', m, n,
                                        A, lda, NULL );
 
@@ -963,7 +1148,7 @@ core_zge2lr_qrrt( core_zrrqr_rt_t rrqrfct,
     }
 
     /* work */
-    rklimit = ( rklimit < 0 ) ? core_get_rklimit( m, n ) : rklimit;
+    rklimit = ( rklimit < 0 ) ? pastix_imin( m, n ) : rklimit;
     if ( tol < 0. ) {
         tol = -1.;
     }
@@ -1264,7 +1449,7 @@ core_zrradd_qr( core_zrrqr_cp_t rrqrfct,
     wzsize += minV;
 
     /* RRQR workspaces */
-    rklimit = pastix_imin( rank, core_get_rklimit( M, N ) );
+    rklimit = pastix_imin( rank, core_get_rklimit( lowrank, M, N ) );
     rrqrfct( tol, rklimit, 1, nb,
              rank, N, NULL, ldv,
              NULL, NULL,
@@ -1322,7 +1507,7 @@ core_zrradd_qr( core_zrrqr_cp_t rrqrfct,
     if (rankA != 0) {
 
         kernel_trace_start_lvl2( PastixKernelLvl2_LR_add2C_rradd_orthogonalize );
-        switch ( pastix_lr_ortho ) {
+        switch ( lowrank->compress_ortho ) {
         case PastixCompressOrthoQR:
             flops = core_zlrorthu_fullqr( M, N, B->rk + rankA,
                                           u1u2, ldu, v1v2, ldv );
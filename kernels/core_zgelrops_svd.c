@@ -81,6 +81,9 @@ static pastix_complex64_t zzero =  0.0;
  *
  *******************************************************************************
  *
+ * @param[in] lowrank
+ *          The structure with low-rank parameters.
+ *
  * @param[in] tol
  *          The tolerance used as a criterion to eliminate information from the
  *          full rank matrix.
@@ -90,7 +93,7 @@ static pastix_complex64_t zzero =  0.0;
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to min(M, N) / PASTIX_LR_MINRATIO.
+ *          -1, set to min(M, N).
  *
  * @param[in] m
  *          Number of rows of the matrix A, and of the low rank matrix Alr.
@@ -110,7 +113,7 @@ static pastix_complex64_t zzero =  0.0;
  *
  *******************************************************************************/
 pastix_fixdbl_t
-core_zge2lr_svd( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+core_zge2lr_svd( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                  pastix_int_t m, pastix_int_t n,
                  const void *Avoid, pastix_int_t lda,
                  pastix_lrblock_t *Alr )
@@ -125,6 +128,9 @@ core_zge2lr_svd( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
     pastix_int_t        zsize, rsize;
     double              norm;
 
+    /* The low-rank parameters are only used by the QRCP methods */
+    (void)lowrank;
+
 #if !defined(NDEBUG)
     if ( m < 0 ) {
         return -2;
@@ -146,7 +152,7 @@ core_zge2lr_svd( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
         return 0. ;
     }
 
-    rklimit = ( rklimit < 0 ) ? core_get_rklimit( m, n ) : rklimit;
+    rklimit = ( rklimit < 0 ) ? pastix_imin( m, n ) : rklimit;
     if ( tol < 0. ) {
         tol = -1.;
     }
@@ -573,7 +579,7 @@ core_zrradd_svd( const pastix_lr_t *lowrank, pastix_trans_t transA1, const void
     /*
      * First case: The rank is too big, so we decide to uncompress the result
      */
-    if ( new_rank > core_get_rklimit( M, N ) ) {
+    if ( new_rank > core_get_rklimit( lowrank, M, N ) ) {
         pastix_lrblock_t Bbackup = *B;
 
         core_zlralloc( M, N, -1, B );
@@ -28,6 +28,163 @@ static pastix_complex64_t zone  =  1.0;
 static pastix_complex64_t zzero =  0.0;
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
 
+/**
+ * @brief Minimal inner dimension of an update computed in the private buffer
+ * of the thread before its accumulation, instead of directly under the lock.
+ */
+#define PASTIX_GEMMSP_PRIVATE_KMIN 32
+
+/**
+ * @brief Check if the update of a block by a M-by-K times K-by-N product is
+ * large enough, and fits in the work buffer, to be computed outside of the
+ * lock of the facing block.
+ */
+static inline int
+core_zgemmsp_private( pastix_int_t        M,
+                      pastix_int_t        N,
+                      pastix_int_t        K,
+                      pastix_complex64_t *work,
+                      pastix_int_t        lwork )
+{
+    return ( (work != NULL) &&
+             (K >= PASTIX_GEMMSP_PRIVATE_KMIN) &&
+             ((M * N) <= lwork) );
+}
+
+/**
+ * @brief Minimal average height of the contiguous runs of rows of an update to
+ * compute it directly in the facing cblk with one GEMM per run, instead of
+ * computing it in the work buffer before scattering it.
+ */
+#define PASTIX_GEMMSP_FUSED_MMIN 32
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/**
+ * @brief The modes of application of an update between two 1D cblks.
+ */
+typedef enum pastix_gemmsp_mode_e {
+    PastixGemmspDirect,   /**< One single GEMM directly in the facing cblk           */
+    PastixGemmspFused,    /**< One GEMM per contiguous run of rows in the facing cblk */
+    PastixGemmspBuffered, /**< One GEMM in the work buffer followed by the scatter   */
+    PastixGemmspSmall     /**< One small GEMM kernel per contiguous run of rows       */
+} pastix_gemmsp_mode_t;
+#endif /* DOXYGEN_SHOULD_SKIP_THIS */
+
+/**
+ * @brief Select the mode of application of a M-by-N update between two 1D
+ * cblks, whose rows are split in nbruns contiguous runs in the facing
+ * cblk.
+ *
+ * The mode can be forced with IPARM_UPDATE_MODE. The buffered mode then
+ * falls back to the fused one if the update does not fit in the work buffer,
+ * and the fused mode of a single run is the direct one.
+ */
+static inline pastix_gemmsp_mode_t
+core_zgemmsp_1d1d_mode( pastix_int_t        M,
+                        pastix_int_t        N,
+                        pastix_int_t        nbruns,
+                        pastix_complex64_t *work,
+                        pastix_int_t        lwork )
+{
+    int fits = (work != NULL) && ((M * N) <= lwork);
+
+    if ( kernels_update_mode == PastixUpdateModeBuffered ) {
+        return fits ? PastixGemmspBuffered : PastixGemmspFused;
+    }
+    if ( nbruns == 1 ) {
+        return PastixGemmspDirect;
+    }
+    if ( !fits || (kernels_update_mode == PastixUpdateModeFused) ) {
+        return PastixGemmspFused;
+    }
+    if ( (M / nbruns) >= PASTIX_GEMMSP_FUSED_MMIN ) {
+        return PastixGemmspFused;
+    }
+    return PastixGemmspBuffered;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Compute the small matrix-matrix product C = C - A * op(B).
+ *
+ * This kernel is used for the updates of the cblks for which the performance
+ * models predict that the call overhead of the BLAS kernel dominates (See
+ * SolverCblk::gemmsmall). The loops are ordered to vectorize the innermost one
+ * on the contiguous rows of A and C.
+ *
+ *******************************************************************************
+ *
+ * @param[in] trans
+ *          Specify the transposition used for the B matrix. It has to be either
+ *          PastixTrans or PastixConjTrans.
+ *
+ * @param[in] M
+ *          The number of rows of the matrices A and C.
+ *
+ * @param[in] N
+ *          The number of columns of the matrix C, and of rows of the matrix B.
+ *
+ * @param[in] K
+ *          The number of columns of the matrices A and B.
+ *
+ * @param[in] A
+ *          The matrix A of size lda -by- K.
+ *
+ * @param[in] lda
+ *          The leading dimension of the matrix A.
+ *
+ * @param[in] B
+ *          The matrix B of size ldb -by- K.
+ *
+ * @param[in] ldb
+ *          The leading dimension of the matrix B.
+ *
+ * @param[inout] C
+ *          The matrix C of size ldc -by- N.
+ *
+ * @param[in] ldc
+ *          The leading dimension of the matrix C.
+ *
+ *******************************************************************************/
+static inline void
+core_zgemmsp_small( pastix_trans_t            trans,
+                    pastix_int_t              M,
+                    pastix_int_t              N,
+                    pastix_int_t              K,
+                    const pastix_complex64_t *A,
+                    pastix_int_t              lda,
+                    const pastix_complex64_t *B,
+                    pastix_int_t              ldb,
+                    pastix_complex64_t       *C,
+                    pastix_int_t              ldc )
+{
+    const pastix_complex64_t *Ak;
+    pastix_complex64_t *Cj;
+    pastix_complex64_t  bkj;
+    pastix_int_t i, j, k;
+
+#if !defined(PRECISION_z) && !defined(PRECISION_c)
+    (void)trans;
+#endif
+
+    for( j=0; j<N; j++ ) {
+        Cj = C + j * ldc;
+        for( k=0; k<K; k++ ) {
+            bkj = B[ j + k * ldb ];
+#if defined(PRECISION_z) || defined(PRECISION_c)
+            if ( trans == PastixConjTrans ) {
+                bkj = conj( bkj );
+            }
+#endif
+            Ak = A + k * lda;
+            for( i=0; i<M; i++ ) {
+                Cj[i] -= Ak[i] * bkj;
+            }
+        }
+    }
+}
+
 /**
  *******************************************************************************
  *
@@ -40,7 +197,11 @@ static pastix_complex64_t zzero =  0.0;
  * Major Layout with blocks interleaved.
  *
  * All the off-diagonal block below block are multiplied by the selected block
- * and added to the facing cblk.
+ * and added to the facing cblk. If the rows of the update are contiguous in the
+ * facing cblk, the product is directly accumulated in C. If they are split in
+ * runs large enough, or if the work buffer is too small, each run is computed
+ * by its own GEMM directly in C. Otherwise, the product is computed in the work
+ * buffer and scattered to C.
  *
  *******************************************************************************
  *
@@ -88,9 +249,13 @@ static pastix_complex64_t zzero =  0.0;
  *          fcblk.ucoeftab otherwise.
  *
  * @param[in] work
- *          Temporary memory buffer that is at least equal to the height of the
- *          block B by the sum of the height of all the blocks below the block
- *          B.
+ *          Temporary memory buffer of the calling thread. It is used only when
+ *          the rows of the update are split in many small runs in the facing
+ *          cblk. The update is then computed in the buffer before being added
+ *          block by block to C. Can be NULL.
+ *
+ * @param[in] lwork
+ *          The size of the work buffer.
  *
  *******************************************************************************
  *
@@ -106,24 +271,26 @@ core_zgemmsp_1d1d( pastix_coefside_t sideA, pastix_trans_t trans,
                    const pastix_complex64_t *A,
                    const pastix_complex64_t *B,
                          pastix_complex64_t *C,
-                         pastix_complex64_t *work )
+                         pastix_complex64_t *work,
+                         pastix_int_t        lwork )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
+    const SolverBlok *runblok;
+          SolverBlok *runfblok;
 
     pastix_complex64_t *tmpC;
     pastix_complex64_t *wtmp;
     pastix_int_t stride, stridef, indblok;
-    pastix_int_t M, N, K, m;
+    pastix_int_t M, N, K, m, nbruns;
+    pastix_gemmsp_mode_t mode;
     int shift;
 
     /* Both cblk and fcblk are stored in 1D */
     assert(!(cblk->cblktype  & CBLK_LAYOUT_2D));
     assert(!(fcblk->cblktype & CBLK_LAYOUT_2D));
 
-    assert( work != NULL );
-
     shift = (sideA == PastixUCoef) ? 1 : 0;
 
     stride  = cblk->stride;
@@ -140,51 +307,117 @@ core_zgemmsp_1d1d( pastix_coefside_t sideA, pastix_trans_t trans,
     A = A + indblok + (shift * N);
     B = B + indblok;
 
+    /* Move the pointer to the top of the right column */
+    C = C + (blok->frownum - fcblk->fcolnum) * stridef;
+
+    lblok = cblk[1].fblokptr;
+
     /*
-     * Compute update A * B'
+     * Count the number of contiguous runs of rows in the facing blocks to
+     * select the update mode
      */
-    wtmp = work;
-    kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
-    cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
-                 M, N, K,
-                 CBLAS_SADDR(zone),  A,    stride,
-                                     B,    stride,
-                 CBLAS_SADDR(zzero), wtmp, M );
-    kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
+    if ( cblk->gemmsmall ) {
+        mode = PastixGemmspSmall;
+    }
+    else {
+        nbruns = 0;
+        runfblok = NULL;
+        fblok = fcblk->fblokptr;
+        for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
+            fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
+            if ( (fblok != runfblok) || (iterblok->frownum != iterblok[-1].lrownum + 1) ) {
+                nbruns++;
+                runfblok = fblok;
+            }
+        }
+        mode = core_zgemmsp_1d1d_mode( M, N, nbruns, work, lwork );
+    }
 
     /*
-     * Add contribution to C in fcblk
+     * Buffered mode: compute the full update A * B' in the work buffer, and
+     * add each block contribution to C in fcblk
      */
+    if ( mode == PastixGemmspBuffered ) {
+        wtmp = work;
+        kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
+        cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
+                     M, N, K,
+                     CBLAS_SADDR(zone),  A,    stride,
+                                         B,    stride,
+                     CBLAS_SADDR(zzero), wtmp, M );
+        kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
 
-    /* Get the first block of the distant panel */
-    fblok = fcblk->fblokptr;
+        fblok = fcblk->fblokptr;
+        for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
 
-    /* Move the pointer to the top of the right column */
-    C = C + (blok->frownum - fcblk->fcolnum) * stridef;
+            /* Find facing blok */
+            fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
 
-    lblok = cblk[1].fblokptr;
+            tmpC = C + fblok->coefind + iterblok->frownum - fblok->frownum;
+            m = blok_rownbr( iterblok );
 
-    /* for all following blocks in block column */
-    for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
+            pastix_blok_lock( fcblk, fblok );
+            core_zgeadd( PastixNoTrans, m, N,
+                         -1.0, wtmp, M,
+                          1.0, tmpC, stridef );
+            pastix_blok_unlock( fcblk, fblok );
 
-        /* Find facing blok */
-        while (!is_block_inside_fblock( iterblok, fblok ))
-        {
-            fblok++;
-            assert( fblok < fcblk[1].fblokptr );
+            /* Displacement to next block */
+            wtmp += m;
+        }
+        return;
+    }
+
+    /*
+     * Direct, fused and small modes: each contiguous run of rows is computed by
+     * a single GEMM directly in C under the lock of its facing block. The
+     * direct mode is the case where the full update is one single run, and the
+     * small mode uses the small GEMM kernel instead of the BLAS one.
+     */
+
+    fblok    = fcblk->fblokptr;
+    runblok  = blok + shift;
+    runfblok = blok_facing_blok( blok, runblok, fcblk, fblok );
+    m = 0;
+    for (iterblok=blok+shift; iterblok<=lblok; iterblok++) {
+        if ( iterblok < lblok ) {
+            fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
+            if ( (fblok == runfblok) && (iterblok == runblok ||
+                                         iterblok->frownum == iterblok[-1].lrownum + 1) )
+            {
+                m += blok_rownbr( iterblok );
+                continue;
+            }
         }
 
-        tmpC = C + fblok->coefind + iterblok->frownum - fblok->frownum;
-        m = blok_rownbr( iterblok );
+        /* Flush the current run */
+        tmpC = C + runfblok->coefind + runblok->frownum - runfblok->frownum;
+
+        pastix_blok_lock( fcblk, runfblok );
+        kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
+        if ( mode == PastixGemmspSmall ) {
+            core_zgemmsp_small( trans, m, N, K,
+                                A, stride, B, stride, tmpC, stridef );
+        }
+        else {
+            cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
+                         m, N, K,
+                         CBLAS_SADDR(mzone), A,    stride,
+                                             B,    stride,
+                         CBLAS_SADDR(zone),  tmpC, stridef );
+        }
+        kernel_trace_stop_lvl2( FLOPS_ZGEMM( m, N, K ) );
+        pastix_blok_unlock( fcblk, runfblok );
 
-        pastix_cblk_lock( fcblk );
-        core_zgeadd( PastixNoTrans, m, N,
-                     -1.0, wtmp, M,
-                      1.0, tmpC, stridef );
-        pastix_cblk_unlock( fcblk );
+        if ( iterblok == lblok ) {
+            break;
+        }
 
-        /* Displacement to next block */
-        wtmp += m;
+        /* Start the next run */
+        A += m;
+        m  = blok_rownbr( iterblok );
+        runblok  = iterblok;
+        runfblok = fblok;
     }
 }
 
@@ -249,6 +482,15 @@ core_zgemmsp_1d1d( pastix_coefside_t sideA, pastix_trans_t trans,
  *          The pointer to the fcblk.lcoeftab if the lower part is computed,
  *          fcblk.ucoeftab otherwise.
  *
+ * @param[in] work
+ *          Temporary memory buffer of the calling thread. If the update of a
+ *          block fits in it, and is large enough, it is computed in the buffer
+ *          and only the addition to C is done under the lock of the facing
+ *          block. Can be NULL.
+ *
+ * @param[in] lwork
+ *          The size of the work buffer.
+ *
  *******************************************************************************
  *
  * @sa core_zgemmsp_1d1d
@@ -262,10 +504,12 @@ core_zgemmsp_1d2d( pastix_coefside_t sideA, pastix_trans_t trans,
                          SolverCblk         *fcblk,
                    const pastix_complex64_t *A,
                    const pastix_complex64_t *B,
-                         pastix_complex64_t *C )
+                         pastix_complex64_t *C,
+                         pastix_complex64_t *work,
+                         pastix_int_t        lwork )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
     const pastix_complex64_t *blokA;
     const pastix_complex64_t *blokB;
@@ -300,11 +544,7 @@ core_zgemmsp_1d2d( pastix_coefside_t sideA, pastix_trans_t trans,
     for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
 
         /* Find facing blok */
-        while (!is_block_inside_fblock( iterblok, fblok ))
-        {
-            fblok++;
-            assert( fblok < fcblk[1].fblokptr );
-        }
+        fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
 
         stridef = blok_rownbr(fblok);
 
@@ -316,15 +556,39 @@ core_zgemmsp_1d2d( pastix_coefside_t sideA, pastix_trans_t trans,
             + iterblok->frownum - fblok->frownum
             + (blok->frownum - fcblk->fcolnum) * stridef;
 
-        pastix_cblk_lock( fcblk );
+        /* Large update: compute it in the private buffer outside of the lock */
+        if ( !cblk->gemmsmall && core_zgemmsp_private( M, N, K, work, lwork ) ) {
+            kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
+            cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
+                         M, N, K,
+                         CBLAS_SADDR(zone),  blokA, stride,
+                                             blokB, stride,
+                         CBLAS_SADDR(zzero), work,  M );
+            kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
+
+            pastix_blok_lock( fcblk, fblok );
+            core_zgeadd( PastixNoTrans, M, N,
+                         -1.0, work,  M,
+                          1.0, blokC, stridef );
+            pastix_blok_unlock( fcblk, fblok );
+            continue;
+        }
+
+        pastix_blok_lock( fcblk, fblok );
         kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
-        cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
-                     M, N, K,
-                     CBLAS_SADDR(mzone), blokA, stride,
-                                         blokB, stride,
-                     CBLAS_SADDR(zone),  blokC, stridef );
+        if ( cblk->gemmsmall ) {
+            core_zgemmsp_small( trans, M, N, K,
+                                blokA, stride, blokB, stride, blokC, stridef );
+        }
+        else {
+            cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
+                         M, N, K,
+                         CBLAS_SADDR(mzone), blokA, stride,
+                                             blokB, stride,
+                         CBLAS_SADDR(zone),  blokC, stridef );
+        }
         kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
-        pastix_cblk_unlock( fcblk );
+        pastix_blok_unlock( fcblk, fblok );
     }
 }
 
@@ -388,6 +652,15 @@ core_zgemmsp_1d2d( pastix_coefside_t sideA, pastix_trans_t trans,
  *          The pointer to the fcblk.lcoeftab if the lower part is computed,
  *          fcblk.ucoeftab otherwise.
  *
+ * @param[in] work
+ *          Temporary memory buffer of the calling thread. If the update of a
+ *          block fits in it, and is large enough, it is computed in the buffer
+ *          and only the addition to C is done under the lock of the facing
+ *          block. Can be NULL.
+ *
+ * @param[in] lwork
+ *          The size of the work buffer.
+ *
  *******************************************************************************
  *
  * @sa core_zgemmsp_1d1d
@@ -401,10 +674,12 @@ core_zgemmsp_2d2d( pastix_coefside_t sideA, pastix_trans_t trans,
                          SolverCblk         *fcblk,
                    const pastix_complex64_t *A,
                    const pastix_complex64_t *B,
-                         pastix_complex64_t *C )
+                         pastix_complex64_t *C,
+                         pastix_complex64_t *work,
+                         pastix_int_t        lwork )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
     const pastix_complex64_t *blokA;
     const pastix_complex64_t *blokB;
@@ -437,11 +712,7 @@ core_zgemmsp_2d2d( pastix_coefside_t sideA, pastix_trans_t trans,
     for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
 
         /* Find facing blok */
-        while (!is_block_inside_fblock( iterblok, fblok ))
-        {
-            fblok++;
-            assert( fblok < fcblk[1].fblokptr );
-        }
+        fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
 
         ldc = blok_rownbr(fblok);
 
@@ -454,7 +725,25 @@ core_zgemmsp_2d2d( pastix_coefside_t sideA, pastix_trans_t trans,
             + iterblok->frownum - fblok->frownum
             + (blok->frownum - fcblk->fcolnum) * ldc;
 
-        pastix_cblk_lock( fcblk );
+        /* Large update: compute it in the private buffer outside of the lock */
+        if ( core_zgemmsp_private( M, N, K, work, lwork ) ) {
+            kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
+            cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
+                         M, N, K,
+                         CBLAS_SADDR(zone),  blokA, lda,
+                                             blokB, ldb,
+                         CBLAS_SADDR(zzero), work,  M );
+            kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
+
+            pastix_blok_lock( fcblk, fblok );
+            core_zgeadd( PastixNoTrans, M, N,
+                         -1.0, work,  M,
+                          1.0, blokC, ldc );
+            pastix_blok_unlock( fcblk, fblok );
+            continue;
+        }
+
+        pastix_blok_lock( fcblk, fblok );
         kernel_trace_start_lvl2( PastixKernelLvl2_FR_GEMM );
         cblas_zgemm( CblasColMajor, CblasNoTrans, (CBLAS_TRANSPOSE)trans,
                      M, N, K,
@@ -462,7 +751,7 @@ core_zgemmsp_2d2d( pastix_coefside_t sideA, pastix_trans_t trans,
                                          blokB, ldb,
                      CBLAS_SADDR(zone),  blokC, ldc );
         kernel_trace_stop_lvl2( FLOPS_ZGEMM( M, N, K ) );
-        pastix_cblk_unlock( fcblk );
+        pastix_blok_unlock( fcblk, fblok );
     }
 }
 
@@ -1058,7 +1347,7 @@ core_zgemmsp_fulllr( pastix_coefside_t         sideA,
                      const pastix_lr_t        *lowrank )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
     pastix_lrblock_t lrA, lrB, *lrC;
     core_zlrmm_t params;
@@ -1104,17 +1393,13 @@ core_zgemmsp_fulllr( pastix_coefside_t         sideA,
     params.beta    = 1.0;
     params.work    = work;
     params.lwork   = lwork;
-    params.lock    = &(fcblk->lock);
     params.B       = &lrB;
 
     for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
 
         /* Find facing blok */
-        while (!is_block_inside_fblock( iterblok, fblok ))
-        {
-            fblok++;
-            assert( fblok < fcblk[1].fblokptr );
-        }
+        fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
+        params.lock = pastix_blok_lockptr( fcblk, fblok );
 
         /* Get the A block and its dimensions */
         M = blok_rownbr( iterblok );
@@ -1202,7 +1487,7 @@ core_zgemmsp_lr( pastix_coefside_t         sideA,
                  const pastix_lr_t        *lowrank )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
 
     pastix_int_t N, K, shift;
@@ -1245,18 +1530,14 @@ core_zgemmsp_lr( pastix_coefside_t         sideA,
     params.work    = work;
     params.lwork   = lwork;
     params.lwused  = 0;
-    params.lock    = &(fcblk->lock);
     params.B       = lrB;
 
     /* for all following blocks in block column */
     for (iterblok=blok+shift; iterblok<lblok; iterblok++) {
 
         /* Find facing blok */
-        while (!is_block_inside_fblock( iterblok, fblok ))
-        {
-            fblok++;
-            assert( fblok < fcblk[1].fblokptr );
-        }
+        fblok = blok_facing_blok( blok, iterblok, fcblk, fblok );
+        params.lock = pastix_blok_lockptr( fcblk, fblok );
 
         params.M  = blok_rownbr( iterblok );
         params.A  = iterblok->LRblock + shift;
@@ -1388,7 +1669,7 @@ cpucblk_zgemmsp(       pastix_coefside_t   sideA,
 
             core_zgemmsp_2d2d( sideA, trans,
                                cblk, blok, fcblk,
-                               A, B, C );
+                               A, B, C, work, lwork );
         }
         else {
             ktype = PastixKernelGEMMCblk1d2d;
@@ -1396,7 +1677,7 @@ cpucblk_zgemmsp(       pastix_coefside_t   sideA,
 
             core_zgemmsp_1d2d( sideA, trans,
                                cblk, blok, fcblk,
-                               A, B, C );
+                               A, B, C, work, lwork );
         }
         flops = FLOPS_ZGEMM( m, n, k );
     }
@@ -1406,7 +1687,7 @@ cpucblk_zgemmsp(       pastix_coefside_t   sideA,
 
         core_zgemmsp_1d1d( sideA, trans,
                            cblk, blok, fcblk,
-                           A, B, C, work );
+                           A, B, C, work, lwork );
 
         flops = FLOPS_ZGEMM( m, n, k );
     }
@@ -306,6 +306,11 @@ cpucblk_zgetrfsp1d_panel( SolverMatrix       *solvmtx,
     cpucblk_ztrsmsp( PastixUCoef, PastixRight, PastixUpper,
                      PastixNoTrans, PastixUnit,
                      cblk, U, U, solvmtx );
+
+    /* Apply the fused forward solve while the panel is in cache */
+    if ( solvmtx->fwdsolve != NULL ) {
+        solve_cblk_ztrsmsp_fwdfacto( solvmtx, cblk );
+    }
     return nbpivots;
 }
 
@@ -378,5 +383,8 @@ cpucblk_zgetrfsp1d( SolverMatrix       *solvmtx,
         cpucblk_zrelease_deps( PastixLUCoef, solvmtx, cblk, fcblk );
     }
 
+    /* The bases of the cblk are now only read by the solve */
+    cpucblk_zlrcompact( solvmtx, PastixLUCoef, cblk );
+
     return nbpivots;
 }
@@ -318,7 +318,7 @@ void core_zhetrfsp1d_gemm( const SolverCblk         *cblk,
                                  pastix_complex64_t *work )
 {
     const SolverBlok *iterblok;
-    const SolverBlok *fblok;
+          SolverBlok *fblok;
     const SolverBlok *lblok;
     const pastix_complex64_t *blokA;
     const pastix_complex64_t *blokB;
@@ -379,7 +379,7 @@ void core_zhetrfsp1d_gemm( const SolverCblk         *cblk,
             /* Compute ldw which should never be larger than SOLVE_COEFMAX */
             ldw = (M+1) * K;
 
-            pastix_cblk_lock( fcblk );
+            pastix_blok_lock( fcblk, fblok );
             ret = core_zgemdm( PastixNoTrans, PastixConjTrans,
                                M, N, K,
                                -1.0, blokA, lda,
@@ -387,7 +387,7 @@ void core_zhetrfsp1d_gemm( const SolverCblk         *cblk,
                                 1.0, blokC, ldc,
                                     blokD, ldd,
                                work, ldw );
-            pastix_cblk_unlock( fcblk );
+            pastix_blok_unlock( fcblk, fblok );
             assert(ret == PASTIX_SUCCESS);
             (void)ret;
         }
@@ -442,6 +442,11 @@ cpucblk_zhetrfsp1d_panel( SolverMatrix       *solvmtx,
         /* Copy L into the temporary buffer and multiply by D */
         cpucblk_zscalo( PastixConjTrans, cblk, DLh );
     }
+
+    /* Apply the fused forward solve while the panel is in cache */
+    if ( solvmtx->fwdsolve != NULL ) {
+        solve_cblk_ztrsmsp_fwdfacto( solvmtx, cblk );
+    }
     return nbpivots;
 }
 
@@ -521,5 +526,8 @@ cpucblk_zhetrfsp1d( SolverMatrix       *solvmtx,
         cpucblk_zrelease_deps( PastixLCoef, solvmtx, cblk, fcblk );
     }
 
+    /* The bases of the cblk are now only read by the solve */
+    cpucblk_zlrcompact( solvmtx, PastixLCoef, cblk );
+
     return nbpivots;
 }
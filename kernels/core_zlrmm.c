@@ -124,13 +124,13 @@ core_zlrmm_Cnull( core_zlrmm_t *params )
             kernel_trace_start_lvl2( PastixKernelLvl2_LR_FRFR2null );
             flops = core_zfrfr2lr( params, &AB, &infomask,
                                    pastix_imin( pastix_imin( M, N ),
-                                                core_get_rklimit( Cm, Cn ) ) );
+                                                core_get_rklimit( lowrank, Cm, Cn ) ) );
             kernel_trace_stop_lvl2( flops );
         }
         else {
             kernel_trace_start_lvl2( PastixKernelLvl2_LR_FRLR2null );
             flops = core_zfrlr2lr( params, &AB, &infomask,
-                                   pastix_imin( M, core_get_rklimit( Cm, Cn ) ) );
+                                   pastix_imin( M, core_get_rklimit( lowrank, Cm, Cn ) ) );
             kernel_trace_stop_lvl2( flops );
         }
     }
@@ -138,7 +138,7 @@ core_zlrmm_Cnull( core_zlrmm_t *params )
         if ( B->rk == -1 ) {
             kernel_trace_start_lvl2( PastixKernelLvl2_LR_LRFR2null );
             flops = core_zlrfr2lr( params, &AB, &infomask,
-                                   pastix_imin( N, core_get_rklimit( Cm, Cn ) ) );
+                                   pastix_imin( N, core_get_rklimit( lowrank, Cm, Cn ) ) );
             kernel_trace_stop_lvl2( flops );
         }
         else {
@@ -291,6 +291,11 @@ cpucblk_zpotrfsp1d_panel( SolverMatrix       *solvmtx,
     cpucblk_ztrsmsp( PastixLCoef, PastixRight, PastixLower,
                      PastixConjTrans, PastixNonUnit,
                      cblk, L, L, solvmtx );
+
+    /* Apply the fused forward solve while the panel is in cache */
+    if ( solvmtx->fwdsolve != NULL ) {
+        solve_cblk_ztrsmsp_fwdfacto( solvmtx, cblk );
+    }
     return nbpivots;
 }
 
@@ -355,5 +360,8 @@ cpucblk_zpotrfsp1d( SolverMatrix       *solvmtx,
         cpucblk_zrelease_deps( PastixLCoef, solvmtx, cblk, fcblk );
    }
 
+    /* The bases of the cblk are now only read by the solve */
+    cpucblk_zlrcompact( solvmtx, PastixLCoef, cblk );
+
     return nbpivots;
 }
@@ -283,6 +283,11 @@ cpucblk_zpxtrfsp1d_panel( SolverMatrix       *solvmtx,
     cpucblk_ztrsmsp( PastixLCoef, PastixRight, PastixLower,
                      PastixTrans, PastixNonUnit,
                      cblk, L, L, solvmtx );
+
+    /* Apply the fused forward solve while the panel is in cache */
+    if ( solvmtx->fwdsolve != NULL ) {
+        solve_cblk_ztrsmsp_fwdfacto( solvmtx, cblk );
+    }
     return nbpivots;
 }
 
@@ -347,5 +352,8 @@ cpucblk_zpxtrfsp1d( SolverMatrix       *solvmtx,
         cpucblk_zrelease_deps( PastixLCoef, solvmtx, cblk, fcblk );
    }
 
+    /* The bases of the cblk are now only read by the solve */
+    cpucblk_zlrcompact( solvmtx, PastixLCoef, cblk );
+
     return nbpivots;
 }
@@ -339,6 +339,9 @@ core_zrqrrt( double tol, pastix_int_t maxrank, pastix_int_t nb,
  *
  *******************************************************************************
  *
+ * @param[in] lowrank
+ *          The structure with low-rank parameters.
+ *
  * @param[in] use_reltol
  *          Defines if the kernel should use relative tolerance (tol *||A||), or
  *          absolute tolerance (tol).
@@ -349,7 +352,7 @@ core_zrqrrt( double tol, pastix_int_t maxrank, pastix_int_t nb,
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to min(m, n) / PASTIX_LR_MINRATIO.
+ *          -1, set to min(m, n).
  *
  * @param[in] m
  *          Number of rows of the matrix A, and of the low rank matrix Alr.
@@ -369,11 +372,11 @@ core_zrqrrt( double tol, pastix_int_t maxrank, pastix_int_t nb,
  *
  *******************************************************************************/
 pastix_fixdbl_t
-core_zge2lr_rqrrt( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+core_zge2lr_rqrrt( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                    pastix_int_t m, pastix_int_t n,
                    const void *A, pastix_int_t lda,
                    pastix_lrblock_t *Alr )
 {
-    return core_zge2lr_qrrt( core_zrqrrt, use_reltol, tol, rklimit,
+    return core_zge2lr_qrrt( core_zrqrrt, lowrank, use_reltol, tol, rklimit,
                              m, n, A, lda, Alr );
 }
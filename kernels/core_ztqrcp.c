@@ -415,6 +415,9 @@ core_ztqrcp( double tol, pastix_int_t maxrank, int refine, pastix_int_t nb,
  *
  *******************************************************************************
  *
+ * @param[in] lowrank
+ *          The structure with low-rank parameters.
+ *
  * @param[in] use_reltol
  *          Defines if the kernel should use relative tolerance (tol *||A||), or
  *          absolute tolerance (tol).
@@ -425,7 +428,7 @@ core_ztqrcp( double tol, pastix_int_t maxrank, int refine, pastix_int_t nb,
  *
  * @param[in] rklimit
  *          The maximum rank to store the matrix in low-rank format. If
- *          -1, set to min(m, n) / PASTIX_LR_MINRATIO.
+ *          -1, set to min(m, n).
  *
  * @param[in] m
  *          Number of rows of the matrix A, and of the low rank matrix Alr.
@@ -445,12 +448,12 @@ core_ztqrcp( double tol, pastix_int_t maxrank, int refine, pastix_int_t nb,
  *
  *******************************************************************************/
 pastix_fixdbl_t
-core_zge2lr_tqrcp( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+core_zge2lr_tqrcp( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                    pastix_int_t m, pastix_int_t n,
                    const void *A, pastix_int_t lda,
                    pastix_lrblock_t *Alr )
 {
-    return core_zge2lr_qrcp( core_ztqrcp, use_reltol, tol, rklimit,
+    return core_zge2lr_qrcp( core_ztqrcp, lowrank, use_reltol, tol, rklimit,
                              m, n, A, lda, Alr );
 }
 
@@ -229,7 +229,7 @@ core_ztrsmsp_lr( pastix_coefside_t coef, pastix_side_t side, pastix_uplo_t uplo,
                  SolverCblk *cblk, SolverMatrix *solvmtx )
 {
     SolverBlok *fblok, *lblok, *blok;
-    pastix_int_t M, N, lda;
+    pastix_int_t M, N, lda, updtK;
     pastix_lrblock_t *lrA, *lrC;
     pastix_complex64_t *A;
 
@@ -239,6 +239,7 @@ core_ztrsmsp_lr( pastix_coefside_t coef, pastix_side_t side, pastix_uplo_t uplo,
     pastix_lr_t *lowrank = &solvmtx->lowrank;
 
     N     = cblk->lcolnum - cblk->fcolnum + 1;
+    updtK = lowrank->compress_policy ? cblk->updtwdth : N;
     fblok = cblk[0].fblokptr;  /* The diagonal block */
     lblok = cblk[1].fblokptr;  /* The diagonal block of the next cblk */
 
@@ -272,12 +273,12 @@ core_ztrsmsp_lr( pastix_coefside_t coef, pastix_side_t side, pastix_uplo_t uplo,
             if ( (lowrank->compress_when == PastixCompressWhenEnd) &&
                  (lowrank->compress_preselect || (!is_preselected)) )
             {
-                flops_lr = cpublok_zcompress( lowrank, coef, M, N, blok );
+                flops_lr = cpublok_zcompress( lowrank, coef, M, N, updtK, blok );
             }
             if ( (lowrank->compress_when == PastixCompressWhenBegin) &&
                  (lowrank->compress_preselect && is_preselected ) )
             {
-                flops_lr = cpublok_zcompress( lowrank, coef, M, N, blok );
+                flops_lr = cpublok_zcompress( lowrank, coef, M, N, updtK, blok );
             }
         }
 
@@ -546,13 +547,14 @@ core_ztrsmsp_lrsub( pastix_coefside_t   coef,
                     const pastix_lr_t  *lowrank )
 {
     SolverBlok *fblok, *lblok, *blok;
-    pastix_int_t M, N, lda, cblk_m, full_m, full_n;
+    pastix_int_t M, N, lda, updtK, cblk_m, full_m, full_n;
     pastix_complex64_t *A;
     pastix_lrblock_t *lrA, *lrC;
     pastix_fixdbl_t flops = 0.0;
     pastix_fixdbl_t time = kernel_trace_start( PastixKernelTRSMBlokLR );
 
     N     = cblk->lcolnum - cblk->fcolnum + 1;
+    updtK = lowrank->compress_policy ? cblk->updtwdth : N;
     fblok = cblk[0].fblokptr;  /* The diagonal block */
     lblok = cblk[1].fblokptr;  /* The diagonal block of the next cblk */
 
@@ -589,12 +591,12 @@ core_ztrsmsp_lrsub( pastix_coefside_t   coef,
             if ( (lowrank->compress_when == PastixCompressWhenEnd) &&
                  (lowrank->compress_preselect || (!is_preselected)) )
             {
-                flops += cpublok_zcompress( lowrank, coef, M, N, blok );
+                flops += cpublok_zcompress( lowrank, coef, M, N, updtK, blok );
             }
             if ( (lowrank->compress_when == PastixCompressWhenBegin) &&
                  (lowrank->compress_preselect &&  is_preselected ) )
             {
-                flops += cpublok_zcompress( lowrank, coef, M, N, blok );
+                flops += cpublok_zcompress( lowrank, coef, M, N, updtK, blok );
             }
         }
 
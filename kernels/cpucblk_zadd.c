@@ -63,7 +63,7 @@ cpucblk_zadd_frlr( pastix_coefside_t   side,
                    const pastix_lr_t  *lowrank )
 {
     const SolverBlok   *blokA  = cblkA->fblokptr;
-    const SolverBlok   *blokB  = cblkB->fblokptr;
+          SolverBlok   *blokB  = cblkB->fblokptr;
     const SolverBlok   *lblokA = cblkA[1].fblokptr;
     const SolverBlok   *lblokB = cblkB[1].fblokptr;
     pastix_complex64_t *A;
@@ -98,7 +98,6 @@ cpucblk_zadd_frlr( pastix_coefside_t   side,
     params.work    = work;
     params.lwork   = lwork;
     params.lwused  = 0;
-    params.lock    = &(cblkB->lock);
 
     /* Dimensions on N */
     params.N    = cblk_colnbr( cblkA );
@@ -125,6 +124,7 @@ cpucblk_zadd_frlr( pastix_coefside_t   side,
         params.Cm   = blok_rownbr( blokB );
         params.offx = blokA->frownum - blokB->frownum;
         params.C    = blokB->LRblock + shift;
+        params.lock = pastix_blok_lockptr( cblkB, blokB );
 
         flops += core_zlradd( &params, &lrA,
                               PastixNoTrans, 0 );
@@ -173,7 +173,7 @@ cpucblk_zadd_lrlr( pastix_coefside_t   side,
                    const pastix_lr_t  *lowrank )
 {
     const SolverBlok   *blokA  = cblkA->fblokptr;
-    const SolverBlok   *blokB  = cblkB->fblokptr;
+          SolverBlok   *blokB  = cblkB->fblokptr;
     const SolverBlok   *lblokA = cblkA[1].fblokptr;
     const SolverBlok   *lblokB = cblkB[1].fblokptr;
     pastix_int_t        shift;
@@ -196,7 +196,6 @@ cpucblk_zadd_lrlr( pastix_coefside_t   side,
     params.work    = work;
     params.lwork   = lwork;
     params.lwused  = 0;
-    params.lock    = &(cblkB->lock);
 
     /* Dimensions on N */
     params.N    = cblk_colnbr( cblkA );
@@ -217,6 +216,7 @@ cpucblk_zadd_lrlr( pastix_coefside_t   side,
         params.Cm   = blok_rownbr( blokB );
         params.offx = blokA->frownum - blokB->frownum;
         params.C    = blokB->LRblock + shift;
+        params.lock = pastix_blok_lockptr( cblkB, blokB );
 
         flops += core_zlradd( &params, blokA->LRblock + shift,
                               PastixNoTrans, PASTIX_LRM3_ORTHOU );
@@ -283,17 +283,26 @@ cpucblk_zadd_frfr( pastix_coefside_t side,
     /* If the cblk matches */
     if ( (n == cblk_colnbr( cblkB )) &&
          (m == cblkB->stride) ) {
-
-        pastix_cblk_lock( cblkB );
-        core_zgeadd( PastixNoTrans, m, n,
-                     alpha, A, m,
-                        1., B, m );
-        pastix_cblk_unlock( cblkB );
+              SolverBlok   *blokB  = cblkB->fblokptr;
+        const SolverBlok   *lblokB = cblkB[1].fblokptr;
+        pastix_int_t        mb, ld;
+
+        /* The blocks are added one by one to take the same locks as the updates */
+        for (; blokB < lblokB; blokB++) {
+            mb = blok_rownbr( blokB );
+            ld = (cblkB->cblktype & CBLK_LAYOUT_2D) ? mb : m;
+
+            pastix_blok_lock( cblkB, blokB );
+            core_zgeadd( PastixNoTrans, mb, n,
+                         alpha, A + blokB->coefind, ld,
+                            1., B + blokB->coefind, ld );
+            pastix_blok_unlock( cblkB, blokB );
+        }
     }
     else {
         pastix_complex64_t *bA, *bB;
         const SolverBlok   *blokA  = cblkA->fblokptr;
-        const SolverBlok   *blokB  = cblkB->fblokptr;
+              SolverBlok   *blokB  = cblkB->fblokptr;
         const SolverBlok   *lblokA = cblkA[1].fblokptr;
         const SolverBlok   *lblokB = cblkB[1].fblokptr;
         pastix_int_t        lda, ldb;
@@ -319,11 +328,11 @@ cpucblk_zadd_frfr( pastix_coefside_t side,
             bB = bB + ldb * ( cblkA->fcolnum - cblkB->fcolnum ) + ( blokA->frownum - blokB->frownum );
             m = lda;
 
-            pastix_cblk_lock( cblkB );
+            pastix_blok_lock( cblkB, blokB );
             core_zgeadd( PastixNoTrans, m, n,
                          alpha, bA, lda,
                             1., bB, ldb );
-            pastix_cblk_unlock( cblkB );
+            pastix_blok_unlock( cblkB, blokB );
         }
     }
     return flops;
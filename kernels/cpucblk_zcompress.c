@@ -47,10 +47,16 @@
  * @param[in] N
  *          The number of columns in the block
  *
+ * @param[in] K
+ *          The average width of the updates received by the block, used by the
+ *          compression policy (see SolverCblk::updtwdth).
+ *
  * @param[inout] blok
  *          The block to compress. On input, it points to a full-rank matrix. On
  *          output, if possible the matrix is compressed in block low-rank
- *          format.
+ *          format. If the compression policy is enabled, the method is
+ *          selected by core_lrpolicy() from the rank history of the block,
+ *          which is updated, and the block may be kept in full-rank.
  *
  *******************************************************************************
  *
@@ -60,22 +66,34 @@
 pastix_fixdbl_t
 cpublok_zcompress( const pastix_lr_t *lowrank,
                    pastix_coefside_t side,
-                   pastix_int_t M, pastix_int_t N,
+                   pastix_int_t M, pastix_int_t N, pastix_int_t K,
                    SolverBlok *blok )
 {
     pastix_fixdbl_t flops;
     pastix_lrblock_t   *lrA = blok->LRblock + side;
     pastix_complex64_t *A = lrA->u;
+    fct_ge2lr_t         core_ge2lr = lowrank->core_ge2lr;
 
     assert( lrA->rk == -1   );
     assert( lrA->u  != NULL );
     assert( lrA->v  == NULL );
 
+    if ( lowrank->compress_policy ) {
+        int method = core_lrpolicy( lowrank, M, N, K, blok->rkhist + side );
+
+        if ( method == -1 ) {
+            return 0.;
+        }
+        core_ge2lr = ge2lrMethods[method][PastixComplex64-2];
+    }
+
     kernel_trace_start_lvl2( PastixKernelLvl2_LR_init_compress );
-    flops = lowrank->core_ge2lr( lowrank->use_reltol, lowrank->tolerance, -1,
-                                 M, N, A, M, lrA );
+    flops = core_ge2lr( lowrank, lowrank->use_reltol, lowrank->tolerance,
+                        core_get_rklimit( lowrank, M, N ),
+                        M, N, A, M, lrA );
     kernel_trace_stop_lvl2_rank( flops, lrA->rk );
 
+    blok->rkhist[side] = lrA->rk;
     free( A );
 
     return flops;
@@ -118,6 +136,7 @@ cpucblk_zcompress( const SolverMatrix *solvmtx,
     SolverBlok         *blok  = cblk[0].fblokptr + 1;
     SolverBlok         *lblok = cblk[1].fblokptr;
     pastix_int_t        ncols = cblk_colnbr( cblk );
+    pastix_int_t        updtK;
     pastix_int_t        gain;
     pastix_int_t        gainL = 0;
     pastix_int_t        gainU = 0;
@@ -126,9 +145,11 @@ cpucblk_zcompress( const SolverMatrix *solvmtx,
     assert( cblk->cblktype & CBLK_LAYOUT_2D  );
     assert( cblk->cblktype & CBLK_COMPRESSED );
 
-    if ( ncols < lowrank->compress_min_width ) {
+    /* The blocks of a cblk with single precision bases are final */
+    if ( (ncols < lowrank->compress_min_width) || cblk->lrcompact ) {
         return 0;
     }
+    updtK = lowrank->compress_policy ? cblk->updtwdth : ncols;
 
     for (; blok<lblok; blok++)
     {
@@ -165,7 +186,7 @@ cpucblk_zcompress( const SolverMatrix *solvmtx,
 
             /* Try to compress non selected blocks */
             if ( lrA->rk == -1 ) {
-                cpublok_zcompress( lowrank, PastixLCoef, nrows, ncols, blok );
+                cpublok_zcompress( lowrank, PastixLCoef, nrows, ncols, updtK, blok );
             }
 
             if ( lrA->rk != -1 ) {
@@ -178,7 +199,7 @@ cpucblk_zcompress( const SolverMatrix *solvmtx,
             lrA = blok->LRblock + 1;
 
             if ( lrA->rk == -1 ) {
-                cpublok_zcompress( lowrank, PastixUCoef, nrows, ncols, blok );
+                cpublok_zcompress( lowrank, PastixUCoef, nrows, ncols, updtK, blok );
             }
 
             if ( lrA->rk != -1 ) {
@@ -190,6 +211,44 @@ cpucblk_zcompress( const SolverMatrix *solvmtx,
     return gainL + gainU;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Convert back a low-rank block stored in single precision by
+ * cpucblk_zlrcompact().
+ *
+ *******************************************************************************
+ *
+ * @param[in] M
+ *          The number of rows in the block
+ *
+ * @param[in] N
+ *          The number of columns in the block
+ *
+ * @param[inout] lrA
+ *          The low-rank block. On exit, its single precision bases are
+ *          replaced by newly allocated bases in the working precision.
+ *
+ *******************************************************************************/
+static inline void
+cpublok_zlrexpand( pastix_int_t      M,
+                   pastix_int_t      N,
+                   pastix_lrblock_t *lrA )
+{
+    pastix_lrblock_t lrexp;
+
+    if ( lrA->rk <= 0 ) {
+        return;
+    }
+
+    core_zlralloc( M, N, lrA->rk, &lrexp );
+    lrexp.rk = lrA->rk;
+    core_lrexpand( PastixComplex64, M, N, lrA, lrexp.u, lrexp.v );
+
+    core_zlrfree( lrA );
+    memcpy( lrA, &lrexp, sizeof(pastix_lrblock_t) );
+}
+
 /**
  *******************************************************************************
  *
@@ -225,6 +284,9 @@ cpucblk_zuncompress( pastix_coefside_t side,
             pastix_int_t nrows = blok_rownbr( blok );
 
             memcpy( &lrtmp, blok->LRblock, sizeof(pastix_lrblock_t) );
+            if ( cblk->lrcompact ) {
+                cpublok_zlrexpand( nrows, ncols, &lrtmp );
+            }
 
             core_zlralloc( nrows, ncols, -1, blok->LRblock );
             ret = core_zlr2ge( PastixNoTrans, nrows, ncols,
@@ -244,6 +306,9 @@ cpucblk_zuncompress( pastix_coefside_t side,
             pastix_int_t nrows = blok_rownbr( blok );
 
             memcpy( &lrtmp, blok->LRblock+1, sizeof(pastix_lrblock_t) );
+            if ( cblk->lrcompact ) {
+                cpublok_zlrexpand( nrows, ncols, &lrtmp );
+            }
 
             core_zlralloc( nrows, ncols, -1, blok->LRblock+1 );
             ret = core_zlr2ge( PastixNoTrans, nrows, ncols,
@@ -254,9 +319,75 @@ cpucblk_zuncompress( pastix_coefside_t side,
         }
     }
 
+    cblk->lrcompact = 0;
     (void)ret;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Store the low-rank bases of a factorized column block in single
+ * precision.
+ *
+ * This routine is called once the column block is factorized and has applied
+ * all its updates, such that its low-rank blocks are only read again by the
+ * solve, which converts them back on the fly. The full-rank blocks are kept as
+ * is. Nothing is done if the compact storage is disabled in the low-rank
+ * parameters, or for the cblks of the Schur complement.
+ *
+ *******************************************************************************
+ *
+ * @param[in] solvmtx
+ *          The pointer to the solver structure.
+ *
+ * @param[in] side
+ *          Define which side of the cblk must be stored in single precision.
+ *          @arg PastixLCoef if lower part only
+ *          @arg PastixUCoef if upper part only
+ *          @arg PastixLUCoef if both sides.
+ *
+ * @param[inout] cblk
+ *          The column block to compact.
+ *
+ *******************************************************************************
+ *
+ * @return The number of low-rank bases that overflowed the single precision.
+ *
+ *******************************************************************************/
+int
+cpucblk_zlrcompact( const SolverMatrix *solvmtx,
+                    pastix_coefside_t   side,
+                    SolverCblk         *cblk )
+{
+    SolverBlok  *blok  = cblk[0].fblokptr + 1;
+    SolverBlok  *lblok = cblk[1].fblokptr;
+    pastix_int_t ncols = cblk_colnbr( cblk );
+    int rc = 0;
+
+    if ( !solvmtx->lowrank.compress_lowprec     ||
+         !(cblk->cblktype & CBLK_COMPRESSED)    ||
+         (cblk->cblktype & CBLK_IN_SCHUR)       ||
+         cblk->lrcompact )
+    {
+        return 0;
+    }
+
+    for (; blok<lblok; blok++)
+    {
+        pastix_int_t nrows = blok_rownbr( blok );
+
+        if ( side != PastixUCoef ) {
+            rc += core_lrcompact( PastixComplex64, nrows, ncols, blok->LRblock );
+        }
+        if ( side != PastixLCoef ) {
+            rc += core_lrcompact( PastixComplex64, nrows, ncols, blok->LRblock + 1 );
+        }
+    }
+
+    cblk->lrcompact = 1;
+    return rc;
+}
+
 /**
  *******************************************************************************
  *
@@ -304,7 +435,7 @@ cpucblk_zmemory( pastix_coefside_t   side,
     pastix_int_t gainblok, gaintmp;
 
     /* Compute potential gains if blocks where not compressed */
-    if ( cblk->cblktype & CBLK_COMPRESSED ) {
+    if ( (cblk->cblktype & CBLK_COMPRESSED) && !cblk->lrcompact ) {
         cpucblk_zcompress( solvmtx, side, cblk );
     }
 
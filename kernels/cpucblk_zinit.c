@@ -197,6 +197,7 @@ cpucblk_zfree( pastix_coefside_t  side,
          (cblk->ucoeftab == NULL) ) {
         free( cblk->fblokptr->LRblock );
         cblk->fblokptr->LRblock = NULL;
+        cblk->lrcompact = 0;
     }
     pastix_cblk_unlock( cblk );
 }
@@ -446,3 +447,91 @@ cpucblk_zfillin( pastix_coefside_t    side,
         cpucblk_zfillin_fr( side, solvmtx, bcsc, itercblk );
     }
 }
+
+/**
+ *******************************************************************************
+ *
+ * @brief Reset and fill a full-rank cblk from the internal bcsc with the
+ * scatter map.
+ *
+ * The cblk is already allocated by a previous initialization with the same
+ * block csc structure. Its coefficients are set to zero to remove the fill-in
+ * of the previous factorization, and the values of the bcsc are copied at the
+ * offsets stored in the map, without searching the blocks.
+ *
+ *******************************************************************************
+ *
+ * @param[in] side
+ *          Define which side of the matrix must be initialized.
+ *          @arg PastixLCoef if lower part only
+ *          @arg PastixUCoef if upper part only
+ *          @arg PastixLUCoef if both sides.
+ *
+ * @param[in] solvmtx
+ *          PaStiX structure to store numerical data and flags
+ *
+ * @param[in] bcsc
+ *          The internal bcsc structure with a valid scatter map.
+ *
+ * @param[in] itercblk
+ *          The index of the cblk to fill in both bcsc and solvmtx structures.
+ *
+ *******************************************************************************/
+void
+cpucblk_zrefill( pastix_coefside_t    side,
+                 const SolverMatrix  *solvmtx,
+                 const pastix_bcsc_t *bcsc,
+                 pastix_int_t         itercblk )
+{
+    SolverCblk         *solvcblk  = solvmtx->cblktab + itercblk;
+    const bcsc_cblk_t  *csccblk   = bcsc->cscftab + solvcblk->bcscnum;
+    const pastix_int_t *bcsc2ctab = bcsc->map->bcsc2ctab;
+    pastix_complex64_t *lcoeftab  = solvcblk->lcoeftab;
+    pastix_complex64_t *ucoeftab  = solvcblk->ucoeftab;
+    pastix_complex64_t *Lvalues   = bcsc->Lvalues;
+    pastix_complex64_t *Uvalues   = bcsc->Uvalues;
+    size_t              coefnbr   = (size_t)(solvcblk->stride) * cblk_colnbr( solvcblk );
+    pastix_int_t        itercoltab, iterval, coefindx;
+
+    assert( !(solvcblk->cblktype & CBLK_COMPRESSED) );
+    assert( (side != PastixUCoef) || (ucoeftab != NULL) );
+
+    if ( side != PastixUCoef ) {
+        memset( lcoeftab, 0, coefnbr * sizeof(pastix_complex64_t) );
+    }
+    if ( side != PastixLCoef ) {
+        memset( ucoeftab, 0, coefnbr * sizeof(pastix_complex64_t) );
+    }
+
+    for (itercoltab=0; itercoltab<csccblk->colnbr; itercoltab++)
+    {
+        pastix_int_t frow = csccblk->coltab[itercoltab];
+        pastix_int_t lrow = csccblk->coltab[itercoltab+1];
+
+        for (iterval=frow; iterval<lrow; iterval++)
+        {
+            coefindx = bcsc2ctab[iterval];
+            if ( coefindx == -1 ) {
+                continue;
+            }
+
+            if ( side != PastixUCoef ) {
+                lcoeftab[coefindx] = Lvalues[iterval];
+            }
+
+            if ( (side != PastixLCoef) &&
+                 (bcsc->rowtab[iterval] > (solvcblk->fcolnum + itercoltab)) )
+            {
+#if defined(PRECISION_z) || defined(PRECISION_c)
+                if (bcsc->mtxtype == PastixHermitian) {
+                    ucoeftab[coefindx] = conj(Uvalues[iterval]);
+                }
+                else
+#endif
+                {
+                    ucoeftab[coefindx] = Uvalues[iterval];
+                }
+            }
+        }
+    }
+}
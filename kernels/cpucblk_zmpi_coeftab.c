@@ -504,7 +504,7 @@ cpucblk_zincoming_deps( int                rank,
     }
 #else
     assert( !(cblk->cblktype & (CBLK_FANIN | CBLK_RECV)) );
-    do { } while( cblk->ctrbcnt > 0 );
+    cblk_wait_deps( solvmtx, cblk, rank );
 #endif
 
     (void)rank;
@@ -544,7 +544,7 @@ cpucblk_zrelease_deps( pastix_coefside_t  side,
                        SolverCblk        *fcbk )
 {
     int32_t ctrbcnt;
-    ctrbcnt = pastix_atomic_dec_32b( &(fcbk->ctrbcnt) );
+    ctrbcnt = cblk_ctrbcnt_dec( fcbk );
     if ( !ctrbcnt ) {
 #if defined(PASTIX_WITH_MPI)
         if ( fcbk->cblktype & CBLK_FANIN ) {
@@ -554,7 +554,11 @@ cpucblk_zrelease_deps( pastix_coefside_t  side,
 #else
         (void)side;
 #endif
-        if ( solvmtx->computeQueue ) {
+        if ( solvmtx->computeDeque ) {
+            /* The deque can only be filled by its owner, that is the thread working on cblk */
+            pdequePush( solvmtx->computeDeque[ cblk->threadid ], fcbk - solvmtx->cblktab );
+        }
+        else if ( solvmtx->computeQueue ) {
             pastix_queue_t *queue = solvmtx->computeQueue[ cblk->threadid ];
             pqueuePush1( queue, fcbk - solvmtx->cblktab, queue->size );
         }
@@ -21,18 +21,12 @@
 #include "solver.h"
 #include "kernels_trace.h"
 
-/**
- * @brief Compute the maximal rank accepted for a given matrix size. The pointer is set according to the low-rank strategy used.
- * @param[in] M The number of rows of the matrix
- * @param[in] N The number of columns of the matrix
- * @return The maximal rank accepted for this matrix size.
- */
-pastix_int_t (*core_get_rklimit)( pastix_int_t, pastix_int_t ) = core_get_rklimit_end;
-
-volatile double  kernels_flops[PastixKernelLvl1Nbr];
-
 volatile int32_t kernels_trace_started = 0;
 
+pthread_key_t         kernels_trace_key;
+volatile int          kernels_trace_keyed = 0;
+static pthread_once_t kernels_trace_once  = PTHREAD_ONCE_INIT;
+
 #if defined(PASTIX_WITH_EZTRACE)
 
 int pastix_eztrace_level = 1;
@@ -50,31 +44,87 @@ int32_t               model_size        = 0;
 pastix_atomic_lock_t lock_flops = PASTIX_ATOMIC_UNLOCKED;
 double overall_flops[3] = { 0.0, 0.0, 0.0 };
 
+int          kernels_lock_cblk      = 0;
+int          kernels_update_mode    = PastixUpdateModeAuto;
+double       kernels_lock_wait      = 0.0;
+pastix_int_t kernels_lock_contended = 0;
+
+pastix_int_t kernels_sketch_nbr[2]   = { 0, 0 };
+double       kernels_sketch_flops[2] = { 0.0, 0.0 };
+
+/**
+ * @brief Create the key to the per-thread statistics.
+ */
+static void
+kernels_trace_init( void )
+{
+    pthread_key_create( &kernels_trace_key, NULL );
+    pastix_mfence();
+    kernels_trace_keyed = 1;
+}
+
+/**
+ * @brief Attach each thread of the internal scheduler to its statistics
+ * structure, or detach it if args is NULL.
+ */
+static void
+kernels_trace_attach( isched_thread_t *ctx,
+                      void            *args )
+{
+    kernels_trace_t *trace = (kernels_trace_t *)args;
+
+    pthread_setspecific( kernels_trace_key,
+                         (trace == NULL) ? NULL : trace + ctx->rank );
+}
+
 /**
  *******************************************************************************
  *
  * @brief Start the trace module
  *
+ * The threads of the internal scheduler of the instance are attached to their
+ * own statistics structure, such that several instances can factorize
+ * concurrently without sharing the counters. The threads that are not attached
+ * (the workers of the external runtimes) accumulate in the global counters.
+ *
  *******************************************************************************
  *
- * @param[in] pastix_data
+ * @param[inout] pastix_data
  *          The pastix_data structure of the problem to give input information
- *          to the different trace modes.
+ *          to the different trace modes. On exit, the per-thread statistics
+ *          are allocated.
  *
  *******************************************************************************/
 void
-kernelsTraceStart( const pastix_data_t *pastix_data )
+kernelsTraceStart( pastix_data_t *pastix_data )
 {
     const SolverMatrix *solvmtx = pastix_data->solvmatr;
     int32_t nbstart;
 
+    pthread_once( &kernels_trace_once, kernels_trace_init );
+
+    assert( pastix_data->trace == NULL );
+    MALLOC_INTERN( pastix_data->trace, pastix_data->isched->world_size, kernels_trace_t );
+    memset( pastix_data->trace, 0, pastix_data->isched->world_size * sizeof(kernels_trace_t) );
+    isched_parallel_call( pastix_data->isched, kernels_trace_attach, pastix_data->trace );
+
     pastix_atomic_lock( &lock_flops );
     nbstart = pastix_atomic_inc_32b( &(kernels_trace_started) );
     if ( nbstart > 1 ) {
+        /* The lock mode can not change while another factorization is running */
+        if ( kernels_lock_cblk != (pastix_data->iparm[IPARM_UPDATE_LOCK_CBLK] != 0) ) {
+            errorPrintW( "kernelsTraceStart: IPARM_UPDATE_LOCK_CBLK differs from the one of the factorization already running, it is ignored" );
+        }
+        if ( kernels_update_mode != pastix_data->iparm[IPARM_UPDATE_MODE] ) {
+            errorPrintW( "kernelsTraceStart: IPARM_UPDATE_MODE differs from the one of the factorization already running, it is ignored" );
+        }
         pastix_atomic_unlock( &lock_flops );
         return;
     }
 
+    kernels_lock_cblk   = ( pastix_data->iparm[IPARM_UPDATE_LOCK_CBLK] != 0 );
+    kernels_update_mode = pastix_data->iparm[IPARM_UPDATE_MODE];
+
 #if defined(PASTIX_WITH_EZTRACE)
     {
         char *level = pastix_getenv("PASTIX_EZTRACE_LEVEL");
@@ -132,12 +182,13 @@ kernelsTraceStart( const pastix_data_t *pastix_data )
     }
 #endif
 
-    memset( (void*)kernels_flops, 0, PastixKernelLvl1Nbr * sizeof(double) );
-
     overall_flops[0] = 0.0;
     overall_flops[1] = 0.0;
     overall_flops[2] = 0.0;
-    kernels_trace_started = 1;
+
+    kernels_lock_wait      = 0.0;
+    kernels_lock_contended = 0;
+    kernels_trace_started  = 1;
 
     (void)solvmtx;
     pastix_atomic_unlock( &lock_flops );
@@ -151,18 +202,97 @@ kernelsTraceStart( const pastix_data_t *pastix_data )
  *
  *******************************************************************************
  *
- * @param[in] pastix_data
+ * @param[inout] pastix_data
  *          The pastix_data structure of the problem to get input information
- *          for the different trace modes, and store output statistics.
+ *          for the different trace modes, and store output statistics. On
+ *          exit, the per-thread statistics are freed.
  *
  *******************************************************************************/
 double
-kernelsTraceStop( const pastix_data_t *pastix_data )
+kernelsTraceStop( pastix_data_t *pastix_data )
 {
-    double total_flops = 0.0;
-    int32_t nbstart;
+    kernels_trace_t *trace = pastix_data->trace;
+    double       flops[3];
+    double       lock_wait;
+    pastix_int_t lock_contended;
+    pastix_int_t sketch_nbr[2];
+    double       sketch_flops[2];
+    double       total_flops = 0.0;
+    int32_t      nbstart;
+    int          i;
 
     assert( kernels_trace_started > 0 );
+
+    /* Detach the threads, and reduce their statistics */
+    isched_parallel_call( pastix_data->isched, kernels_trace_attach, NULL );
+
+    pastix_atomic_lock( &lock_flops );
+    flops[0]       = overall_flops[0];
+    flops[1]       = overall_flops[1];
+    flops[2]       = overall_flops[2];
+    lock_wait      = kernels_lock_wait;
+    lock_contended = kernels_lock_contended;
+
+    /*
+     * The sketches are not reset at the start of the trace, as the blocks are
+     * compressed before it in the Minimal-Memory strategy. They are reported
+     * once, by the first instance that stops its trace after them.
+     */
+    sketch_nbr[0]   = kernels_sketch_nbr[0];
+    sketch_nbr[1]   = kernels_sketch_nbr[1];
+    sketch_flops[0] = kernels_sketch_flops[0];
+    sketch_flops[1] = kernels_sketch_flops[1];
+    kernels_sketch_nbr[0]   = 0;
+    kernels_sketch_nbr[1]   = 0;
+    kernels_sketch_flops[0] = 0.0;
+    kernels_sketch_flops[1] = 0.0;
+    pastix_atomic_unlock( &lock_flops );
+
+    for ( i = 0; i < pastix_data->isched->world_size; i++, trace++ ) {
+        flops[0]       += trace->flops[0];
+        flops[1]       += trace->flops[1];
+        flops[2]       += trace->flops[2];
+        lock_wait      += trace->lock_wait;
+        lock_contended += trace->lock_contended;
+        sketch_nbr[0]   += trace->sketch_nbr;
+        sketch_nbr[1]   += trace->sketch_rejected;
+        sketch_flops[0] += trace->sketch_flops;
+        sketch_flops[1] += trace->sketch_saved;
+    }
+    memFree_null( pastix_data->trace );
+
+    /* Update the real number of Flops performed */
+    total_flops = flops[0] + flops[1] + flops[2];
+    pastix_data->dparm[DPARM_FACT_RLFLOPS] = total_flops;
+
+#if defined(PASTIX_SUPERNODE_STATS)
+    if (pastix_data->iparm[IPARM_VERBOSE] > PastixVerboseNot) {
+        fprintf( stdout,
+                 "    Details of the number of operations:\n"
+                 "      - POTRF(A11) + TRSM(A11, A21): %6.2lf %cFlops\n"
+                 "      - HERK(A21, A22)             : %6.2lf %cFlops\n"
+                 "      - POTRF(A22)                 : %6.2lf %cFlops\n"
+                 "      Total                        : %6.2lf %cFlops\n",
+                 pastix_print_value( flops[0] ), pastix_print_unit( flops[0] ),
+                 pastix_print_value( flops[1] ), pastix_print_unit( flops[1] ),
+                 pastix_print_value( flops[2] ), pastix_print_unit( flops[2] ),
+                 pastix_print_value( total_flops ), pastix_print_unit( total_flops ) );
+    }
+#endif /* defined(PASTIX_SUPERNODE_STATS) */
+
+    if ( pastix_data->iparm[IPARM_VERBOSE] > PastixVerboseNo ) {
+        pastix_print( pastix_data->inter_node_procnum, 0, OUT_LOCK_WAIT,
+                      kernels_lock_cblk ? "cblk" : "block",
+                      lock_wait, (long)lock_contended );
+
+        if ( sketch_nbr[0] > 0 ) {
+            pastix_print( pastix_data->inter_node_procnum, 0, OUT_LR_SKETCH,
+                          (long)sketch_nbr[0], (long)sketch_nbr[1],
+                          pastix_print_value( sketch_flops[0] ), pastix_print_unit( sketch_flops[0] ),
+                          pastix_print_value( sketch_flops[1] ), pastix_print_unit( sketch_flops[1] ) );
+        }
+    }
+
     pastix_atomic_lock( &lock_flops );
     nbstart = pastix_atomic_dec_32b( &(kernels_trace_started) );
     if ( nbstart > 0 ) {
@@ -240,25 +370,6 @@ kernelsTraceStop( const pastix_data_t *pastix_data )
   end_model:
 #endif
 
-    /* Update the real number of Flops performed */
-    pastix_data->dparm[DPARM_FACT_RLFLOPS] = overall_flops[0] + overall_flops[1] + overall_flops[2];
-
-#if defined(PASTIX_SUPERNODE_STATS)
-    if (pastix_data->iparm[IPARM_VERBOSE] > PastixVerboseNot) {
-        fprintf( stdout,
-                 "    Details of the number of operations:\n"
-                 "      - POTRF(A11) + TRSM(A11, A21): %6.2lf %cFlops\n"
-                 "      - HERK(A21, A22)             : %6.2lf %cFlops\n"
-                 "      - POTRF(A22)                 : %6.2lf %cFlops\n"
-                 "      Total                        : %6.2lf %cFlops\n",
-                 pastix_print_value( overall_flops[0] ), pastix_print_unit( overall_flops[0] ),
-                 pastix_print_value( overall_flops[1] ), pastix_print_unit( overall_flops[1] ),
-                 pastix_print_value( overall_flops[2] ), pastix_print_unit( overall_flops[2] ),
-                 pastix_print_value( pastix_data->dparm[DPARM_FACT_RLFLOPS] ),
-                 pastix_print_unit( pastix_data->dparm[DPARM_FACT_RLFLOPS] ) );
-    }
-#endif /* defined(PASTIX_SUPERNODE_STATS) */
-
     kernels_trace_started = 0;
     pastix_atomic_unlock( &lock_flops );
     (void)pastix_data;
@@ -19,6 +19,7 @@
 #ifndef _kernels_trace_h_
 #define _kernels_trace_h_
 
+#include <pthread.h>
 #include "common.h"
 #include "flops.h"
 
@@ -129,20 +130,83 @@ typedef enum pastix_ktype2_e {
 #define PastixKernelsNbr (PastixKernelLvl0Nbr + PastixKernelLvl1Nbr + PastixKernelLvl2Nbr)
 
 /**
- * @brief Global array to store the number of flops executed per kernel
+ * @brief Statistics of the kernels executed by one thread of an instance
+ *
+ * Each thread of the internal scheduler of an instance accumulates in its own
+ * structure, padded to two cache lines, such that neither the threads nor the
+ * concurrent instances share the counters.
+ */
+typedef struct kernels_trace_s {
+    double       flops[3];        /**< Number of flops performed per level of the elimination tree */
+    double       lock_wait;       /**< Time spent waiting for the update locks                      */
+    pastix_int_t lock_contended;  /**< Number of update locks that were found already taken         */
+    pastix_int_t sketch_nbr;      /**< Number of blocks tested by the compressibility sketch        */
+    pastix_int_t sketch_rejected; /**< Number of blocks rejected by the compressibility sketch      */
+    double       sketch_flops;    /**< Number of flops spent in the compressibility sketches        */
+    double       sketch_saved;    /**< Number of flops of the compressions avoided by the sketches  */
+    char         padding[128 - 6 * sizeof(double) - 3 * sizeof(pastix_int_t)];
+} kernels_trace_t;
+
+/**
+ * @brief Key to the kernels_trace_t structure of the calling thread
+ */
+extern pthread_key_t kernels_trace_key;
+
+/**
+ * @brief Set to 1 once kernels_trace_key has been created
  */
-extern volatile double kernels_flops[PastixKernelLvl1Nbr];
+extern volatile int kernels_trace_keyed;
 
 /**
- * @brief Lock to accumulate flops
+ * @brief Lock to accumulate flops from the threads that are not attached to an
+ * instance
  */
 extern pastix_atomic_lock_t lock_flops;
 
 /**
- * @brief Overall number of flops
+ * @brief Overall number of flops of the threads that are not attached to an
+ * instance
  */
 extern double overall_flops[3];
 
+/**
+ * @brief Lock the whole facing cblk instead of the facing block when
+ * accumulating updates (set from IPARM_UPDATE_LOCK_CBLK by the first of the
+ * concurrent factorizations)
+ */
+extern int kernels_lock_cblk;
+
+/**
+ * @brief Mode of application of the updates between two 1D cblks (set from
+ * IPARM_UPDATE_MODE by the first of the concurrent factorizations)
+ */
+extern int kernels_update_mode;
+
+/**
+ * @brief Overall time spent waiting for the update locks by the threads that
+ * are not attached to an instance
+ */
+extern double kernels_lock_wait;
+
+/**
+ * @brief Number of update locks that were found already taken by the threads
+ * that are not attached to an instance
+ */
+extern pastix_int_t kernels_lock_contended;
+
+/**
+ * @brief Statistics of the compressibility sketches of the threads that are
+ * not attached to an instance: number of tests and of rejected blocks
+ */
+extern pastix_int_t kernels_sketch_nbr[2];
+
+/**
+ * @brief Statistics of the compressibility sketches of the threads that are
+ * not attached to an instance: flops of the sketches, and of the compressions
+ * avoided
+ */
+extern double kernels_sketch_flops[2];
+
 #if defined(PASTIX_WITH_EZTRACE)
 
 #include "eztrace_module/kernels_ev_codes.h"
@@ -182,8 +246,129 @@ extern int32_t               model_size;        /**< Size of the model_entries a
 
 #endif
 
-void   kernelsTraceStart( const pastix_data_t *pastix_data );
-double kernelsTraceStop(  const pastix_data_t *pastix_data );
+void   kernelsTraceStart( pastix_data_t *pastix_data );
+double kernelsTraceStop(  pastix_data_t *pastix_data );
+
+/**
+ * @brief Return the statistics structure of the calling thread, or NULL if the
+ * thread is not attached to an instance.
+ */
+static inline kernels_trace_t *
+kernels_trace_get( void )
+{
+    if ( !kernels_trace_keyed ) {
+        return NULL;
+    }
+    return (kernels_trace_t *)pthread_getspecific( kernels_trace_key );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Take the lock protecting the accumulation of an update.
+ *
+ * The lock of the facing block is taken, unless the cblk-level locking has been
+ * requested to compare with the former behavior. The time spent waiting for a
+ * lock already taken is accumulated to report the contention.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] cblklock
+ *          The lock of the facing cblk.
+ *
+ * @param[inout] bloklock
+ *          The lock of the facing block.
+ *
+ *******************************************************************************/
+static inline void
+kernel_update_lock( pastix_atomic_lock_t *cblklock,
+                    pastix_atomic_lock_t *bloklock )
+{
+    pastix_atomic_lock_t *lock = kernels_lock_cblk ? cblklock : bloklock;
+    kernels_trace_t      *trace;
+    double time;
+
+    if ( pastix_atomic_trylock( lock ) ) {
+        return;
+    }
+
+    time = clockGet();
+    pastix_atomic_lock( lock );
+    time = clockGet() - time;
+
+    trace = kernels_trace_get();
+    if ( trace != NULL ) {
+        trace->lock_wait += time;
+        trace->lock_contended++;
+    }
+    else {
+        pastix_atomic_lock( &lock_flops );
+        kernels_lock_wait += time;
+        kernels_lock_contended++;
+        pastix_atomic_unlock( &lock_flops );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Accumulate the statistics of a compressibility sketch.
+ *
+ *******************************************************************************
+ *
+ * @param[in] rejected
+ *          1 if the block was found incompressible, 0 otherwise.
+ *
+ * @param[in] flops
+ *          The number of flops of the sketch.
+ *
+ * @param[in] saved
+ *          The number of flops of the compression avoided.
+ *
+ *******************************************************************************/
+static inline void
+kernel_trace_sketch( int    rejected,
+                     double flops,
+                     double saved )
+{
+    kernels_trace_t *trace = kernels_trace_get();
+
+    if ( trace != NULL ) {
+        trace->sketch_nbr++;
+        trace->sketch_rejected += rejected;
+        trace->sketch_flops    += flops;
+        trace->sketch_saved    += saved;
+    }
+    else {
+        pastix_atomic_lock( &lock_flops );
+        kernels_sketch_nbr[0]++;
+        kernels_sketch_nbr[1]   += rejected;
+        kernels_sketch_flops[0] += flops;
+        kernels_sketch_flops[1] += saved;
+        pastix_atomic_unlock( &lock_flops );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Release the lock taken by kernel_update_lock().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] cblklock
+ *          The lock of the facing cblk.
+ *
+ * @param[inout] bloklock
+ *          The lock of the facing block.
+ *
+ *******************************************************************************/
+static inline void
+kernel_update_unlock( pastix_atomic_lock_t *cblklock,
+                      pastix_atomic_lock_t *bloklock )
+{
+    pastix_atomic_unlock( kernels_lock_cblk ? cblklock : bloklock );
+}
 
 /**
  *******************************************************************************
@@ -286,9 +471,18 @@ kernel_trace_stop( int8_t inlast, pastix_ktype_t ktype, int m, int n, int k, dou
 
 #endif
 
-    pastix_atomic_lock( &lock_flops );
-    overall_flops[inlast] += flops;
-    pastix_atomic_unlock( &lock_flops );
+    {
+        kernels_trace_t *trace = kernels_trace_get();
+
+        if ( trace != NULL ) {
+            trace->flops[inlast] += flops;
+        }
+        else {
+            pastix_atomic_lock( &lock_flops );
+            overall_flops[inlast] += flops;
+            pastix_atomic_unlock( &lock_flops );
+        }
+    }
 
     (void)ktype;
     (void)m;
@@ -15,13 +15,13 @@
  *
  **/
 #include "common.h"
+#include <cblas.h>
+#include <lapacke.h>
 #include "pastix_zlrcores.h"
 #include "pastix_clrcores.h"
 #include "pastix_dlrcores.h"
 #include "pastix_slrcores.h"
-
-double pastix_lr_minratio = 1.0;
-pastix_int_t pastix_lr_ortho = 0;
+#include "models.h"
 
 const char *compmeth_shnames[PastixCompressMethodNbr] = {
     "SVD",
@@ -56,3 +56,310 @@ const fct_rradd_t rraddMethods[PastixCompressMethodNbr][4] =
     { core_srradd_tqrcp, core_drradd_tqrcp, core_crradd_tqrcp, core_zrradd_tqrcp },
     { core_srradd_pqrcp, core_drradd_pqrcp, core_crradd_pqrcp, core_zrradd_pqrcp }
 };
+
+/**
+ *******************************************************************************
+ *
+ * @brief Store the bases of a low-rank matrix in single precision.
+ *
+ * Each column j of u, and the matching row j of v, are first scaled by s and
+ * 1/s, with s chosen to balance their largest entries. The product u v^T is
+ * unchanged, and the entries of both bases get a similar magnitude, away from
+ * the overflow and underflow thresholds of the single precision. The bases are
+ * then converted to the single precision arithmetic of flttype, and v is
+ * stored with a leading dimension of rk.
+ *
+ * The compact matrix is freed by the core_xlrfree() routines, and its bases
+ * are read through core_lrexpand().
+ *
+ *******************************************************************************
+ *
+ * @param[in] flttype
+ *          The arithmetic of the low-rank matrix: PastixDouble or
+ *          PastixComplex64. The matrix is left unchanged in the single
+ *          precision arithmetics.
+ *
+ * @param[in] M
+ *          The number of rows of the matrix A.
+ *
+ * @param[in] N
+ *          The number of columns of the matrix A.
+ *
+ * @param[inout] A
+ *          The low-rank matrix. Nothing is done if A is not stored in low-rank
+ *          form, or if its rank is null.
+ *
+ *******************************************************************************
+ *
+ * @return The number of bases that overflowed the single precision.
+ *
+ *******************************************************************************/
+int
+core_lrcompact( pastix_coeftype_t flttype,
+                pastix_int_t      M,
+                pastix_int_t      N,
+                pastix_lrblock_t *A )
+{
+    pastix_int_t rk = A->rk;
+    pastix_int_t j;
+    size_t eltsize;
+    double nrmu, nrmv, scal;
+    void *u, *v;
+    int   rc = 0;
+
+    if ( (rk <= 0) ||
+         ((flttype != PastixDouble) && (flttype != PastixComplex64)) )
+    {
+        return 0;
+    }
+
+    for ( j = 0; j < rk; j++ ) {
+        if ( flttype == PastixComplex64 ) {
+            pastix_complex64_t *uj = (pastix_complex64_t*)(A->u) + j * M;
+            pastix_complex64_t *vj = (pastix_complex64_t*)(A->v) + j;
+
+            nrmu = cabs( uj[ cblas_izamax( M, uj, 1 ) ] );
+            nrmv = cabs( vj[ cblas_izamax( N, vj, A->rkmax ) * A->rkmax ] );
+            if ( (nrmu > 0.) && (nrmv > 0.) ) {
+                scal = sqrt( nrmv / nrmu );
+                cblas_zdscal( M, scal,      uj, 1 );
+                cblas_zdscal( N, 1. / scal, vj, A->rkmax );
+            }
+        }
+        else {
+            double *uj = (double*)(A->u) + j * M;
+            double *vj = (double*)(A->v) + j;
+
+            nrmu = fabs( uj[ cblas_idamax( M, uj, 1 ) ] );
+            nrmv = fabs( vj[ cblas_idamax( N, vj, A->rkmax ) * A->rkmax ] );
+            if ( (nrmu > 0.) && (nrmv > 0.) ) {
+                scal = sqrt( nrmv / nrmu );
+                cblas_dscal( M, scal,      uj, 1 );
+                cblas_dscal( N, 1. / scal, vj, A->rkmax );
+            }
+        }
+    }
+
+    eltsize = pastix_size_of( flttype ) / 2;
+
+#if defined(PASTIX_DEBUG_LR)
+    u = malloc( M * rk * eltsize );
+    v = malloc( N * rk * eltsize );
+#else
+    u = malloc( (M+N) * rk * eltsize );
+    v = (char*)u + M * rk * eltsize;
+#endif
+
+    if ( flttype == PastixComplex64 ) {
+        rc += LAPACKE_zlag2c_work( LAPACK_COL_MAJOR, M, rk, A->u, M,        u, M  );
+        rc += LAPACKE_zlag2c_work( LAPACK_COL_MAJOR, rk, N, A->v, A->rkmax, v, rk );
+    }
+    else {
+        rc += LAPACKE_dlag2s_work( LAPACK_COL_MAJOR, M, rk, A->u, M,        u, M  );
+        rc += LAPACKE_dlag2s_work( LAPACK_COL_MAJOR, rk, N, A->v, A->rkmax, v, rk );
+    }
+
+    free( A->u );
+#if defined(PASTIX_DEBUG_LR)
+    free( A->v );
+#endif
+    A->rkmax = rk;
+    A->u     = u;
+    A->v     = v;
+
+    return rc;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Convert back the single precision bases of a low-rank matrix.
+ *
+ * The bases of a matrix compacted by core_lrcompact() are converted to the
+ * working precision in the buffers provided by the caller, that can then be
+ * used as the u and v fields of a low-rank matrix of rank A->rk with a leading
+ * dimension A->rk.
+ *
+ *******************************************************************************
+ *
+ * @param[in] flttype
+ *          The working arithmetic: PastixDouble or PastixComplex64.
+ *
+ * @param[in] M
+ *          The number of rows of the matrix A.
+ *
+ * @param[in] N
+ *          The number of columns of the matrix A.
+ *
+ * @param[in] A
+ *          The compact low-rank matrix.
+ *
+ * @param[out] u
+ *          Array of size M-by-A->rk of the working arithmetic. On exit, the u
+ *          basis of A.
+ *
+ * @param[out] v
+ *          Array of size A->rk-by-N of the working arithmetic. On exit, the v
+ *          basis of A.
+ *
+ *******************************************************************************/
+void
+core_lrexpand( pastix_coeftype_t       flttype,
+               pastix_int_t            M,
+               pastix_int_t            N,
+               const pastix_lrblock_t *A,
+               void                   *u,
+               void                   *v )
+{
+    assert( A->rk > 0 );
+    assert( A->rkmax == A->rk );
+
+    if ( flttype == PastixComplex64 ) {
+        LAPACKE_clag2z_work( LAPACK_COL_MAJOR, M, A->rk, A->u, M,     u, M     );
+        LAPACKE_clag2z_work( LAPACK_COL_MAJOR, A->rk, N, A->v, A->rk, v, A->rk );
+    }
+    else {
+        assert( flttype == PastixDouble );
+        LAPACKE_slag2d_work( LAPACK_COL_MAJOR, M, A->rk, A->u, M,     u, M     );
+        LAPACKE_slag2d_work( LAPACK_COL_MAJOR, A->rk, N, A->v, A->rk, v, A->rk );
+    }
+}
+
+/**
+ * @brief Largest number of entries of a block compressed with the SVD by the
+ * compression policy.
+ */
+#define PASTIX_LRPOLICY_SVD_MAX (64 * 64)
+
+/**
+ *******************************************************************************
+ *
+ * @brief Estimate the time of the update of a block with the GEMM model.
+ *
+ * The block receives a contribution of width K. In full-rank, it is a single
+ * GEMM. In low-rank, the contribution of rank rk is formed, and added to the
+ * block of rank rk with the recompression of the core_xrradd() routines: the
+ * orthogonalization of the M-by-2rk and N-by-2rk concatenated bases, and the
+ * product of the bases by the rk singular vectors kept.
+ *
+ *******************************************************************************/
+static inline void
+core_lrpolicy_cost( const double *coefs,
+                    pastix_int_t  M,
+                    pastix_int_t  N,
+                    pastix_int_t  K,
+                    pastix_int_t  rk,
+                    double       *costfr,
+                    double       *costlr )
+{
+    *costfr = modelsGetCost3Param( coefs, M, N, K );
+    *costlr = modelsGetCost3Param( coefs, rk,   rk,   K      )
+        +     modelsGetCost3Param( coefs, M,    2*rk, 2*rk   )
+        +     modelsGetCost3Param( coefs, N,    2*rk, 2*rk   )
+        +     modelsGetCost3Param( coefs, M,    rk,   2*rk   )
+        +     modelsGetCost3Param( coefs, N,    rk,   2*rk   );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Select the compression of a block from its dimensions and its rank
+ * history.
+ *
+ * The rank observed at the last compression of the block, in a previous
+ * factorization with the same structure, is used as the prediction of its
+ * rank. Without history, half of the rank limit of the strategy is used as
+ * the prediction, such that the block is compressed only if the cost models
+ * show a gain with a rank that is still far from incompressible:
+ *   - If the block was kept in full-rank in the previous factorization, it
+ *     stays in full-rank in this one, and it is tried again in the next one
+ *     with the prediction of a block without history.
+ *   - If the predicted rank is larger than the rank limit of the strategy, the
+ *     block stays in full-rank.
+ *   - If the updates of the block with its predicted rank are slower than the
+ *     full-rank updates, following the GEMM model of lowrank->policy_coefs, or
+ *     the number of flops if no model is given, it stays in full-rank.
+ *   - Otherwise, the small blocks are compressed with the SVD that gives the
+ *     smallest rank at a negligible cost, the blocks of very small ranks with
+ *     TQRCP, the blocks of small ranks with RQRCP whose random sampling then
+ *     pays off, and the others with PQRCP.
+ *
+ *******************************************************************************
+ *
+ * @param[in] lowrank
+ *          The low-rank parameters.
+ *
+ * @param[in] M
+ *          The number of rows of the block.
+ *
+ * @param[in] N
+ *          The number of columns of the block.
+ *
+ * @param[in] K
+ *          The average width of the updates received by the block (see
+ *          SolverCblk::updtwdth).
+ *
+ * @param[inout] rkhist
+ *          On entry, the rank of the block at its last compression, -1 if it
+ *          was kept in full-rank in the previous factorization, -2 if it was
+ *          never compressed, and -3 if it was kept in full-rank two
+ *          factorizations ago. On exit, -1 if the block is kept in full-rank
+ *          by the policy, -3 if it was kept in full-rank in the previous
+ *          factorization, unchanged otherwise.
+ *
+ *******************************************************************************
+ *
+ * @return The compression method to use, or -1 if the block must stay in
+ *         full-rank.
+ *
+ *******************************************************************************/
+int
+core_lrpolicy( const pastix_lr_t *lowrank,
+               pastix_int_t       M,
+               pastix_int_t       N,
+               pastix_int_t       K,
+               int32_t           *rkhist )
+{
+    static const double flops_coefs[8] = { 0., 0., 0., 0., 0., 0., 0., 2. };
+    const double *coefs   = lowrank->policy_coefs;
+    pastix_int_t  minMN   = pastix_imin( M, N );
+    pastix_int_t  rklimit = core_get_rklimit( lowrank, M, N );
+    pastix_int_t  rk      = *rkhist;
+    double        costfr, costlr;
+
+    /* Kept in full-rank in the previous factorization, retried in the next one */
+    if ( rk == -1 ) {
+        *rkhist = -3;
+        return -1;
+    }
+
+    /* No usable history, the rank is predicted from the rank limit */
+    if ( rk < 0 ) {
+        rk = rklimit / 2;
+    }
+
+    if ( (rk > rklimit) || (rklimit <= 0) ) {
+        *rkhist = -1;
+        return -1;
+    }
+
+    if ( (coefs == NULL) || (coefs[7] <= 0.) ) {
+        coefs = flops_coefs;
+    }
+    core_lrpolicy_cost( coefs, M, N, K, rk, &costfr, &costlr );
+    if ( costlr >= costfr ) {
+        *rkhist = -1;
+        return -1;
+    }
+
+    if ( (M * N) <= PASTIX_LRPOLICY_SVD_MAX ) {
+        return PastixCompressMethodSVD;
+    }
+    if ( (32 * rk) <= minMN ) {
+        return PastixCompressMethodTQRCP;
+    }
+    if ( (8 * rk) <= minMN ) {
+        return PastixCompressMethodRQRCP;
+    }
+    return PastixCompressMethodPQRCP;
+}
@@ -50,59 +50,14 @@ extern const char *compmeth_lgnames[PastixCompressMethodNbr];
  */
 #define PASTIX_LRM3_TRANSB (1 << 3)
 
-/**
- * @brief Define the minimal ratio for which we accept to compress a matrix into a low-rank form or not.
- * @sa core_get_rklimit()
- */
-extern double pastix_lr_minratio;
-
-/**
- * @brief Define the orthogonalization method.
- */
-extern pastix_int_t pastix_lr_ortho;
-
-/**
- * @brief Compute the maximal rank accepted for a given matrix size for testings
- * @param[in] M The number of rows of the matrix
- * @param[in] N The number of columns of the matrix
- * @return The maximal rank accepted for this matrix size.
- */
-static inline pastix_int_t
-core_get_rklimit_max( pastix_int_t M, pastix_int_t N ) {
-    return pastix_imin( M, N );
-}
-
-/**
- * @brief Compute the maximal rank accepted for a given matrix size for Just-In-Time strategy
- * @param[in] M The number of rows of the matrix
- * @param[in] N The number of columns of the matrix
- * @return The maximal rank accepted for this matrix size.
- */
-static inline pastix_int_t
-core_get_rklimit_end( pastix_int_t M, pastix_int_t N ) {
-    return ( pastix_lr_minratio * pastix_imin( M, N ) ) / 4;
-}
+struct pastix_lr_s;
+typedef struct pastix_lr_s pastix_lr_t;
 
 /**
- * @brief Compute the maximal rank accepted for a given matrix size for Minimal-Memory strategy
- * @param[in] M The number of rows of the matrix
- * @param[in] N The number of columns of the matrix
- * @return The maximal rank accepted for this matrix size.
+ * @brief Type of the functions to compute the maximal rank accepted for a
+ * given matrix size.
  */
-static inline pastix_int_t
-core_get_rklimit_begin( pastix_int_t M, pastix_int_t N ) {
-    return ( pastix_lr_minratio * M * N ) / ( M + N );
-}
-
-static inline pastix_int_t
-core_get_rklimit_test( pastix_int_t M, pastix_int_t N ) {
-    return pastix_imin( M, N );
-}
-
-extern pastix_int_t (*core_get_rklimit)( pastix_int_t, pastix_int_t );
-
-struct pastix_lr_s;
-typedef struct pastix_lr_s pastix_lr_t;
+typedef pastix_int_t (*fct_rklimit_t)( const pastix_lr_t *, pastix_int_t, pastix_int_t );
 
 /**
  * @brief The block low-rank structure to hold a matrix in low-rank form
@@ -117,7 +72,7 @@ typedef struct pastix_lrblock_s {
 /**
  * @brief Type of the functions to compress a dense block into a low-rank form.
  */
-typedef pastix_fixdbl_t (*fct_ge2lr_t)( int, pastix_fixdbl_t, pastix_int_t, pastix_int_t, pastix_int_t,
+typedef pastix_fixdbl_t (*fct_ge2lr_t)( const pastix_lr_t *, int, pastix_fixdbl_t, pastix_int_t, pastix_int_t, pastix_int_t,
                                         const void *, pastix_int_t, pastix_lrblock_t * );
 
 /**
@@ -150,10 +105,80 @@ typedef struct pastix_lr_s {
     int                      compress_preselect;  /**< Enable/disable the compression of preselected blocks */
     int                      use_reltol;          /**< Enable/disable relative tolerance vs absolute one    */
     double                   tolerance;           /**< Absolute compression tolerance                       */
+    double                   compress_min_ratio;  /**< Minimal ratio to accept a low-rank form              */
+    pastix_int_t             compress_ortho;      /**< Orthogonalization method of the recompression        */
+    int                      compress_lowprec;    /**< Enable/disable the single precision low-rank bases   */
+    int                      compress_policy;     /**< Enable/disable the per-block compression policy      */
+    const double            *policy_coefs;        /**< GEMM model coefficients used by the policy, or NULL  */
+    int                      use_sketch;          /**< Enable/disable the compressibility sketch of QRCP    */
     fct_rradd_t              core_rradd;          /**< Recompression function                               */
     fct_ge2lr_t              core_ge2lr;          /**< Compression function                                 */
+    fct_rklimit_t            core_rklimit;        /**< Maximal rank function                                */
 } pastix_lr_t;
 
+/**
+ * @brief Compute the maximal rank accepted for a given matrix size for testings
+ * @param[in] lowrank The low-rank parameters
+ * @param[in] M The number of rows of the matrix
+ * @param[in] N The number of columns of the matrix
+ * @return The maximal rank accepted for this matrix size.
+ */
+static inline pastix_int_t
+core_get_rklimit_max( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N ) {
+    (void)lowrank;
+    return pastix_imin( M, N );
+}
+
+/**
+ * @brief Compute the maximal rank accepted for a given matrix size for Just-In-Time strategy
+ * @param[in] lowrank The low-rank parameters
+ * @param[in] M The number of rows of the matrix
+ * @param[in] N The number of columns of the matrix
+ * @return The maximal rank accepted for this matrix size.
+ */
+static inline pastix_int_t
+core_get_rklimit_end( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N ) {
+    return ( lowrank->compress_min_ratio * pastix_imin( M, N ) ) / 4;
+}
+
+/**
+ * @brief Compute the maximal rank accepted for a given matrix size for Minimal-Memory strategy
+ * @param[in] lowrank The low-rank parameters
+ * @param[in] M The number of rows of the matrix
+ * @param[in] N The number of columns of the matrix
+ * @return The maximal rank accepted for this matrix size.
+ */
+static inline pastix_int_t
+core_get_rklimit_begin( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N ) {
+    return ( lowrank->compress_min_ratio * M * N ) / ( M + N );
+}
+
+static inline pastix_int_t
+core_get_rklimit_test( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N ) {
+    (void)lowrank;
+    return pastix_imin( M, N );
+}
+
+/**
+ * @brief Compute the maximal rank accepted for a given matrix size with the
+ * strategy of the low-rank parameters.
+ * @param[in] lowrank The low-rank parameters
+ * @param[in] M The number of rows of the matrix
+ * @param[in] N The number of columns of the matrix
+ * @return The maximal rank accepted for this matrix size.
+ */
+static inline pastix_int_t
+core_get_rklimit( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N ) {
+    return lowrank->core_rklimit( lowrank, M, N );
+}
+
+int  core_lrcompact( pastix_coeftype_t flttype, pastix_int_t M, pastix_int_t N,
+                     pastix_lrblock_t *A );
+void core_lrexpand ( pastix_coeftype_t flttype, pastix_int_t M, pastix_int_t N,
+                     const pastix_lrblock_t *A, void *u, void *v );
+int  core_lrpolicy ( const pastix_lr_t *lowrank, pastix_int_t M, pastix_int_t N,
+                     pastix_int_t K, int32_t *rkhist );
+
 /**
  * @brief Enum to define the type of block.
  */
@@ -20,6 +20,9 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 #define pastix_cblk_lock( cblk_ )    pastix_atomic_lock( &((cblk_)->lock) )
 #define pastix_cblk_unlock( cblk_ )  pastix_atomic_unlock( &((cblk_)->lock) )
+#define pastix_blok_lock( cblk_, blok_ )    kernel_update_lock(   &((cblk_)->lock), &((blok_)->lock) )
+#define pastix_blok_unlock( cblk_, blok_ )  kernel_update_unlock( &((cblk_)->lock), &((blok_)->lock) )
+#define pastix_blok_lockptr( cblk_, blok_ ) ( kernels_lock_cblk ? &((cblk_)->lock) : &((blok_)->lock) )
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
 
 /**
@@ -222,6 +225,10 @@ void cpucblk_zfillin  ( pastix_coefside_t    side,
                         const SolverMatrix  *solvmtx,
                         const pastix_bcsc_t *bcsc,
                         pastix_int_t         itercblk );
+void cpucblk_zrefill  ( pastix_coefside_t    side,
+                        const SolverMatrix  *solvmtx,
+                        const pastix_bcsc_t *bcsc,
+                        pastix_int_t         itercblk );
 void cpucblk_zinit    ( pastix_coefside_t    side,
                         const SolverMatrix  *solvmtx,
                         const pastix_bcsc_t *bcsc,
@@ -289,13 +296,16 @@ void cpucblk_zrecv_rhs_backward( const SolverMatrix *solvmtx,
  */
 pastix_fixdbl_t cpublok_zcompress( const pastix_lr_t *lowrank,
                                    pastix_coefside_t coef,
-                                   pastix_int_t M, pastix_int_t N,
+                                   pastix_int_t M, pastix_int_t N, pastix_int_t K,
                                    SolverBlok *blok );
 pastix_int_t cpucblk_zcompress( const SolverMatrix *solvmtx,
                                 pastix_coefside_t   side,
                                 SolverCblk         *cblk );
 void         cpucblk_zuncompress( pastix_coefside_t side,
                                   SolverCblk       *cblk );
+int          cpucblk_zlrcompact ( const SolverMatrix *solvmtx,
+                                  pastix_coefside_t   side,
+                                  SolverCblk         *cblk );
 void         cpucblk_zmemory    ( pastix_coefside_t  side,
                                   SolverMatrix      *solvmtx,
                                   SolverCblk        *cblk,
@@ -324,6 +334,7 @@ void solve_cblk_ztrsmsp_forward( pastix_solv_mode_t mode, pastix_side_t side, pa
                                  pastix_trans_t trans, pastix_diag_t diag,
                                  const SolverMatrix *datacode, const SolverCblk *cblk,
                                  int nrhs, pastix_complex64_t *b, int ldb );
+void solve_cblk_ztrsmsp_fwdfacto( const SolverMatrix *datacode, const SolverCblk *cblk );
 void solve_cblk_ztrsmsp_backward( pastix_solv_mode_t mode, pastix_side_t side, pastix_uplo_t uplo,
                                   pastix_trans_t trans, pastix_diag_t diag,
                                   const SolverMatrix *datacode, SolverCblk *cblk,
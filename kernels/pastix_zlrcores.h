@@ -226,7 +226,7 @@ pastix_fixdbl_t core_zlrmm( core_zlrmm_t *params );
  *    @{
  */
 
-pastix_fixdbl_t core_zge2lr_svd( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+pastix_fixdbl_t core_zge2lr_svd( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                  pastix_int_t m, pastix_int_t n,
                                  const void *Avoid, pastix_int_t lda, pastix_lrblock_t *Alr );
 pastix_fixdbl_t core_zrradd_svd( const pastix_lr_t *lowrank, pastix_trans_t transA1, const void *alphaptr,
@@ -265,7 +265,7 @@ typedef int (*core_zrrqr_rt_t)( double tol, pastix_int_t maxrank, pastix_int_t n
  *    @{
  */
 
-pastix_fixdbl_t core_zge2lr_pqrcp( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+pastix_fixdbl_t core_zge2lr_pqrcp( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                    pastix_int_t m, pastix_int_t n,
                                    const void *Avoid, pastix_int_t lda, pastix_lrblock_t *Alr );
 pastix_fixdbl_t core_zrradd_pqrcp( const pastix_lr_t *lowrank, pastix_trans_t transA1, const void *alphaptr,
@@ -273,7 +273,7 @@ pastix_fixdbl_t core_zrradd_pqrcp( const pastix_lr_t *lowrank, pastix_trans_t tr
                                    pastix_int_t M2, pastix_int_t N2,       pastix_lrblock_t *B,
                                    pastix_int_t offx, pastix_int_t offy );
 
-pastix_fixdbl_t core_zge2lr_rqrcp( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+pastix_fixdbl_t core_zge2lr_rqrcp( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                    pastix_int_t m, pastix_int_t n,
                                    const void *Avoid, pastix_int_t lda, pastix_lrblock_t *Alr );
 pastix_fixdbl_t core_zrradd_rqrcp( const pastix_lr_t *lowrank, pastix_trans_t transA1, const void *alphaptr,
@@ -281,7 +281,7 @@ pastix_fixdbl_t core_zrradd_rqrcp( const pastix_lr_t *lowrank, pastix_trans_t tr
                                    pastix_int_t M2, pastix_int_t N2,       pastix_lrblock_t *B,
                                    pastix_int_t offx, pastix_int_t offy );
 
-pastix_fixdbl_t core_zge2lr_tqrcp( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+pastix_fixdbl_t core_zge2lr_tqrcp( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                    pastix_int_t m, pastix_int_t n,
                                    const void *Avoid, pastix_int_t lda, pastix_lrblock_t *Alr );
 pastix_fixdbl_t core_zrradd_tqrcp( const pastix_lr_t *lowrank, pastix_trans_t transA1, const void *alphaptr,
@@ -289,18 +289,23 @@ pastix_fixdbl_t core_zrradd_tqrcp( const pastix_lr_t *lowrank, pastix_trans_t tr
                                    pastix_int_t M2, pastix_int_t N2,       pastix_lrblock_t *B,
                                    pastix_int_t offx, pastix_int_t offy );
 
-pastix_fixdbl_t core_zge2lr_rqrrt( int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+pastix_fixdbl_t core_zge2lr_rqrrt( const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                    pastix_int_t m, pastix_int_t n,
                                    const void *Avoid, pastix_int_t lda, pastix_lrblock_t *Alr );
 
 
+int core_zlrsketch( double tol, pastix_int_t rklimit,
+                    pastix_int_t m, pastix_int_t n,
+                    const pastix_complex64_t *A, pastix_int_t lda,
+                    pastix_fixdbl_t *flops );
+
 pastix_fixdbl_t core_zge2lr_qrcp( core_zrrqr_cp_t rrqrfct,
-                                  int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+                                  const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                   pastix_int_t m, pastix_int_t n,
                                   const void *Avoid, pastix_int_t lda,
                                   pastix_lrblock_t *Alr );
 pastix_fixdbl_t core_zge2lr_qrrt( core_zrrqr_rt_t rrqrfct,
-                                  int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
+                                  const pastix_lr_t *lowrank, int use_reltol, pastix_fixdbl_t tol, pastix_int_t rklimit,
                                   pastix_int_t m, pastix_int_t n,
                                   const void *Avoid, pastix_int_t lda,
                                   pastix_lrblock_t *Alr);
@@ -346,6 +346,262 @@ pqueuePrint(const pastix_queue_t *q)
     fprintf(stderr, "\n");
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Allocate a circular array for the work-stealing deque.
+ *
+ *******************************************************************************
+ *
+ * @param[in] size
+ *          The number of elements of the array. Must be a power of 2.
+ *
+ *******************************************************************************
+ *
+ * @return The allocated array.
+ *
+ *******************************************************************************/
+static inline pastix_deque_array_t *
+pdequeArrayInit( int64_t size )
+{
+    pastix_deque_array_t *array;
+
+    MALLOC_INTERN( array, 1, pastix_deque_array_t );
+    MALLOC_INTERN( array->elttab, size, pastix_int_t );
+    array->size = size;
+    array->prev = NULL;
+    return array;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Initialize the work-stealing deque with an initial space to store the
+ * elements.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] d
+ *          The allocated pointer to the deque to initialize.
+ *
+ * @param[in] size
+ *          The initial size for the deque. It is rounded up to the next power
+ *          of 2.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS if success.
+ *
+ *******************************************************************************/
+int
+pdequeInit( pastix_deque_t *d,
+            pastix_int_t    size )
+{
+    int64_t asize = 16;
+
+    while ( asize < size ) {
+        asize *= 2;
+    }
+
+    d->top    = 0;
+    d->bottom = 0;
+    d->array  = pdequeArrayInit( asize );
+    return PASTIX_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Free the structure associated to the work-stealing deque.
+ *
+ * This function must be called only once all the threads are done with the
+ * deque.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] d
+ *          The pointer to the deque to free.
+ *
+ *******************************************************************************/
+void
+pdequeExit( pastix_deque_t *d )
+{
+    pastix_deque_array_t *array = d->array;
+    pastix_deque_array_t *prev;
+
+    while( array != NULL ) {
+        prev = array->prev;
+        memFree_null( array->elttab );
+        memFree( array );
+        array = prev;
+    }
+    d->array  = NULL;
+    d->top    = 0;
+    d->bottom = 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Return the number of elements in the work-stealing deque.
+ *
+ * The returned value is only an estimate if other threads are working on the
+ * deque.
+ *
+ *******************************************************************************
+ *
+ * @param[in] d
+ *          The pointer to the deque.
+ *
+ *******************************************************************************
+ *
+ * @return The number of elements in the deque.
+ *
+ *******************************************************************************/
+pastix_int_t
+pdequeSize( const pastix_deque_t *d )
+{
+    int64_t size = d->bottom - d->top;
+    return (size > 0) ? size : 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Push an element at the bottom of the work-stealing deque.
+ *
+ * This function must only be called by the owner of the deque. If the deque is
+ * full, the circular array is doubled. The previous array is kept alive until
+ * pdequeExit() since thieves may still be reading from it.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] d
+ *          The pointer to the deque.
+ *
+ * @param[in] elt
+ *          The element to insert.
+ *
+ *******************************************************************************/
+void
+pdequePush( pastix_deque_t *d,
+            pastix_int_t    elt )
+{
+    pastix_deque_array_t *array = d->array;
+    int64_t b = d->bottom;
+    int64_t t = d->top;
+
+    if ( (b - t) >= (array->size - 1) ) {
+        pastix_deque_array_t *newarray = pdequeArrayInit( 2 * array->size );
+        int64_t i;
+
+        for( i=t; i<b; i++ ) {
+            newarray->elttab[ i & (newarray->size - 1) ] = array->elttab[ i & (array->size - 1) ];
+        }
+        newarray->prev = array;
+        pastix_mfence();
+        d->array = newarray;
+        array = newarray;
+    }
+
+    array->elttab[ b & (array->size - 1) ] = elt;
+    pastix_mfence();
+    d->bottom = b + 1;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Pop the last pushed element of the work-stealing deque.
+ *
+ * This function must only be called by the owner of the deque. A
+ * compare-and-swap is only required when a single element remains to solve the
+ * conflict with the thieves.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] d
+ *          The pointer to the deque.
+ *
+ *******************************************************************************
+ *
+ * @return The element at the bottom of the deque, -1 if the deque is empty.
+ *
+ *******************************************************************************/
+pastix_int_t
+pdequePop( pastix_deque_t *d )
+{
+    pastix_deque_array_t *array = d->array;
+    pastix_int_t elt = -1;
+    int64_t b = d->bottom - 1;
+    int64_t t;
+
+    d->bottom = b;
+    pastix_mfence();
+    t = d->top;
+
+    if ( t > b ) {
+        /* The deque was empty */
+        d->bottom = b + 1;
+        return -1;
+    }
+
+    elt = array->elttab[ b & (array->size - 1) ];
+    if ( t == b ) {
+        /* Last element: race with the thieves */
+        if ( !pastix_atomic_cas_64b( (volatile uint64_t*)&(d->top),
+                                     (uint64_t)t, (uint64_t)(t+1) ) )
+        {
+            elt = -1;
+        }
+        d->bottom = b + 1;
+    }
+    return elt;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Steal the oldest element of the work-stealing deque.
+ *
+ * This function can be called by any thread.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] d
+ *          The pointer to the deque.
+ *
+ *******************************************************************************
+ *
+ * @return The element at the top of the deque, -1 if the deque is empty or if
+ *         the element has been taken by another thread.
+ *
+ *******************************************************************************/
+pastix_int_t
+pdequeSteal( pastix_deque_t *d )
+{
+    pastix_deque_array_t *array;
+    pastix_int_t elt;
+    int64_t t = d->top;
+    int64_t b;
+
+    pastix_mfence();
+    b = d->bottom;
+
+    if ( t >= b ) {
+        return -1;
+    }
+
+    array = d->array;
+    elt = array->elttab[ t & (array->size - 1) ];
+    if ( !pastix_atomic_cas_64b( (volatile uint64_t*)&(d->top),
+                                 (uint64_t)t, (uint64_t)(t+1) ) )
+    {
+        return -1;
+    }
+    return elt;
+}
+
 /**
  *@}
  */
@@ -41,6 +41,29 @@ typedef struct pastix_queue_s {
     pastix_atomic_lock_t  lock;   /**< Lock for insertion and removal in shared memory */
 } pastix_queue_t;
 
+/**
+ * @brief Circular array used to store the elements of a work-stealing deque.
+ */
+typedef struct pastix_deque_array_s {
+    int64_t                      size;   /**< Number of elements that can be stored (power of 2) */
+    pastix_int_t                *elttab; /**< Array of the elements                              */
+    struct pastix_deque_array_s *prev;   /**< Previous (smaller) array kept alive for thieves    */
+} pastix_deque_array_t;
+
+/**
+ * @brief Work-stealing deque structure.
+ *
+ * Chase-Lev deque: the owner thread pushes and pops at the bottom without any
+ * lock, while the other threads steal from the top with a single
+ * compare-and-swap.
+ */
+typedef struct pastix_deque_s {
+    volatile int64_t               top;     /**< Index of the next element to steal            */
+    char                           pad[56]; /**< Keep top and bottom on separate cache lines   */
+    volatile int64_t               bottom;  /**< Index of the next free slot for the owner     */
+    pastix_deque_array_t * volatile array;  /**< Current circular array                        */
+} pastix_deque_t;
+
 int          pqueueInit(        pastix_queue_t *, pastix_int_t );
 void         pqueueExit(        pastix_queue_t * );
 pastix_int_t pqueueSize(  const pastix_queue_t * );
@@ -50,6 +73,13 @@ pastix_int_t pqueueRead ( const pastix_queue_t * );
 pastix_int_t pqueuePop2 (       pastix_queue_t *, double *, double * );
 void         pqueuePrint( const pastix_queue_t * );
 
+int          pdequeInit (       pastix_deque_t *, pastix_int_t );
+void         pdequeExit (       pastix_deque_t * );
+pastix_int_t pdequeSize ( const pastix_deque_t * );
+void         pdequePush (       pastix_deque_t *, pastix_int_t );
+pastix_int_t pdequePop  (       pastix_deque_t * );
+pastix_int_t pdequeSteal(       pastix_deque_t * );
+
 /**
  * @brief Push an element with a single key.
  * @param[inout] q
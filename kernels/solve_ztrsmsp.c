@@ -28,6 +28,59 @@ static pastix_complex64_t  zone =  1.0;
 static pastix_complex64_t mzone = -1.0;
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
 
+/**
+ *******************************************************************************
+ *
+ * @brief Release the dependency of a solve update on the facing cblk.
+ *
+ * The contribution counter of fcbk is decremented, and if all its
+ * contributions have been applied, fcbk is pushed in the ready queue of the
+ * thread working on cblk when the dynamic scheduler is used.
+ *
+ *******************************************************************************
+ *
+ * @param[in] mode
+ *          Specify whether the schur complement and interface are applied to
+ *          the right-hand-side. Cblks of the Schur complement are never
+ *          pushed if mode is not PastixSolvModeSchur.
+ *
+ * @param[in] datacode
+ *          The SolverMatrix structure from PaStiX.
+ *
+ * @param[in] cblk
+ *          The column block that contributes to fcbk.
+ *
+ * @param[inout] fcbk
+ *          The facing column block that is updated by cblk.
+ *
+ * @param[in] key
+ *          The priority of fcbk in the ready queue (smallest first).
+ *
+ *******************************************************************************/
+static inline void
+solve_cblk_zrelease_deps( pastix_solv_mode_t  mode,
+                          const SolverMatrix *datacode,
+                          const SolverCblk   *cblk,
+                          SolverCblk         *fcbk,
+                          double              key )
+{
+    int32_t ctrbcnt;
+    ctrbcnt = cblk_ctrbcnt_dec( fcbk );
+    if ( ctrbcnt ) {
+        return;
+    }
+    if ( (fcbk->cblktype & CBLK_IN_SCHUR) && (mode != PastixSolvModeSchur) ) {
+        return;
+    }
+
+    if ( datacode->computeDeque ) {
+        pdequePush( datacode->computeDeque[ cblk->threadid ], fcbk - datacode->cblktab );
+    }
+    else if ( datacode->computeQueue ) {
+        pqueuePush1( datacode->computeQueue[ cblk->threadid ], fcbk - datacode->cblktab, key );
+    }
+}
+
 /**
  *******************************************************************************
  *
@@ -104,6 +157,10 @@ solve_blok_ztrsm( pastix_coefside_t   coefside,
  *
  * @brief Apply a solve gemm update related to a single block of the matrix A.
  *
+ * If the low-rank bases of the block are stored in single precision
+ * (IPARM_COMPRESS_LOWPREC), they are converted back in the workspace of the
+ * update.
+ *
  *******************************************************************************
  *
  * @param[in] coefside
@@ -164,7 +221,7 @@ solve_blok_zgemm( pastix_coefside_t         coefside,
                   pastix_int_t              ldc )
 {
     pastix_int_t        m, n, lda;
-    pastix_lrblock_t   *lrA;
+    pastix_lrblock_t   *lrA, lrexp;
     pastix_complex64_t *A;
     pastix_int_t        offB, offC;
     const SolverCblk   *bowner;
@@ -230,7 +287,22 @@ solve_blok_zgemm( pastix_coefside_t         coefside,
             pastix_cblk_unlock( fcbk );
             break;
         default:
-            MALLOC_INTERN( tmp, lrA->rk * nrhs, pastix_complex64_t);
+            /* Convert back the single precision bases behind the workspace */
+            if ( bowner->lrcompact ) {
+                pastix_int_t M = blok_rownbr( blok );
+                pastix_int_t N = cblk_colnbr( bowner );
+
+                MALLOC_INTERN( tmp, lrA->rk * (nrhs + M + N), pastix_complex64_t );
+                lrexp.rk    = lrA->rk;
+                lrexp.rkmax = lrA->rk;
+                lrexp.u     = tmp + lrA->rk * nrhs;
+                lrexp.v     = tmp + lrA->rk * (nrhs + M);
+                core_lrexpand( PastixComplex64, M, N, lrA, lrexp.u, lrexp.v );
+                lrA = &lrexp;
+            }
+            else {
+                MALLOC_INTERN( tmp, lrA->rk * nrhs, pastix_complex64_t );
+            }
             if (trans == PastixNoTrans) {
                 cblas_zgemm(
                     CblasColMajor, (CBLAS_TRANSPOSE)trans, CblasNoTrans,
@@ -405,7 +477,60 @@ solve_cblk_ztrsmsp_forward( pastix_solv_mode_t  mode,
                           cblk, blok, fcbk,
                           b + cblk->lcolidx, ldb,
                           b + fcbk->lcolidx, ldb );
-        pastix_atomic_dec_32b( &(fcbk->ctrbcnt) );
+        solve_cblk_zrelease_deps( mode, datacode, cblk, fcbk,
+                                  (double)(fcbk - datacode->cblktab) );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Apply the forward solve of a cblk that has just been factorized.
+ *
+ * This routine is called at the end of the panel factorization when a forward
+ * solve is fused with the factorization (see solver_fwdsolve_t). The
+ * contributions to the right-hand sides of the facing cblks are protected by
+ * their lock, and no dependency is released, as the ordering is given by the
+ * dependencies of the factorization: the updates of a cblk are released after
+ * its forward solve, so all the contributions to the right-hand side of a cblk
+ * are applied before its own panel factorization.
+ *
+ *******************************************************************************
+ *
+ * @param[in] datacode
+ *          The SolverMatrix structure from PaStiX with the fwdsolve structure
+ *          attached.
+ *
+ * @param[in] cblk
+ *          The factorized cblk.
+ *          Next column blok must be accessible through cblk[1].
+ *
+ *******************************************************************************/
+void
+solve_cblk_ztrsmsp_fwdfacto( const SolverMatrix *datacode,
+                             const SolverCblk   *cblk )
+{
+    const solver_fwdsolve_t *fwd = datacode->fwdsolve;
+    pastix_complex64_t      *b   = (pastix_complex64_t *)(fwd->b);
+    SolverCblk *fcbk;
+    SolverBlok *blok;
+
+    assert( !( cblk->cblktype & (CBLK_FANIN|CBLK_RECV|CBLK_IN_SCHUR) ) );
+    assert( cblk->fcolnum == cblk->lcolidx );
+
+    /* Solve the diagonal block */
+    solve_blok_ztrsm( PastixLCoef, PastixLeft, PastixLower,
+                      PastixNoTrans, fwd->diag, cblk,
+                      fwd->nrhs, b + cblk->lcolidx, fwd->ldb );
+
+    /* Apply the update */
+    for (blok = cblk[0].fblokptr+1; blok < cblk[1].fblokptr; blok++ ) {
+        fcbk = datacode->cblktab + blok->fcblknm;
+
+        solve_blok_zgemm( PastixLCoef, PastixLeft, PastixNoTrans, fwd->nrhs,
+                          cblk, blok, fcbk,
+                          b + cblk->lcolidx, fwd->ldb,
+                          b + fcbk->lcolidx, fwd->ldb );
     }
 }
 
@@ -523,7 +648,8 @@ solve_cblk_ztrsmsp_backward( pastix_solv_mode_t  mode,
             if ( fcbk->cblktype & CBLK_IN_SCHUR ) {
                 break;
             }
-            pastix_atomic_dec_32b( &(fcbk->ctrbcnt) );
+            solve_cblk_zrelease_deps( mode, datacode, cblk, fcbk,
+                                      -(double)(fcbk - datacode->cblktab) );
         }
         return;
     }
@@ -552,7 +678,8 @@ solve_cblk_ztrsmsp_backward( pastix_solv_mode_t  mode,
                           cblk, blok, fcbk,
                           b + cblk->lcolidx, ldb,
                           b + fcbk->lcolidx, ldb );
-        pastix_atomic_dec_32b( &(fcbk->ctrbcnt) );
+        solve_cblk_zrelease_deps( mode, datacode, cblk, fcbk,
+                                  -(double)(fcbk - datacode->cblktab) );
     }
 }
 
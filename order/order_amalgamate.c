@@ -20,73 +20,22 @@
 #include "fax_csr.h"
 
 /**
- *******************************************************************************
- *
- * @ingroup pastix_order
-
- * @brief Update the order structure with an amalgamation algorithm.
- *
- * This algorithm almagamates small blocks together in larger ones, and generates
- * an updated order structure. See after for the different parameters.
- *
- *******************************************************************************
- *
- * @param[in] verbose
- *          Adjust the level of verbosity of the function
- *
- * @param[in] ilu
- *          - 1: incomplete factorization will be performed.
- *          - 0: direct factorization will be performed.
- *
- * @param[in] levelk
- *          Unused if ilu == 0.
- *          - k >= 0: ordering for ILU(k) factorization will be generated.
- *          - < 0: ordering for direct factorization will be generated.
- *
- * @param[in] rat_cblk
- *          Must be >= 0. Fill ratio that limits the amalgamation process based
- *          on the graph structure.
+ * @brief Update the order structure with an amalgamation algorithm, using the
+ * given internal scheduler to parallelize the symbolic factorization.
  *
- * @param[in] rat_blas
- *          Must be >= rat_cblk. Fill ratio that limits the amalgamation process
- *          that merges blocks in order to reduce the BLAS computational time
- *          (see amalgamate() for further informations).
- *
- * @param[inout] symbmtx
- *          The symbol matrix structure to construct. On entry, the initialized
- *          structure (see pastixSymbolInit()). On exit, the symbol matrix generated
- *          after the amalgamation process.
- *
- * @param[inout] csc
- *          The original csc for which the symbol matrix needs to be generated.
- *          Rebase to C numbering on exit.
- *
- * @param[inout] orderptr
- *          The oder structure that contains the perm and invp array generated
- *          by the ordering step. The supernode partition might be initialized
- *          or not.
- *          On exit, it is rebased to c numbering and contains the updated
- *          perm/invp arrays as well as the supernode partition.
- *
- * @param[in] pastix_comm
- *          The PaStiX instance communicator.
- *
- *******************************************************************************
- *
- * @retval PASTIX_SUCCESS on success.
- * @retval PASTIX_ERR_ALLOC if allocation went wrong.
- * @retval PASTIX_ERR_BADPARAMETER if incorrect parameters are given.
- *
- *******************************************************************************/
-int
-pastixOrderAmalgamate( int             verbose,
-                       int             ilu,
-                       int             levelk,
-                       int             rat_cblk,
-                       int             rat_blas,
-                       pastix_graph_t *csc,
-                       pastix_order_t *orderptr,
-                       PASTIX_Comm     pastix_comm )
+ * See pastixOrderAmalgamate() for the description of the parameters. If isched
+ * is NULL, the computation is sequential.
+ */
+static inline int
+order_amalgamate( int             verbose,
+                  int             ilu,
+                  int             levelk,
+                  int             rat_cblk,
+                  int             rat_blas,
+                  pastix_graph_t *csc,
+                  pastix_order_t *orderptr,
+                  isched_t       *isched,
+                  PASTIX_Comm     pastix_comm )
 {
     fax_csr_t     graphPA, graphL;
     pastix_int_t  n;
@@ -138,7 +87,7 @@ pastixOrderAmalgamate( int             verbose,
     if ( ( ilu == 0 ) || ( levelk == -1 ) )
     {
         clockStart( timer );
-        nnzL = faxCSRFactDirect( &graphPA, orderptr, &graphL );
+        nnzL = faxCSRFactDirect( &graphPA, orderptr, &graphL, isched );
         clockStop( timer );
 
         if ( verbose > PastixVerboseYes ) {
@@ -152,7 +101,7 @@ pastixOrderAmalgamate( int             verbose,
     else
     {
         clockStart( timer );
-        nnzL = faxCSRFactILUk( &graphPA, orderptr, levelk, &graphL );
+        nnzL = faxCSRFactILUk( &graphPA, orderptr, levelk, &graphL, isched );
         clockStop( timer );
 
         if ( verbose > PastixVerboseYes ) {
@@ -185,6 +134,7 @@ pastixOrderAmalgamate( int             verbose,
                       (double)rat_blas / 100.,
                       &graphL,
                       orderptr,
+                      isched,
                       pastix_comm );
     clockStop( timer );
 
@@ -203,3 +153,129 @@ pastixOrderAmalgamate( int             verbose,
 
     return PASTIX_SUCCESS;
 }
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_order
+
+ * @brief Update the order structure with an amalgamation algorithm.
+ *
+ * This algorithm almagamates small blocks together in larger ones, and generates
+ * an updated order structure. See after for the different parameters.
+ *
+ *******************************************************************************
+ *
+ * @param[in] verbose
+ *          Adjust the level of verbosity of the function
+ *
+ * @param[in] ilu
+ *          - 1: incomplete factorization will be performed.
+ *          - 0: direct factorization will be performed.
+ *
+ * @param[in] levelk
+ *          Unused if ilu == 0.
+ *          - k >= 0: ordering for ILU(k) factorization will be generated.
+ *          - < 0: ordering for direct factorization will be generated.
+ *
+ * @param[in] rat_cblk
+ *          Must be >= 0. Fill ratio that limits the amalgamation process based
+ *          on the graph structure.
+ *
+ * @param[in] rat_blas
+ *          Must be >= rat_cblk. Fill ratio that limits the amalgamation process
+ *          that merges blocks in order to reduce the BLAS computational time
+ *          (see amalgamate() for further informations).
+ *
+ * @param[inout] symbmtx
+ *          The symbol matrix structure to construct. On entry, the initialized
+ *          structure (see pastixSymbolInit()). On exit, the symbol matrix generated
+ *          after the amalgamation process.
+ *
+ * @param[inout] csc
+ *          The original csc for which the symbol matrix needs to be generated.
+ *          Rebase to C numbering on exit.
+ *
+ * @param[inout] orderptr
+ *          The oder structure that contains the perm and invp array generated
+ *          by the ordering step. The supernode partition might be initialized
+ *          or not.
+ *          On exit, it is rebased to c numbering and contains the updated
+ *          perm/invp arrays as well as the supernode partition.
+ *
+ * @param[in] pastix_comm
+ *          The PaStiX instance communicator.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS on success.
+ * @retval PASTIX_ERR_ALLOC if allocation went wrong.
+ * @retval PASTIX_ERR_BADPARAMETER if incorrect parameters are given.
+ *
+ *******************************************************************************/
+int
+pastixOrderAmalgamate( int             verbose,
+                       int             ilu,
+                       int             levelk,
+                       int             rat_cblk,
+                       int             rat_blas,
+                       pastix_graph_t *csc,
+                       pastix_order_t *orderptr,
+                       PASTIX_Comm     pastix_comm )
+{
+    return order_amalgamate( verbose, ilu, levelk, rat_cblk, rat_blas,
+                             csc, orderptr, NULL, pastix_comm );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_order
+ *
+ * @brief Update the order structure with an amalgamation algorithm, using the
+ * internal scheduler of the instance.
+ *
+ * This is the multi-threaded version of pastixOrderAmalgamate() with the
+ * parameters of the instance: the symbolic factorization of the scalar graph
+ * and the computation of the merge costs are distributed over the threads of
+ * pastix_data->isched. The generated ordering is identical to the sequential
+ * one.
+ *
+ *******************************************************************************
+ *
+ * @param[in] pastix_data
+ *          The pastix_data structure that provides the scheduler and the
+ *          parameters IPARM_VERBOSE, IPARM_INCOMPLETE, IPARM_LEVEL_OF_FILL,
+ *          IPARM_AMALGAMATION_LVLCBLK and IPARM_AMALGAMATION_LVLBLAS.
+ *
+ * @param[inout] csc
+ *          The original csc for which the symbol matrix needs to be generated.
+ *          Rebase to C numbering on exit.
+ *
+ * @param[inout] orderptr
+ *          The oder structure to update (see pastixOrderAmalgamate()).
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS on success.
+ * @retval PASTIX_ERR_ALLOC if allocation went wrong.
+ * @retval PASTIX_ERR_BADPARAMETER if incorrect parameters are given.
+ *
+ *******************************************************************************/
+int
+orderAmalgamate( pastix_data_t  *pastix_data,
+                 pastix_graph_t *csc,
+                 pastix_order_t *orderptr )
+{
+    pastix_int_t *iparm = pastix_data->iparm;
+
+    return order_amalgamate( iparm[IPARM_VERBOSE],
+                             iparm[IPARM_INCOMPLETE],
+                             iparm[IPARM_LEVEL_OF_FILL],
+                             iparm[IPARM_AMALGAMATION_LVLCBLK],
+                             iparm[IPARM_AMALGAMATION_LVLBLAS],
+                             csc,
+                             orderptr,
+                             pastix_data->isched,
+                             pastix_data->pastix_comm );
+}
@@ -439,14 +439,7 @@ pastix_subtask_order(       pastix_data_t  *pastix_data,
         assert( pastixOrderCheck( ordemesh ) == PASTIX_SUCCESS );
 #endif
 
-        pastixOrderAmalgamate( iparm[IPARM_VERBOSE],
-                               iparm[IPARM_INCOMPLETE],
-                               iparm[IPARM_LEVEL_OF_FILL],
-                               iparm[IPARM_AMALGAMATION_LVLCBLK],
-                               iparm[IPARM_AMALGAMATION_LVLBLAS],
-                               &subgraph,
-                               ordemesh,
-                               pastix_data->pastix_comm );
+        orderAmalgamate( pastix_data, &subgraph, ordemesh );
     }
 
 #if !defined(NDEBUG) && defined(PASTIX_DEBUG_ORDERING)
@@ -16,6 +16,7 @@
  **/
 #include "common.h"
 #include "bcsc.h"
+#include "bvec.h"
 #include "isched.h"
 #include "solver.h"
 #include "coeftab.h"
@@ -46,8 +47,70 @@ struct coeftabinit_s {
     const pastix_bcsc_t *bcsc;     /**< The internal block CSC                    */
     const char          *dirname;  /**< The pointer to the output directory       */
     pastix_coefside_t    side;     /**< The side of the matrix beeing initialized */
+    int                  numainit; /**< Allocate the full-rank cblks page-aligned */
+    size_t              *numamem;  /**< Memory initialized per NUMA node, the last entry is for unbound threads */
+    pastix_atomic_lock_t lock;     /**< Lock to update the memory statistics      */
 };
 
+/**
+ *******************************************************************************
+ *
+ * @brief Allocate and zero the coefficients of a full-rank cblk on page
+ * boundaries.
+ *
+ * The cblk does not share any page with the cblks initialized by other threads,
+ * so the pages are placed on the NUMA node of the calling thread when they are
+ * first touched. The layout is the same as in cpucblk_zalloc(), which does
+ * nothing when it is called afterwards on the cblk.
+ *
+ *******************************************************************************
+ *
+ * @param[in] side
+ *          Describe the side(s) of the cblk that must be allocated.
+ *
+ * @param[inout] cblk
+ *          The column block to allocate.
+ *
+ * @param[in] eltsize
+ *          The size of the coefficients.
+ *
+ *******************************************************************************/
+static inline void
+coeftab_numa_alloc( pastix_coefside_t side,
+                    SolverCblk       *cblk,
+                    size_t            eltsize )
+{
+    static size_t pagesize = 0;
+    size_t        size;
+    void         *ptr = NULL;
+
+    if ( (cblk->cblktype & CBLK_COMPRESSED) ||
+         (cblk->lcoeftab != NULL) )
+    {
+        return;
+    }
+
+    if ( pagesize == 0 ) {
+        pagesize = sysconf( _SC_PAGESIZE );
+    }
+
+    size = cblk->stride * cblk_colnbr( cblk ) * eltsize;
+    if ( side != PastixLCoef ) {
+        size *= 2;
+    }
+
+    if ( posix_memalign( &ptr, pagesize, size ) != 0 ) {
+        /* Let the regular allocation handle the cblk */
+        return;
+    }
+    memset( ptr, 0, size );
+
+    cblk->lcoeftab = ptr;
+    if ( side != PastixLCoef ) {
+        cblk->ucoeftab = (char*)ptr + size / 2;
+    }
+}
+
 /**
  *******************************************************************************
  *
@@ -77,7 +140,10 @@ pcoeftabInit( isched_thread_t *ctx,
     pastix_coefside_t     side     = ciargs->side;
     pastix_int_t i, itercblk;
     pastix_int_t task;
+    SolverCblk  *cblk;
     int rank = ctx->rank;
+    int numaid;
+    size_t eltsize, memsize = 0;
 
     void (*initfunc)( pastix_coefside_t, const SolverMatrix*,
                       const pastix_bcsc_t*, pastix_int_t, const char *) = NULL;
@@ -98,14 +164,31 @@ pcoeftabInit( isched_thread_t *ctx,
         initfunc = cpucblk_dinit;
     }
 
+    eltsize = pastix_size_of( (bcsc->flttype == PastixPattern) ? PastixDouble : bcsc->flttype );
+    numaid  = (ctx->numaid >= 0) ? ctx->numaid : ctx->global_ctx->numanbr;
+
     for (i=0; i < datacode->ttsknbr[rank]; i++)
     {
         task = datacode->ttsktab[rank][i];
         itercblk = datacode->tasktab[task].cblknum;
+        cblk = datacode->cblktab + itercblk;
+
+        if ( ciargs->numainit ) {
+            coeftab_numa_alloc( side, cblk, eltsize );
+        }
 
         /* Init as full rank */
         initfunc( side, datacode, bcsc, itercblk, dirname );
+
+        memsize += cblk->stride * cblk_colnbr( cblk ) * eltsize;
     }
+    if ( side != PastixLCoef ) {
+        memsize *= 2;
+    }
+
+    pastix_atomic_lock( &(ciargs->lock) );
+    ciargs->numamem[numaid] += memsize;
+    pastix_atomic_unlock( &(ciargs->lock) );
 }
 
 /**
@@ -114,7 +197,14 @@ pcoeftabInit( isched_thread_t *ctx,
  * @brief Initialize the solver matrix structure
  *
  * This routine is a parallel routine to initialize the solver matrix structure
- * through the internal static scheduler
+ * through the internal static scheduler. Each cblk is allocated and first
+ * touched by the thread to which it is mapped by the static scheduling. If
+ * IPARM_NUMA_INIT is set, the full-rank cblks are allocated on page
+ * boundaries to be entirely placed on the NUMA node of this thread.
+ *
+ * If the arithmetic of the solver matrix is the single precision one of the
+ * block csc (IPARM_MIXED), the coeftab is filled from a temporary single
+ * precision copy of the values of the block csc.
  *
  *******************************************************************************
  *
@@ -133,10 +223,25 @@ coeftabInit( pastix_data_t    *pastix_data,
              pastix_coefside_t side )
 {
     struct coeftabinit_s args;
+    isched_t            *isched = pastix_data->isched;
+    pastix_bcsc_t        bcsclp;
+    int                  mixed, i;
+
+    mixed = ( (int)(pastix_data->solvmatr->flttype) != pastix_data->bcsc->flttype );
 
     args.datacode = pastix_data->solvmatr;
     args.bcsc     = pastix_data->bcsc;
+    if ( mixed ) {
+        if ( bcscLowPrecisionInit( pastix_data->bcsc, &bcsclp ) ) {
+            errorPrintW( "coeftabInit: some values of the matrix overflow the single precision" );
+        }
+        args.bcsc = &bcsclp;
+    }
     args.side     = side;
+    args.numainit = pastix_data->iparm[IPARM_NUMA_INIT];
+    args.lock     = PASTIX_ATOMIC_UNLOCKED;
+    MALLOC_INTERN( args.numamem, isched->numanbr + 1, size_t );
+    memset( args.numamem, 0, (isched->numanbr + 1) * sizeof(size_t) );
 
 #if defined(PASTIX_DEBUG_DUMP_COEFTAB)
     /* Make sure dir_local is initialized before calling it with multiple threads */
@@ -144,7 +249,147 @@ coeftabInit( pastix_data_t    *pastix_data,
 #endif
     args.dirname = pastix_data->dir_local;
 
-    isched_parallel_call( pastix_data->isched, pcoeftabInit, &args );
+    isched_parallel_call( isched, pcoeftabInit, &args );
+
+    if ( mixed ) {
+        bcscLowPrecisionExit( &bcsclp );
+    }
+
+    if ( pastix_data->iparm[IPARM_VERBOSE] > PastixVerboseNo ) {
+        pastix_print( pastix_data->inter_node_procnum, 0, OUT_COEFTAB_NUMA,
+                      args.numainit ? "first-touch" : "default" );
+        for( i=0; i<isched->numanbr; i++ ) {
+            pastix_print( pastix_data->inter_node_procnum, 0, OUT_COEFTAB_NODE, i,
+                          pastix_print_value( args.numamem[i] ),
+                          pastix_print_unit( args.numamem[i] ) );
+        }
+        if ( args.numamem[i] > 0 ) {
+            pastix_print( pastix_data->inter_node_procnum, 0, OUT_COEFTAB_UNBOUND,
+                          pastix_print_value( args.numamem[i] ),
+                          pastix_print_unit( args.numamem[i] ) );
+        }
+    }
+    memFree_null( args.numamem );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Internal routine called by each static thread to refill the solver
+ * matrix structure.
+ *
+ * This routine is the routine called by each thread in the static scheduler and
+ * launched by the coeftabRefill(). The full-rank cblks are reset and filled
+ * through the scatter map of the bcsc, and the compressed ones are freed and
+ * initialized again as in pcoeftabInit().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] ctx
+ *          The internal scheduler context
+ *
+ * @param[in] args
+ *          The data structure specific to the function cpucblk_zrefill()
+ *
+ *******************************************************************************/
+void
+pcoeftabRefill( isched_thread_t *ctx,
+                void            *args )
+{
+    struct coeftabinit_s *ciargs   = (struct coeftabinit_s*)args;
+    const SolverMatrix   *datacode = ciargs->datacode;
+    const pastix_bcsc_t  *bcsc     = ciargs->bcsc;
+    const char           *dirname  = ciargs->dirname;
+    pastix_coefside_t     side     = ciargs->side;
+    pastix_int_t i, itercblk;
+    pastix_int_t task;
+    SolverCblk  *cblk;
+    int rank = ctx->rank;
+
+    void (*initfunc)( pastix_coefside_t, const SolverMatrix*,
+                      const pastix_bcsc_t*, pastix_int_t, const char *) = NULL;
+    void (*refillfunc)( pastix_coefside_t, const SolverMatrix*,
+                        const pastix_bcsc_t*, pastix_int_t ) = NULL;
+
+    switch( bcsc->flttype ) {
+    case PastixComplex32:
+        initfunc   = cpucblk_cinit;
+        refillfunc = cpucblk_crefill;
+        break;
+    case PastixComplex64:
+        initfunc   = cpucblk_zinit;
+        refillfunc = cpucblk_zrefill;
+        break;
+    case PastixFloat:
+        initfunc   = cpucblk_sinit;
+        refillfunc = cpucblk_srefill;
+        break;
+    case PastixDouble:
+    case PastixPattern:
+    default:
+        initfunc   = cpucblk_dinit;
+        refillfunc = cpucblk_drefill;
+    }
+
+    for (i=0; i < datacode->ttsknbr[rank]; i++)
+    {
+        task = datacode->ttsktab[rank][i];
+        itercblk = datacode->tasktab[task].cblknum;
+        cblk = datacode->cblktab + itercblk;
+
+        if ( (cblk->cblktype & CBLK_COMPRESSED) ||
+             (cblk->lcoeftab == NULL) )
+        {
+            /* Free is precision independent, so we can use any version */
+            cpucblk_zfree( PastixLUCoef, cblk );
+            initfunc( side, datacode, bcsc, itercblk, dirname );
+        }
+        else {
+            refillfunc( side, datacode, bcsc, itercblk );
+        }
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Refill the solver matrix structure with the new values of the bcsc.
+ *
+ * This routine replaces the coeftabExit()/coeftabInit() sequence when the
+ * structure of the bcsc is unchanged since the last initialization, and when
+ * its scatter map is available. The full-rank cblks are kept allocated, and
+ * are filled without searching the blocks.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that hold the solver matrix to refill.
+ *
+ * @param[in] side
+ *          Describe the side(s) of the matrix that must be initialized.
+ *          @arg PastixLCoef if lower part only
+ *          @arg PastixUCoef if upper part only
+ *          @arg PastixLUCoef if both sides.
+ *
+ *******************************************************************************/
+void
+coeftabRefill( pastix_data_t    *pastix_data,
+               pastix_coefside_t side )
+{
+    struct coeftabinit_s args;
+
+    assert( (pastix_data->bcsc->map != NULL) &&
+            (pastix_data->bcsc->map->ctabinit) );
+
+    args.datacode = pastix_data->solvmatr;
+    args.bcsc     = pastix_data->bcsc;
+    args.side     = side;
+    args.numainit = 0;
+    args.numamem  = NULL;
+    args.lock     = PASTIX_ATOMIC_UNLOCKED;
+    args.dirname  = pastix_data->dir_local;
+
+    isched_parallel_call( pastix_data->isched, pcoeftabRefill, &args );
 }
 
 /**
@@ -303,7 +548,7 @@ coeftabCompress( pastix_data_t *pastix_data )
     pastix_lr_t  *lr;
 
     args.solvmtx = pastix_data->solvmatr;
-    args.flttype = pastix_data->bcsc->flttype;
+    args.flttype = pastix_data->solvmatr->flttype;
     args.lock    = PASTIX_ATOMIC_UNLOCKED;
     args.gain    = 0;
 
@@ -319,6 +564,335 @@ coeftabCompress( pastix_data_t *pastix_data )
     return args.gain;
 }
 
+/**
+ * @brief Internal structure specific to the parallel call of pcoeftabCompact()
+ */
+struct coeftabcompact_s {
+    SolverMatrix        *solvmtx;  /**< The solver matrix                         */
+    pastix_atomic_lock_t lock;     /**< Lock to protect the overflow update       */
+    pastix_int_t         overflow; /**< Number of bases that overflowed on output */
+};
+
+/**
+ *******************************************************************************
+ *
+ * @brief Internal routine called by each static thread to store the low-rank
+ * bases in single precision.
+ *
+ * This routine is the routine called by each thread in the static scheduler and
+ * launched by the coeftabCompact().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] ctx
+ *          The internal scheduler context
+ *
+ * @param[in] args
+ *          The data structure specific to the function cpucblk_zlrcompact()
+ *
+ *******************************************************************************/
+static void
+pcoeftabCompact( isched_thread_t *ctx,
+                 void            *args )
+{
+    struct coeftabcompact_s *ccargs  = (struct coeftabcompact_s*)args;
+    SolverMatrix            *solvmtx = ccargs->solvmtx;
+    SolverCblk              *cblk;
+    pastix_coefside_t side = (solvmtx->factotype == PastixFactLU) ? PastixLUCoef : PastixLCoef;
+    pastix_int_t i, itercblk;
+    pastix_int_t task, overflow = 0;
+    int rank = ctx->rank;
+
+    int (*compactfunc)( const SolverMatrix*, pastix_coefside_t, SolverCblk* ) = NULL;
+
+    switch( solvmtx->flttype ) {
+    case PastixComplex32:
+        compactfunc = cpucblk_clrcompact;
+        break;
+    case PastixComplex64:
+        compactfunc = cpucblk_zlrcompact;
+        break;
+    case PastixFloat:
+        compactfunc = cpucblk_slrcompact;
+        break;
+    case PastixDouble:
+    case PastixPattern:
+    default:
+        compactfunc = cpucblk_dlrcompact;
+    }
+
+    for (i=0; i < solvmtx->ttsknbr[rank]; i++)
+    {
+        task     = solvmtx->ttsktab[rank][i];
+        itercblk = solvmtx->tasktab[task].cblknum;
+        cblk     = solvmtx->cblktab + itercblk;
+
+        overflow += compactfunc( solvmtx, side, cblk );
+    }
+
+    pastix_atomic_lock( &(ccargs->lock) );
+    ccargs->overflow += overflow;
+    pastix_atomic_unlock( &(ccargs->lock) );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Store the low-rank bases of the factorized matrix in single precision.
+ *
+ * With IPARM_COMPRESS_LOWPREC, the 1D factorization kernels compact each cblk
+ * as soon as it has applied its updates. This routine compacts the cblks left
+ * by the other paths (2D tasks, and the thread teams of the dynamic
+ * scheduler), once the factorization is over.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that holds the factorized problem.
+ *
+ *******************************************************************************/
+void
+coeftabCompact( pastix_data_t *pastix_data )
+{
+    struct coeftabcompact_s args;
+
+    args.solvmtx  = pastix_data->solvmatr;
+    args.lock     = PASTIX_ATOMIC_UNLOCKED;
+    args.overflow = 0;
+
+    if ( !args.solvmtx->lowrank.compress_lowprec ) {
+        return;
+    }
+
+    isched_parallel_call( pastix_data->isched, pcoeftabCompact, (void*)(&args) );
+
+    if ( args.overflow > 0 ) {
+        errorPrintW( "coeftabCompact: some low-rank bases overflow the single precision" );
+    }
+}
+
+/**
+ * @brief Internal structure specific to the parallel call of pcoeftabLowPrecision()
+ */
+struct coeftablowp_s {
+    const SolverMatrix  *solvmtx;  /**< The full precision solver matrix          */
+    SolverMatrix        *solvlowp; /**< The single precision copy of the factors  */
+    pastix_atomic_lock_t lock;     /**< Lock to protect the statistics update     */
+    pastix_int_t         overflow; /**< Number of conversions that overflowed     */
+    size_t               memsize;  /**< Memory of the single precision copy       */
+};
+
+/**
+ *******************************************************************************
+ *
+ * @brief Internal routine called by each static thread to convert the factors
+ * to single precision.
+ *
+ * This routine is the routine called by each thread in the static scheduler and
+ * launched by the coeftabLowPrecisionInit().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] ctx
+ *          The internal scheduler context
+ *
+ * @param[in] args
+ *          The data structure specific to the function
+ *
+ *******************************************************************************/
+static void
+pcoeftabLowPrecision( isched_thread_t *ctx,
+                      void            *args )
+{
+    struct coeftablowp_s *clargs   = (struct coeftablowp_s*)args;
+    const SolverMatrix   *solvmtx  = clargs->solvmtx;
+    SolverMatrix         *solvlowp = clargs->solvlowp;
+    pastix_coeftype_t     flttype  = solvmtx->flttype;
+    size_t                eltsize  = pastix_size_of( solvlowp->flttype );
+    const SolverCblk     *cblk;
+    SolverCblk           *cblklp;
+    pastix_int_t i, task, itercblk, ncols;
+    size_t       coefnbr, memsize = 0;
+    int rank = ctx->rank;
+    int rc   = 0;
+
+    for (i=0; i < solvmtx->ttsknbr[rank]; i++)
+    {
+        task     = solvmtx->ttsktab[rank][i];
+        itercblk = solvmtx->tasktab[task].cblknum;
+        cblk     = solvmtx->cblktab  + itercblk;
+        cblklp   = solvlowp->cblktab + itercblk;
+
+        if ( cblk->lcoeftab == NULL ) {
+            continue;
+        }
+
+        ncols   = cblk_colnbr( cblk );
+        coefnbr = (size_t)(cblk->stride) * ncols;
+
+        /* The lower and upper parts share a single allocation as in cpucblk_zalloc() */
+        if ( cblk->ucoeftab == NULL ) {
+            MALLOC_INTERN( cblklp->lcoeftab, coefnbr * eltsize, char );
+            memsize += coefnbr * eltsize;
+        }
+        else {
+            MALLOC_INTERN( cblklp->lcoeftab, 2 * coefnbr * eltsize, char );
+            memsize += 2 * coefnbr * eltsize;
+            cblklp->ucoeftab = (char*)(cblklp->lcoeftab) + coefnbr * eltsize;
+
+            rc += bvec_lag2lp( flttype, cblk->stride, ncols,
+                               cblk->ucoeftab, cblk->stride,
+                               cblklp->ucoeftab, cblk->stride );
+        }
+        rc += bvec_lag2lp( flttype, cblk->stride, ncols,
+                           cblk->lcoeftab, cblk->stride,
+                           cblklp->lcoeftab, cblk->stride );
+    }
+
+    pastix_atomic_lock( &(clargs->lock) );
+    clargs->overflow += rc;
+    clargs->memsize  += memsize;
+    pastix_atomic_unlock( &(clargs->lock) );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Build the single precision copy of the factors used by the solves.
+ *
+ * When IPARM_SOLVE_LOWPREC is set, the double precision factors are converted
+ * to single precision after the factorization, and pastix_subtask_solve()
+ * applies the triangular solves to this copy. The solves read half of the
+ * memory of the full precision factors, and the refinement, that computes the
+ * residuals with the full precision block csc, recovers the accuracy.
+ *
+ * The copy shares the read-only symbolic structure of the solver matrix, and
+ * owns its cblktab, the converted coefficients, and the state of the solves.
+ * It is given explicitly to the solves, and never replaces
+ * pastix_data->solvmatr. It is not built for distributed problems, with the
+ * runtime schedulers, or if some cblks are compressed.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that holds the factorized problem. On
+ *          exit, pastix_data->solvlowp is the single precision copy, or NULL
+ *          if it is not built.
+ *
+ *******************************************************************************/
+void
+coeftabLowPrecisionInit( pastix_data_t *pastix_data )
+{
+    struct coeftablowp_s args;
+    SolverMatrix        *solvmtx = pastix_data->solvmatr;
+    SolverMatrix        *solvlowp;
+    SolverCblk          *cblk;
+    pastix_int_t        *iparm   = pastix_data->iparm;
+    pastix_int_t         i;
+
+    coeftabLowPrecisionExit( pastix_data );
+
+    if ( !iparm[IPARM_SOLVE_LOWPREC] ) {
+        return;
+    }
+
+    /* The factors are already stored in single precision (IPARM_MIXED) */
+    if ( bvec_lowprec( solvmtx->flttype ) == solvmtx->flttype ) {
+        return;
+    }
+
+    if ( (pastix_data->inter_node_procnbr > 1)            ||
+         (iparm[IPARM_SCHEDULER] == PastixSchedParsec)    ||
+         (iparm[IPARM_SCHEDULER] == PastixSchedStarPU)    ||
+         (iparm[IPARM_COMPRESS_WHEN] != PastixCompressNever) )
+    {
+        errorPrintW( "coeftabLowPrecisionInit: IPARM_SOLVE_LOWPREC is only available with the internal schedulers on shared memory full-rank factorizations, it is ignored" );
+        return;
+    }
+
+    /*
+     * The copy only shares the read-only symbolic structure and task lists of
+     * the solver matrix (bloktab, browtab, tasktab, ttsktab, updttab, ...).
+     * The cblktab, that holds the coefficients and the dependency counters,
+     * and all the state modified by a solve are private to the copy.
+     */
+    MALLOC_INTERN( solvlowp, 1, SolverMatrix );
+    memcpy( solvlowp, solvmtx, sizeof(SolverMatrix) );
+    MALLOC_INTERN( solvlowp->cblktab, solvlowp->cblknbr + 1, SolverCblk );
+    memcpy( solvlowp->cblktab, solvmtx->cblktab,
+            (solvlowp->cblknbr + 1) * sizeof(SolverCblk) );
+    solvlowp->flttype      = bvec_lowprec( solvmtx->flttype );
+    solvlowp->computeQueue = NULL;
+    solvlowp->computeDeque = NULL;
+    solvlowp->idletime     = NULL;
+    solvlowp->fwdsolve     = NULL;
+    solvlowp->reqtab       = NULL;
+    solvlowp->reqidx       = NULL;
+    solvlowp->rcoeftab     = NULL;
+
+    cblk = solvlowp->cblktab;
+    for ( i = 0; i < solvlowp->cblknbr; i++, cblk++ ) {
+        cblk->lcoeftab = NULL;
+        cblk->ucoeftab = NULL;
+    }
+
+    args.solvmtx  = solvmtx;
+    args.solvlowp = solvlowp;
+    args.lock     = PASTIX_ATOMIC_UNLOCKED;
+    args.overflow = 0;
+    args.memsize  = 0;
+
+    isched_parallel_call( pastix_data->isched, pcoeftabLowPrecision, &args );
+
+    if ( args.overflow > 0 ) {
+        errorPrintW( "coeftabLowPrecisionInit: some factors overflow the single precision" );
+    }
+
+    pastix_data->solvlowp = solvlowp;
+
+    if ( iparm[IPARM_VERBOSE] > PastixVerboseNo ) {
+        pastix_print( pastix_data->inter_node_procnum, 0, OUT_COEFTAB_LOWPREC,
+                      pastix_print_value( args.memsize ), pastix_print_unit( args.memsize ) );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Free the single precision copy of the factors.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure. On exit, pastix_data->solvlowp is
+ *          freed and set to NULL.
+ *
+ *******************************************************************************/
+void
+coeftabLowPrecisionExit( pastix_data_t *pastix_data )
+{
+    SolverMatrix *solvlowp = pastix_data->solvlowp;
+    SolverCblk   *cblk;
+    pastix_int_t  i;
+
+    if ( solvlowp == NULL ) {
+        return;
+    }
+
+    cblk = solvlowp->cblktab;
+    for ( i = 0; i < solvlowp->cblknbr; i++, cblk++ ) {
+        if ( cblk->lcoeftab != NULL ) {
+            memFree_null( cblk->lcoeftab );
+        }
+        cblk->ucoeftab = NULL;
+    }
+    if ( solvlowp->idletime != NULL ) {
+        memFree_null( solvlowp->idletime );
+    }
+    memFree_null( solvlowp->cblktab );
+    memFree_null( pastix_data->solvlowp );
+}
+
 #if defined(PASTIX_WITH_MPI)
 /**
  *******************************************************************************
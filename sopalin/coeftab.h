@@ -29,9 +29,15 @@
 
 void coeftabInit( pastix_data_t     *pastix_data,
                   pastix_coefside_t  side );
+void coeftabRefill( pastix_data_t     *pastix_data,
+                    pastix_coefside_t  side );
 void coeftabExit( SolverMatrix      *solvmtx );
 
 pastix_int_t coeftabCompress( pastix_data_t *pastix_data );
+void         coeftabCompact ( pastix_data_t *pastix_data );
+
+void coeftabLowPrecisionInit( pastix_data_t *pastix_data );
+void coeftabLowPrecisionExit( pastix_data_t *pastix_data );
 
 #if defined(PASTIX_WITH_MPI)
 void coeftab_scatter( SolverMatrix *solvmtx,
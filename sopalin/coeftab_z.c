@@ -263,7 +263,7 @@ coeftab_zmemory( SolverMatrix *solvmtx )
         else{
             if ( side != PastixUCoef ) {
                 if ( solvblok->LRblock[0].rk >= 0 ) {
-                    assert( solvblok->LRblock[0].rk <= core_get_rklimit( nrows, ncols ) );
+                    assert( solvblok->LRblock[0].rk <= core_get_rklimit( &(solvmtx->lowrank), nrows, ncols ) );
                     assert( ((nrows+ncols) * solvblok->LRblock[0].rkmax) <= size );
                     last[solvblok->inlast] += ((nrows+ncols) * solvblok->LRblock[0].rkmax);
                 }
@@ -274,7 +274,7 @@ coeftab_zmemory( SolverMatrix *solvmtx )
 
             if ( side != PastixLCoef ) {
                 if ( solvblok->LRblock[1].rk >= 0 ) {
-                    assert( solvblok->LRblock[1].rk <= core_get_rklimit( nrows, ncols ) );
+                    assert( solvblok->LRblock[1].rk <= core_get_rklimit( &(solvmtx->lowrank), nrows, ncols ) );
                     assert( ((nrows+ncols) * solvblok->LRblock[1].rkmax) <= size );
                     last[solvblok->inlast] += ((nrows+ncols) * solvblok->LRblock[1].rkmax);
                 }
@@ -385,6 +385,49 @@ coeftab_zmemory( SolverMatrix *solvmtx )
                   pastix_print_value(totlr),             pastix_print_unit(totlr),
                   pastix_print_value(totfr),             pastix_print_unit(totfr) );
 
+    /*
+     * The sizes above count the low-rank bases in the working precision. The
+     * single precision bases only take half of it, with a unit roundoff that
+     * adds to the compression tolerance.
+     */
+    if ( solvmtx->lowrank.compress_lowprec ) {
+        pastix_int_t    lowpnbr = 0;
+        pastix_fixdbl_t memlowp;
+
+        cblk = solvmtx->cblktab;
+        for(cblknum=0; cblknum<solvmtx->cblknbr; cblknum++, cblk++) {
+            pastix_int_t colnbr = cblk_colnbr( cblk );
+
+            if ( !cblk->lrcompact ) {
+                continue;
+            }
+
+            for(blok=cblk[0].fblokptr+1; blok<cblk[1].fblokptr; blok++) {
+                pastix_int_t rownbr = blok_rownbr( blok );
+
+                if ( (side != PastixUCoef) && (blok->LRblock[0].rk > 0) ) {
+                    lowpnbr += (rownbr + colnbr) * blok->LRblock[0].rk;
+                }
+                if ( (side != PastixLCoef) && (blok->LRblock[1].rk > 0) ) {
+                    lowpnbr += (rownbr + colnbr) * blok->LRblock[1].rk;
+                }
+            }
+        }
+
+        memlowp = lowpnbr * pastix_size_of( PastixComplex64 ) / 2.;
+        totlr  -= memlowp;
+
+        pastix_print( solvmtx->clustnum, 0,
+                      "      Single precision bases    %8.3g %co / %8.3g %co\n"
+                      "      Total                     %8.3g %co / %8.3g %co\n"
+                      "      Unit roundoff of the bases             %8.3g (tolerance %8.3g)\n",
+                      pastix_print_value(memlowp),      pastix_print_unit(memlowp),
+                      pastix_print_value(2. * memlowp), pastix_print_unit(2. * memlowp),
+                      pastix_print_value(totlr),        pastix_print_unit(totlr),
+                      pastix_print_value(totfr),        pastix_print_unit(totfr),
+                      LAPACKE_slamch_work( 'e' ), solvmtx->lowrank.tolerance );
+    }
+
     return;
 }
 
@@ -0,0 +1,331 @@
+/**
+ *
+ * @file pastix_task_async.c
+ *
+ *  PaStiX asynchronous factorization and solve routines
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include "common.h"
+#include "spm.h"
+#include <pthread.h>
+
+/**
+ * @brief Types of the asynchronous tasks
+ */
+typedef enum pastix_request_type_e {
+    PastixRequestNumfact, /**< Numerical factorization */
+    PastixRequestSolve    /**< Solve                   */
+} pastix_request_type_t;
+
+/**
+ * @brief Handle of an asynchronous task.
+ *
+ * The task is executed by a helper thread that drives the scheduler of the
+ * instance, and that stores the return code of the task before flagging its
+ * completion.
+ */
+struct pastix_request_s {
+    pastix_request_type_t type;        /**< Type of the task                        */
+    pastix_data_t        *pastix_data; /**< Instance on which the task is executed  */
+    spmatrix_t           *spm;         /**< Matrix of the factorization             */
+    pastix_int_t          nrhs;        /**< Number of right-hand sides of the solve */
+    void                 *b;           /**< Right-hand sides of the solve           */
+    pastix_int_t          ldb;         /**< Leading dimension of b                  */
+    int                   rc;          /**< Return code of the task                 */
+    volatile int32_t      completed;   /**< Completion flag of the task             */
+    pthread_t             thread;      /**< Helper thread executing the task        */
+};
+
+/**
+ * @brief Main routine of the helper thread.
+ */
+static void *
+pastix_request_run( void *arg )
+{
+    pastix_request_t *request = (pastix_request_t *)arg;
+
+    switch( request->type ) {
+    case PastixRequestNumfact:
+        request->rc = pastix_task_numfact( request->pastix_data, request->spm );
+        break;
+    case PastixRequestSolve:
+        request->rc = pastix_task_solve( request->pastix_data, request->nrhs,
+                                         request->b, request->ldb );
+        break;
+    default:
+        request->rc = PASTIX_ERR_BADPARAMETER;
+    }
+
+    pastix_mfence();
+    request->completed = 1;
+    return NULL;
+}
+
+/**
+ * @brief Check that MPI can be called from the helper thread.
+ *
+ * The helper thread issues the MPI calls of the task, while the calling thread
+ * may issue its own, so MPI must be initialized with MPI_THREAD_MULTIPLE.
+ */
+static inline int
+pastix_request_check_mpi( const char *func )
+{
+#if defined(PASTIX_WITH_MPI)
+    int provided = MPI_THREAD_SINGLE;
+    int flag = 0;
+
+    MPI_Initialized( &flag );
+    if ( flag ) {
+        MPI_Query_thread( &provided );
+    }
+    if ( provided != MPI_THREAD_MULTIPLE ) {
+        errorPrint("%s: MPI must be initialized with MPI_THREAD_MULTIPLE", func);
+        return PASTIX_ERR_MPI;
+    }
+#else
+    (void)func;
+#endif
+    return PASTIX_SUCCESS;
+}
+
+/**
+ * @brief Create the request and start the helper thread.
+ */
+static inline int
+pastix_request_start( pastix_request_t  *req,
+                      pastix_request_t **request )
+{
+    if ( pthread_create( &(req->thread), NULL, pastix_request_run, req ) != 0 ) {
+        errorPrint("pastix_request_start: unable to create the helper thread");
+        memFree_null( req );
+        return PASTIX_ERR_THREAD;
+    }
+
+    *request = req;
+    return PASTIX_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Start the numerical factorization without waiting for its completion.
+ *
+ * This routine returns as soon as the factorization is started, and the
+ * calling thread is free to do other work, such as the assembly of the next
+ * matrix. The factorization is executed by the workers of the instance as with
+ * pastix_task_numfact(). The completion is checked with pastixRequestTest(),
+ * and pastixRequestWait() must be called to get the return code and release
+ * the handle.
+ *
+ * Until the request is waited for, neither the instance nor the spm can be
+ * used or modified, and a single request can be pending on an instance.
+ *
+ * The task, and thus its MPI calls, are executed by a helper pthread. With
+ * MPI, the library must be initialized with MPI_THREAD_MULTIPLE, otherwise
+ * the factorization is not started.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that describes the solver instance.
+ *
+ * @param[inout] spm
+ *          The sparse matrix to factorize (see pastix_task_numfact()).
+ *
+ * @param[out] request
+ *          On exit, the handle of the factorization.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS if the factorization is started,
+ * @retval PASTIX_ERR_BADPARAMETER if one parameter is incorrect,
+ * @retval PASTIX_ERR_MPI if MPI is not initialized with MPI_THREAD_MULTIPLE,
+ * @retval PASTIX_ERR_THREAD if the helper thread can not be created.
+ *
+ *******************************************************************************/
+int
+pastix_task_numfact_async( pastix_data_t     *pastix_data,
+                           spmatrix_t        *spm,
+                           pastix_request_t **request )
+{
+    pastix_request_t *req;
+    int rc;
+
+    if ( (pastix_data == NULL) || (spm == NULL) ) {
+        errorPrint("pastix_task_numfact_async: wrong parameters");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if ( request == NULL ) {
+        errorPrint("pastix_task_numfact_async: wrong request parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    rc = pastix_request_check_mpi( "pastix_task_numfact_async" );
+    if ( rc != PASTIX_SUCCESS ) {
+        return rc;
+    }
+
+    MALLOC_INTERN( req, 1, pastix_request_t );
+    memset( req, 0, sizeof(pastix_request_t) );
+    req->type        = PastixRequestNumfact;
+    req->pastix_data = pastix_data;
+    req->spm         = spm;
+
+    return pastix_request_start( req, request );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Start the solve without waiting for its completion.
+ *
+ * This routine is the asynchronous version of pastix_task_solve(). The
+ * right-hand sides must not be accessed until pastixRequestTest() reports the
+ * completion of the solve, or pastixRequestWait() returns.
+ *
+ * As with pastix_task_numfact_async(), the solve is executed by a helper
+ * pthread, and MPI must be initialized with MPI_THREAD_MULTIPLE.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that describes the solver instance.
+ *
+ * @param[in] nrhs
+ *          The number of right-and-side vectors.
+ *
+ * @param[inout] b
+ *          The right-and-side vectors (can be multiple RHS).
+ *          On completion, the solution is stored in place of the
+ *          right-hand-side vector.
+ *
+ * @param[in] ldb
+ *          The leading dimension of the right-and-side vectors.
+ *
+ * @param[out] request
+ *          On exit, the handle of the solve.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS if the solve is started,
+ * @retval PASTIX_ERR_BADPARAMETER if one parameter is incorrect,
+ * @retval PASTIX_ERR_MPI if MPI is not initialized with MPI_THREAD_MULTIPLE,
+ * @retval PASTIX_ERR_THREAD if the helper thread can not be created.
+ *
+ *******************************************************************************/
+int
+pastix_task_solve_async( pastix_data_t     *pastix_data,
+                         pastix_int_t       nrhs,
+                         void              *b,
+                         pastix_int_t       ldb,
+                         pastix_request_t **request )
+{
+    pastix_request_t *req;
+    int rc;
+
+    if ( (pastix_data == NULL) || (b == NULL) ) {
+        errorPrint("pastix_task_solve_async: wrong parameters");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if ( request == NULL ) {
+        errorPrint("pastix_task_solve_async: wrong request parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    rc = pastix_request_check_mpi( "pastix_task_solve_async" );
+    if ( rc != PASTIX_SUCCESS ) {
+        return rc;
+    }
+
+    MALLOC_INTERN( req, 1, pastix_request_t );
+    memset( req, 0, sizeof(pastix_request_t) );
+    req->type        = PastixRequestSolve;
+    req->pastix_data = pastix_data;
+    req->nrhs        = nrhs;
+    req->b           = b;
+    req->ldb         = ldb;
+
+    return pastix_request_start( req, request );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Check the completion of an asynchronous task without blocking.
+ *
+ *******************************************************************************
+ *
+ * @param[in] request
+ *          The handle returned by pastix_task_numfact_async() or
+ *          pastix_task_solve_async().
+ *
+ *******************************************************************************
+ *
+ * @retval 1 if the task is completed, pastixRequestWait() then returns
+ *         immediately.
+ * @retval 0 if the task is still running.
+ *
+ *******************************************************************************/
+int
+pastixRequestTest( const pastix_request_t *request )
+{
+    if ( request == NULL ) {
+        return 1;
+    }
+    if ( request->completed ) {
+        pastix_mfence();
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Wait for the completion of an asynchronous task, and release its
+ * handle.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] request
+ *          The handle returned by pastix_task_numfact_async() or
+ *          pastix_task_solve_async(). On exit, the handle is freed and set to
+ *          NULL.
+ *
+ *******************************************************************************
+ *
+ * @return The return code of the task.
+ *
+ *******************************************************************************/
+int
+pastixRequestWait( pastix_request_t **request )
+{
+    pastix_request_t *req;
+    int rc;
+
+    if ( (request == NULL) || (*request == NULL) ) {
+        errorPrint("pastixRequestWait: wrong request parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    req = *request;
+
+    pthread_join( req->thread, NULL );
+    rc = req->rc;
+
+    memFree_null( req );
+    *request = NULL;
+    return rc;
+}
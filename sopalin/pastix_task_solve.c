@@ -18,6 +18,7 @@
 #define _GNU_SOURCE 1
 #include "common.h"
 #include "bcsc.h"
+#include "bvec.h"
 #include "pastix/order.h"
 #include "solver.h"
 #include "sopalin_data.h"
@@ -169,6 +170,98 @@ pastix_subtask_applyorder( pastix_data_t *pastix_data,
     return PASTIX_SUCCESS;
 }
 
+/**
+ * @brief Apply a triangular solve with the factors of the given solver matrix.
+ */
+static inline void
+solve_trsm( pastix_data_t *pastix_data, SolverMatrix *solvmtx,
+            pastix_coeftype_t flttype, pastix_side_t side,
+            pastix_uplo_t uplo, pastix_trans_t trans, pastix_diag_t diag,
+            pastix_int_t nrhs, void *b, pastix_int_t ldb )
+{
+    sopalin_data_t sopalin_data;
+    int i, bs = nrhs;
+
+#if defined(PASTIX_WITH_MPI)
+    bs = 1;
+#endif
+
+    sopalin_data.solvmtx = solvmtx;
+
+    switch (flttype) {
+    case PastixComplex64:
+    {
+        pastix_complex64_t *lb = b;
+        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
+            sopalin_ztrsm( pastix_data, side, uplo, trans, diag,
+                           &sopalin_data, bs, lb, ldb );
+        }
+    }
+    break;
+    case PastixComplex32:
+    {
+        pastix_complex32_t *lb = b;
+        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
+            sopalin_ctrsm( pastix_data, side, uplo, trans, diag,
+                           &sopalin_data, bs, lb, ldb );
+        }
+    }
+    break;
+    case PastixDouble:
+    {
+        double *lb = b;
+        trans = (trans == PastixConjTrans) ? PastixTrans : trans;
+        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
+            sopalin_dtrsm( pastix_data, side, uplo, trans, diag,
+                           &sopalin_data, bs, lb, ldb );
+        }
+    }
+    break;
+    case PastixFloat:
+    {
+        float *lb = b;
+        trans = (trans == PastixConjTrans) ? PastixTrans : trans;
+        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
+            sopalin_strsm( pastix_data, side, uplo, trans, diag,
+                           &sopalin_data, bs, lb, ldb );
+        }
+    }
+    break;
+    default:
+        fprintf(stderr, "Unknown floating point arithmetic\n" );
+    }
+}
+
+/**
+ * @brief Apply the diagonal solve with the factors of the given solver matrix.
+ */
+static inline void
+solve_diag( pastix_data_t *pastix_data, SolverMatrix *solvmtx,
+            pastix_coeftype_t flttype,
+            pastix_int_t nrhs, void *b, pastix_int_t ldb )
+{
+    sopalin_data_t sopalin_data;
+
+    sopalin_data.solvmtx = solvmtx;
+
+    switch (flttype) {
+    case PastixComplex64:
+        sopalin_zdiag( pastix_data, &sopalin_data, nrhs, (pastix_complex64_t *)b, ldb );
+        break;
+    case PastixComplex32:
+        sopalin_cdiag( pastix_data, &sopalin_data, nrhs, (pastix_complex32_t *)b, ldb );
+        break;
+    case PastixDouble:
+        sopalin_ddiag( pastix_data, &sopalin_data, nrhs, (double *)b, ldb );
+        break;
+    case PastixFloat:
+        sopalin_sdiag( pastix_data, &sopalin_data, nrhs, (float *)b, ldb );
+        break;
+    default:
+        fprintf(stderr, "Unknown floating point arithmetic\n" );
+    }
+}
+
 /**
  *******************************************************************************
  *
@@ -221,13 +314,6 @@ pastix_subtask_trsm( pastix_data_t *pastix_data,
                      pastix_uplo_t uplo, pastix_trans_t trans, pastix_diag_t diag,
                      pastix_int_t nrhs, void *b, pastix_int_t ldb )
 {
-    sopalin_data_t sopalin_data;
-    int i, bs = nrhs;
-
-#if defined(PASTIX_WITH_MPI)
-    bs = 1;
-#endif
-
     /*
      * Check parameters
      */
@@ -244,50 +330,8 @@ pastix_subtask_trsm( pastix_data_t *pastix_data,
         return PASTIX_ERR_BADPARAMETER;
     }
 
-    sopalin_data.solvmtx = pastix_data->solvmatr;
-
-    switch (flttype) {
-    case PastixComplex64:
-    {
-        pastix_complex64_t *lb = b;
-        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
-            sopalin_ztrsm( pastix_data, side, uplo, trans, diag,
-                           &sopalin_data, bs, lb, ldb );
-        }
-    }
-    break;
-    case PastixComplex32:
-    {
-        pastix_complex32_t *lb = b;
-        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
-            sopalin_ctrsm( pastix_data, side, uplo, trans, diag,
-                           &sopalin_data, bs, lb, ldb );
-        }
-    }
-    break;
-    case PastixDouble:
-    {
-        double *lb = b;
-        trans = (trans == PastixConjTrans) ? PastixTrans : trans;
-        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
-            sopalin_dtrsm( pastix_data, side, uplo, trans, diag,
-                           &sopalin_data, bs, lb, ldb );
-        }
-    }
-    break;
-    case PastixFloat:
-    {
-        float *lb = b;
-        trans = (trans == PastixConjTrans) ? PastixTrans : trans;
-        for( i = 0; i < nrhs; i+=bs, lb += ldb ) {
-            sopalin_strsm( pastix_data, side, uplo, trans, diag,
-                           &sopalin_data, bs, lb, ldb );
-        }
-    }
-    break;
-    default:
-        fprintf(stderr, "Unknown floating point arithmetic\n" );
-    }
+    solve_trsm( pastix_data, pastix_data->solvmatr, flttype,
+                side, uplo, trans, diag, nrhs, b, ldb );
 
     return PASTIX_SUCCESS;
 }
@@ -330,8 +374,6 @@ int
 pastix_subtask_diag( pastix_data_t *pastix_data, pastix_coeftype_t flttype,
                      pastix_int_t nrhs, void *b, pastix_int_t ldb )
 {
-    sopalin_data_t sopalin_data;
-
     /*
      * Check parameters
      */
@@ -348,24 +390,7 @@ pastix_subtask_diag( pastix_data_t *pastix_data, pastix_coeftype_t flttype,
         return PASTIX_ERR_BADPARAMETER;
     }
 
-    sopalin_data.solvmtx = pastix_data->solvmatr;
-
-    switch (flttype) {
-    case PastixComplex64:
-        sopalin_zdiag( pastix_data, &sopalin_data, nrhs, (pastix_complex64_t *)b, ldb );
-        break;
-    case PastixComplex32:
-        sopalin_cdiag( pastix_data, &sopalin_data, nrhs, (pastix_complex32_t *)b, ldb );
-        break;
-    case PastixDouble:
-        sopalin_ddiag( pastix_data, &sopalin_data, nrhs, (double *)b, ldb );
-        break;
-    case PastixFloat:
-        sopalin_sdiag( pastix_data, &sopalin_data, nrhs, (float *)b, ldb );
-        break;
-    default:
-        fprintf(stderr, "Unknown floating point arithmetic\n" );
-    }
+    solve_diag( pastix_data, pastix_data->solvmatr, flttype, nrhs, b, ldb );
 
     return PASTIX_SUCCESS;
 }
@@ -380,8 +405,14 @@ pastix_subtask_diag( pastix_data_t *pastix_data, pastix_coeftype_t flttype,
  * @warning The input vector is considered already permuted. For a solve step
  * with permutation, see pastix_task_solve()
  *
+ * In mixed-precision (IPARM_MIXED), the right-hand sides are converted to
+ * the single precision of the factors for the solve, and converted back on
+ * exit. The same is done with IPARM_SOLVE_LOWPREC, where the triangular solves
+ * are applied to the single precision copy of the factors built after the
+ * factorization.
+ *
  * This routine is affected by the following parameters:
- *   IPARM_VERBOSE, IPARM_FACTORIZATION.
+ *   IPARM_VERBOSE, IPARM_FACTORIZATION, IPARM_SOLVE_LOWPREC.
  *
  *******************************************************************************
  *
@@ -408,8 +439,12 @@ int
 pastix_subtask_solve( pastix_data_t *pastix_data,
                       pastix_int_t nrhs, void *b, pastix_int_t ldb )
 {
-    pastix_int_t  *iparm;
-    pastix_bcsc_t *bcsc;
+    pastix_int_t     *iparm;
+    pastix_bcsc_t    *bcsc;
+    SolverMatrix     *solvmtx;
+    pastix_coeftype_t flttype;
+    void             *bx;
+    pastix_int_t      ldbx;
 
     /*
      * Check parameters
@@ -426,10 +461,34 @@ pastix_subtask_solve( pastix_data_t *pastix_data,
     iparm = pastix_data->iparm;
     bcsc  = pastix_data->bcsc;
 
+    /*
+     * The triangular solves stream the single precision copy of the factors
+     * if it exists. The solver matrix is given explicitly to the solves, and
+     * pastix_data->solvmatr is never modified, such that concurrent solves
+     * on the same instance are not affected.
+     */
+    solvmtx = ( pastix_data->solvlowp != NULL ) ? pastix_data->solvlowp : pastix_data->solvmatr;
+
+    /*
+     * In mixed-precision, the factors are stored in single precision, and the
+     * solve is applied to a single precision copy of the right-hand sides.
+     */
+    flttype = solvmtx->flttype;
+    bx      = b;
+    ldbx    = ldb;
+    if ( (int)flttype != bcsc->flttype ) {
+        ldbx = pastix_imax( 1, bcsc->gN );
+        MALLOC_INTERN( bx, ldbx * nrhs * pastix_size_of( flttype ), char );
+        if ( bvec_lag2lp( bcsc->flttype, bcsc->gN, nrhs, b, ldb, bx, ldbx ) ) {
+            errorPrintW( "pastix_subtask_solve: the right-hand sides overflow the single precision" );
+        }
+    }
+
     {
         double timer;
         pastix_trans_t trans = PastixTrans;
 
+        solverIdleInit( solvmtx );
         clockSyncStart( timer, pastix_data->inter_node_comm );
         switch ( iparm[IPARM_FACTORIZATION] ){
         case PastixFactLLH:
@@ -438,21 +497,21 @@ pastix_subtask_solve( pastix_data_t *pastix_data,
             pastix_attr_fallthrough;
 
         case PastixFactLLT:
-            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterPerm.rhs", bcsc->flttype, bcsc->gN, nrhs, b,  bcsc->gN );
+            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterPerm.rhs", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve L y = P b with y = L^t P x */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixLower,
-                                 PastixNoTrans, PastixNonUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterDown.rhs", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixLower,
+                        PastixNoTrans, PastixNonUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterDown.rhs", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve y = L^t (P x) */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixLower,
-                                 trans, PastixNonUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterUp.rhs", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixLower,
+                        trans, PastixNonUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LLTAfterUp.rhs", flttype, bcsc->gN, nrhs, bx, ldbx );
             break;
 
         case PastixFactLDLH:
@@ -461,55 +520,64 @@ pastix_subtask_solve( pastix_data_t *pastix_data,
             pastix_attr_fallthrough;
 
         case PastixFactLDLT:
-            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterPerm", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterPerm", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve L y = P b with y = D L^t P x */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixLower,
-                                 PastixNoTrans, PastixUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterDown", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixLower,
+                        PastixNoTrans, PastixUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterDown", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve y = D z with z = (L^t P x) */
-            pastix_subtask_diag( pastix_data, bcsc->flttype, nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterDiag", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_diag( pastix_data, solvmtx, flttype, nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterDiag", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve z = L^t (P x) */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixLower,
-                                 trans, PastixUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterUp", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixLower,
+                        trans, PastixUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LDLTAfterUp", flttype, bcsc->gN, nrhs, bx, ldbx );
             break;
 
         case PastixFactLU:
         default:
-            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterperm", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterperm", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve L y = P b with y = U P x */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixLower,
-                                 PastixNoTrans, PastixUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterDown", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixLower,
+                        PastixNoTrans, PastixUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterDown", flttype, bcsc->gN, nrhs, bx, ldbx );
 
             /* Solve y = U (P x) */
-            pastix_subtask_trsm( pastix_data, bcsc->flttype,
-                                 PastixLeft, PastixUpper,
-                                 PastixNoTrans, PastixNonUnit,
-                                 nrhs, b, ldb );
-            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterUp", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+            solve_trsm( pastix_data, solvmtx, flttype,
+                        PastixLeft, PastixUpper,
+                        PastixNoTrans, PastixNonUnit,
+                        nrhs, bx, ldbx );
+            dump_rhs( pastix_data->inter_node_procnum,  "LUAfterUp", flttype, bcsc->gN, nrhs, bx, ldbx );
             break;
         }
         clockSyncStop( timer, pastix_data->inter_node_comm );
 
-        dump_rhs( pastix_data->inter_node_procnum,  "Final", bcsc->flttype, bcsc->gN, nrhs, b, bcsc->gN );
+        dump_rhs( pastix_data->inter_node_procnum,  "Final", flttype, bcsc->gN, nrhs, bx, ldbx );
 
         pastix_data->dparm[DPARM_SOLV_TIME] = clockVal(timer);
         if ( iparm[IPARM_VERBOSE] > PastixVerboseNot ) {
             pastix_print( pastix_data->inter_node_procnum, 0, OUT_TIME_SOLV,
                           pastix_data->dparm[DPARM_SOLV_TIME] );
         }
+        if ( iparm[IPARM_VERBOSE] > PastixVerboseNo ) {
+            solverIdlePrint( solvmtx, pastix_data->inter_node_procnum,
+                             iparm[IPARM_VERBOSE] );
+        }
+    }
+
+    if ( bx != b ) {
+        bvec_lp2lag( bcsc->flttype, bcsc->gN, nrhs, bx, ldbx, b, ldb );
+        memFree_null( bx );
     }
 
     return EXIT_SUCCESS;
@@ -575,3 +643,432 @@ pastix_task_solve( pastix_data_t *pastix_data,
 
     return EXIT_SUCCESS;
 }
+
+/**
+ * @brief Apply the steps of the solve that follow the forward solve.
+ */
+static inline void
+pastix_subtask_solve_fwdfacto( pastix_data_t *pastix_data,
+                               pastix_int_t nrhs, void *b, pastix_int_t ldb )
+{
+    pastix_int_t   *iparm = pastix_data->iparm;
+    pastix_bcsc_t  *bcsc  = pastix_data->bcsc;
+    pastix_trans_t  trans = PastixTrans;
+    double          timer;
+
+    solverIdleInit( pastix_data->solvmatr );
+    clockSyncStart( timer, pastix_data->inter_node_comm );
+    switch ( iparm[IPARM_FACTORIZATION] ){
+    case PastixFactLLH:
+        trans = PastixConjTrans;
+
+        pastix_attr_fallthrough;
+
+    case PastixFactLLT:
+        /* Solve y = L^t (P x) */
+        pastix_subtask_trsm( pastix_data, bcsc->flttype,
+                             PastixLeft, PastixLower,
+                             trans, PastixNonUnit,
+                             nrhs, b, ldb );
+        break;
+
+    case PastixFactLDLH:
+        trans = PastixConjTrans;
+
+        pastix_attr_fallthrough;
+
+    case PastixFactLDLT:
+        /* Solve y = D z with z = (L^t P x) */
+        pastix_subtask_diag( pastix_data, bcsc->flttype, nrhs, b, ldb );
+
+        /* Solve z = L^t (P x) */
+        pastix_subtask_trsm( pastix_data, bcsc->flttype,
+                             PastixLeft, PastixLower,
+                             trans, PastixUnit,
+                             nrhs, b, ldb );
+        break;
+
+    case PastixFactLU:
+    default:
+        /* Solve y = U (P x) */
+        pastix_subtask_trsm( pastix_data, bcsc->flttype,
+                             PastixLeft, PastixUpper,
+                             PastixNoTrans, PastixNonUnit,
+                             nrhs, b, ldb );
+        break;
+    }
+    clockSyncStop( timer, pastix_data->inter_node_comm );
+
+    pastix_data->dparm[DPARM_SOLV_TIME] = clockVal(timer);
+    if ( iparm[IPARM_VERBOSE] > PastixVerboseNot ) {
+        pastix_print( pastix_data->inter_node_procnum, 0, OUT_TIME_SOLV,
+                      pastix_data->dparm[DPARM_SOLV_TIME] );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Perform the numerical factorization and the solve of the given
+ * problem, with the forward solve fused with the factorization.
+ *
+ * The forward solve of each cblk is applied by the panel factorization, while
+ * the panel is still in cache, and only the backward solve is applied after
+ * the factorization. This avoids a full pass over the L factor when the
+ * right-hand sides are known before the factorization.
+ *
+ * The fusion is applied with the sequential, static and dynamic schedulers in
+ * shared memory, without Schur complement, without mixed-precision, and if
+ * the compression is not delayed to the end of the factorization. Otherwise, this routine is
+ * equivalent to pastix_task_numfact() followed by pastix_task_solve().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] pastix_data
+ *          The pastix_data structure that describes the solver instance.
+ *
+ * @param[inout] spm
+ *          The sparse matrix to factorize (see pastix_task_numfact()).
+ *
+ * @param[in] nrhs
+ *          The number of right-and-side vectors.
+ *
+ * @param[inout] b
+ *          The right-and-side vectors (can be multiple RHS).
+ *          On exit, the solution is stored in place of the right-hand-side vector.
+ *
+ * @param[in] ldb
+ *          The leading dimension of the right-and-side vectors.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS on successful exit,
+ * @retval PASTIX_ERR_BADPARAMETER if one parameter is incorrect.
+ *
+ *******************************************************************************/
+int
+pastix_task_numfact_solve( pastix_data_t *pastix_data,
+                           spmatrix_t    *spm,
+                           pastix_int_t   nrhs,
+                           void          *b,
+                           pastix_int_t   ldb )
+{
+    SolverMatrix     *solvmtx;
+    pastix_bcsc_t    *bcsc;
+    pastix_int_t     *iparm;
+    solver_fwdsolve_t fwdsolve;
+    int               rc;
+
+    /*
+     * Check parameters
+     */
+    if ( (pastix_data == NULL) || (spm == NULL) || (b == NULL) ) {
+        errorPrint("pastix_task_numfact_solve: wrong parameters");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if ( !(pastix_data->steps & STEP_ANALYSE) ) {
+        errorPrint("pastix_task_numfact_solve: All steps from pastix_task_init() to pastix_task_blend() have to be called before calling this function");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+
+    iparm   = pastix_data->iparm;
+    solvmtx = pastix_data->solvmatr;
+
+    if ( ( (iparm[IPARM_SCHEDULER] != PastixSchedSequential) &&
+           (iparm[IPARM_SCHEDULER] != PastixSchedStatic)     &&
+           (iparm[IPARM_SCHEDULER] != PastixSchedDynamic) ) ||
+         (pastix_data->procnbr > 1)                          ||
+         (solvmtx->cblkschur < solvmtx->cblknbr)             ||
+         (iparm[IPARM_COMPRESS_WHEN] == PastixCompressWhenEnd) ||
+         (iparm[IPARM_MIXED]) )
+    {
+        rc = pastix_task_numfact( pastix_data, spm );
+        if ( rc != PASTIX_SUCCESS ) {
+            return rc;
+        }
+        return pastix_task_solve( pastix_data, nrhs, b, ldb );
+    }
+
+    if (iparm[IPARM_VERBOSE] > PastixVerboseNot) {
+        pastix_print( pastix_data->inter_node_procnum, 0, OUT_STEP_SOPALIN,
+                      pastixFactotypeStr( iparm[IPARM_FACTORIZATION] ) );
+    }
+
+    /* Invalidate upcoming steps */
+    pastix_data->steps &= ~( STEP_CSC2BCSC  |
+                             STEP_BCSC2CTAB |
+                             STEP_NUMFACT   |
+                             STEP_SOLVE     |
+                             STEP_REFINE    );
+
+    rc = pastix_subtask_spm2bcsc( pastix_data, spm );
+    if ( rc != PASTIX_SUCCESS ) {
+        return rc;
+    }
+
+    rc = pastix_subtask_bcsc2ctab( pastix_data );
+    if ( rc != PASTIX_SUCCESS ) {
+        return rc;
+    }
+    bcsc = pastix_data->bcsc;
+
+    /* Compute P * b */
+    pastix_subtask_applyorder( pastix_data, bcsc->flttype,
+                               PastixDirForward, bcsc->gN, nrhs, b, ldb );
+
+    /* Factorize A, and solve L y = P b on the fly */
+    fwdsolve.diag = ( (iparm[IPARM_FACTORIZATION] == PastixFactLLH) ||
+                      (iparm[IPARM_FACTORIZATION] == PastixFactLLT) ) ? PastixNonUnit : PastixUnit;
+    fwdsolve.nrhs = nrhs;
+    fwdsolve.b    = b;
+    fwdsolve.ldb  = ldb;
+
+    solvmtx->fwdsolve = &fwdsolve;
+    rc = pastix_subtask_sopalin( pastix_data );
+    solvmtx->fwdsolve = NULL;
+    if ( rc != PASTIX_SUCCESS ) {
+        return rc;
+    }
+
+    /* Solve the remaining steps with y */
+    pastix_subtask_solve_fwdfacto( pastix_data, nrhs, b, ldb );
+
+    /* Compute P^t * b */
+    pastix_subtask_applyorder( pastix_data, bcsc->flttype,
+                               PastixDirBackward, bcsc->gN, nrhs, b, ldb );
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Create a context to solve a factorized problem concurrently with
+ * other solves.
+ *
+ * The context owns its thread pool, the dependency counters and the
+ * workspaces of the solve, and only reads the factorization. Several user
+ * threads can thus call pastix_task_solve_context() on the same factorized
+ * problem, each with its own context. The context must be created after the
+ * numerical factorization, and created again if the problem is factorized
+ * again. The context solves with the single precision copy of the factors if
+ * it has been built (IPARM_SOLVE_LOWPREC).
+ *
+ * The static scheduler is kept only if thrdnbr is the number of threads used
+ * by the analysis, otherwise the dynamic scheduler is used. The runtime
+ * schedulers, and the distributed solve are not supported.
+ *
+ *******************************************************************************
+ *
+ * @param[in] pastix_data
+ *          The pastix_data structure of the factorized problem.
+ *
+ * @param[in] thrdnbr
+ *          The number of threads of the context. If thrdnbr < 1, the number of
+ *          threads of the problem is used.
+ *
+ * @param[in] bindtab
+ *          Integer array of size thrdnbr that specifies the binding of the
+ *          threads of the context (see pastixInitWithAffinity()). The contexts
+ *          running concurrently should be bound to disjoint sets of cores. If
+ *          NULL, the threads of the context are not bound, and their placement
+ *          is left to the system.
+ *
+ * @param[out] context
+ *          On exit, the allocated context.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS on successful exit,
+ * @retval PASTIX_ERR_BADPARAMETER if one parameter is incorrect.
+ * @retval PASTIX_ERR_NOTIMPLEMENTED if the problem is distributed.
+ *
+ *******************************************************************************/
+int
+pastixSolveContextInit( pastix_data_t           *pastix_data,
+                        int                      thrdnbr,
+                        const int               *bindtab,
+                        pastix_solve_context_t **context )
+{
+    pastix_solve_context_t *ctx;
+    SolverMatrix           *solvmtx, *solvsrc;
+    pastix_int_t            sched;
+    int                    *unbound = NULL;
+    int                     i;
+
+    /*
+     * Check parameters
+     */
+    if (pastix_data == NULL) {
+        errorPrint("pastixSolveContextInit: wrong pastix_data parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if (context == NULL) {
+        errorPrint("pastixSolveContextInit: wrong context parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if ( !(pastix_data->steps & STEP_NUMFACT) ) {
+        errorPrint("pastixSolveContextInit: All steps from pastix_task_init() to pastix_task_numfact() have to be called before calling this function");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+    if ( pastix_data->inter_node_procnbr > 1 ) {
+        errorPrint("pastixSolveContextInit: concurrent solves are not available with distributed problems");
+        return PASTIX_ERR_NOTIMPLEMENTED;
+    }
+
+    MALLOC_INTERN( ctx, 1, pastix_solve_context_t );
+    memcpy( ctx->iparm, pastix_data->iparm, IPARM_SIZE * sizeof(pastix_int_t) );
+    memcpy( ctx->dparm, pastix_data->dparm, DPARM_SIZE * sizeof(double) );
+
+    /*
+     * Private copy of the column blocks, of the single precision copy of the
+     * factors if it exists
+     */
+    solvmtx = &(ctx->solvmtx);
+    solvsrc = (pastix_data->solvlowp != NULL) ? pastix_data->solvlowp : pastix_data->solvmatr;
+    memcpy( solvmtx, solvsrc, sizeof(SolverMatrix) );
+    MALLOC_INTERN( solvmtx->cblktab, solvmtx->cblknbr + 1, SolverCblk );
+    memcpy( solvmtx->cblktab, solvsrc->cblktab,
+            (solvmtx->cblknbr + 1) * sizeof(SolverCblk) );
+    solvmtx->computeQueue = NULL;
+    solvmtx->computeDeque = NULL;
+    solvmtx->fwdsolve     = NULL;
+
+    /* Private thread pool */
+    if ( thrdnbr < 1 ) {
+        thrdnbr = pastix_data->isched->world_size;
+    }
+    ctx->iparm[IPARM_THREAD_NBR] = thrdnbr;
+
+    /* The idle counters are allocated by solverIdleInit() for the threads of the context */
+    solvmtx->thrdnbr  = thrdnbr;
+    solvmtx->idletime = NULL;
+
+    /*
+     * The static scheduler follows the task lists of the analysis, and can
+     * only run with the same number of threads.
+     */
+    sched = ctx->iparm[IPARM_SCHEDULER];
+    if ( thrdnbr == 1 ) {
+        sched = PastixSchedSequential;
+    }
+    else if ( (sched != PastixSchedSequential) &&
+              ((sched != PastixSchedStatic) || (thrdnbr != solvmtx->bublnbr)) )
+    {
+        sched = PastixSchedDynamic;
+    }
+    ctx->iparm[IPARM_SCHEDULER] = sched;
+
+    /* Make sure the permutation of the right hand sides does not modify peritab */
+    ctx->iparm[IPARM_APPLYPERM_WS] = 1;
+
+    memcpy( &(ctx->pastix_data), pastix_data, sizeof(pastix_data_t) );
+    ctx->pastix_data.iparm    = ctx->iparm;
+    ctx->pastix_data.dparm    = ctx->dparm;
+    ctx->pastix_data.solvmatr = solvmtx;
+    ctx->pastix_data.solvlowp = NULL;
+    ctx->pastix_data.parsec   = NULL;
+    ctx->pastix_data.starpu   = NULL;
+    ctx->pastix_data.trace    = NULL;
+
+    /*
+     * Without a binding, the threads are left unbound, instead of the default
+     * binding of ischedInit() that would place the threads of all the contexts
+     * on the same cores
+     */
+    if ( bindtab == NULL ) {
+        MALLOC_INTERN( unbound, thrdnbr, int );
+        for (i = 0; i < thrdnbr; i++) {
+            unbound[i] = -1;
+        }
+        bindtab = unbound;
+    }
+    ctx->pastix_data.isched = ischedInit( thrdnbr, bindtab );
+    if ( unbound != NULL ) {
+        memFree_null( unbound );
+    }
+
+    *context = ctx;
+    return PASTIX_SUCCESS;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Free a context created by pastixSolveContextInit().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] context
+ *          The context to free. On exit, context is set to NULL.
+ *
+ *******************************************************************************/
+void
+pastixSolveContextFinalize( pastix_solve_context_t **context )
+{
+    pastix_solve_context_t *ctx;
+
+    if ( (context == NULL) || (*context == NULL) ) {
+        return;
+    }
+    ctx = *context;
+
+    ischedFinalize( ctx->pastix_data.isched );
+    memFree_null( ctx->solvmtx.cblktab );
+    memFree_null( ctx->solvmtx.idletime );
+    memFree_null( ctx );
+    *context = NULL;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @ingroup pastix_users
+ *
+ * @brief Solve the given problem within a solve context.
+ *
+ * This routine is equivalent to pastix_task_solve(), but it can be called
+ * concurrently on the same factorized problem from several threads, as long as
+ * each of them uses its own context. The timing and the statistics of the
+ * solve are stored in the dparm array of the context.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] context
+ *          The context created by pastixSolveContextInit().
+ *
+ * @param[in] nrhs
+ *          The number of right-and-side vectors.
+ *
+ * @param[inout] b
+ *          The right-and-side vectors (can be multiple RHS).
+ *          On exit, the solution is stored in place of the right-hand-side vector.
+ *
+ * @param[in] ldb
+ *          The leading dimension of the right-and-side vectors.
+ *
+ *******************************************************************************
+ *
+ * @retval PASTIX_SUCCESS on successful exit,
+ * @retval PASTIX_ERR_BADPARAMETER if one parameter is incorrect.
+ *
+ *******************************************************************************/
+int
+pastix_task_solve_context( pastix_solve_context_t *context,
+                           pastix_int_t            nrhs,
+                           void                   *b,
+                           pastix_int_t            ldb )
+{
+    if (context == NULL) {
+        errorPrint("pastix_task_solve_context: wrong context parameter");
+        return PASTIX_ERR_BADPARAMETER;
+    }
+
+    return pastix_task_solve( &(context->pastix_data), nrhs, b, ldb );
+}
@@ -20,6 +20,7 @@
 #include "isched.h"
 #include "spm.h"
 #include "bcsc.h"
+#include "bvec.h"
 #include "blend/solver.h"
 #include "coeftab.h"
 #include "sopalin_data.h"
@@ -29,6 +30,7 @@
 #include "kernels/pastix_dlrcores.h"
 #include "kernels/pastix_slrcores.h"
 #include "kernels/kernels_trace.h"
+#include "models.h"
 
 #if defined(PASTIX_WITH_PARSEC)
 #include "sopalin/parsec/pastix_parsec.h"
@@ -57,8 +59,13 @@ static void (*sopalinFacto[5][4])(pastix_data_t *, sopalin_data_t*) =
  * This internal block CSC can be used by the refinement step with or without
  * the preconditioner obtained by the numerical factorization.
  *
+ * If IPARM_REUSE_SCATTER_MAP is set, the scatter map of the spm values is
+ * computed with the block CSC. The next calls with an spm of the same
+ * structure only update the values of the block CSC, and the coeftab is then
+ * refilled without being reallocated.
+ *
  * This routine is affected by the following parameters:
- *   IPARM_VERBOSE.
+ *   IPARM_VERBOSE, IPARM_REUSE_SCATTER_MAP.
  *
  *******************************************************************************
  *
@@ -131,22 +138,44 @@ pastix_subtask_spm2bcsc( pastix_data_t *pastix_data,
     }
 
     /*
-     * Fill in the internal blocked CSC. We consider that if this step is called
-     * the spm values have changed so we need to update the blocked csc.
+     * If the structure of the spm is unchanged, only the values of the
+     * internal blocked CSC are updated through the scatter map.
      */
-    if ( pastix_data->bcsc != NULL )
+    if ( pastix_data->iparm[IPARM_REUSE_SCATTER_MAP] &&
+         (pastix_data->bcsc != NULL) &&
+         ((pastix_int_t)(pastix_data->solvmatr->factotype) == pastix_data->iparm[IPARM_FACTORIZATION]) &&
+         bcscMapCheck( spm, pastix_data->bcsc ) )
     {
-        bcscExit( pastix_data->bcsc );
-        memFree_null( pastix_data->bcsc );
+        time = bcscUpdateValues( spm, pastix_data->isched, pastix_data->bcsc );
     }
+    else
+    {
+        /*
+         * Fill in the internal blocked CSC. We consider that if this step is
+         * called the spm values have changed so we need to update the blocked
+         * csc.
+         */
+        if ( pastix_data->bcsc != NULL )
+        {
+            bcscExit( pastix_data->bcsc );
+            memFree_null( pastix_data->bcsc );
+        }
+
+        MALLOC_INTERN( pastix_data->bcsc, 1, pastix_bcsc_t );
 
-    MALLOC_INTERN( pastix_data->bcsc, 1, pastix_bcsc_t );
+        time = bcscInit( spm,
+                         pastix_data->ordemesh,
+                         pastix_data->solvmatr,
+                         (pastix_data->iparm[IPARM_FACTORIZATION] == PastixFactLU), /*&& (! pastix_data->iparm[IPARM_ONLY_REFINE]) )*/
+                         pastix_data->isched,
+                         pastix_data->bcsc );
 
-    time = bcscInit( spm,
-                     pastix_data->ordemesh,
-                     pastix_data->solvmatr,
-                     (pastix_data->iparm[IPARM_FACTORIZATION] == PastixFactLU), /*&& (! pastix_data->iparm[IPARM_ONLY_REFINE]) )*/
-                     pastix_data->bcsc );
+        /* Compute the scatter map for the next factorizations */
+        if ( pastix_data->iparm[IPARM_REUSE_SCATTER_MAP] ) {
+            bcscMapInit( spm, pastix_data->ordemesh,
+                         pastix_data->solvmatr, pastix_data->bcsc );
+        }
+    }
 
     if ( pastix_data->iparm[IPARM_VERBOSE] > PastixVerboseNot ) {
         pastix_print( pastix_data->inter_node_procnum, 0, OUT_BCSC_TIME, time );
@@ -175,8 +204,12 @@ pastix_subtask_spm2bcsc( pastix_data_t *pastix_data,
  * This step is linked with the pastix_subtask_sopalin() since this structure is
  * only used during the numerical factorization.
  *
+ * If IPARM_MIXED is set and the matrix is in double precision, the solver
+ * matrix is stored in the single precision arithmetic, and the block csc is
+ * kept in double precision for the refinement.
+ *
  * This routine is affected by the following parameters:
- *   IPARM_VERBOSE, [IPARM_FACTORIZATION.
+ *   IPARM_VERBOSE, IPARM_FACTORIZATION, IPARM_MIXED.
  *
  *******************************************************************************
  *
@@ -195,8 +228,9 @@ pastix_subtask_spm2bcsc( pastix_data_t *pastix_data,
 int
 pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
 {
-    pastix_bcsc_t *bcsc;
-    pastix_lr_t   *lr;
+    pastix_bcsc_t    *bcsc;
+    pastix_lr_t      *lr;
+    pastix_coeftype_t flttype;
     Clock timer;
     int mtxtype;
 
@@ -227,19 +261,57 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
     lr->compress_preselect  = pastix_data->iparm[IPARM_COMPRESS_PRESELECT];
     lr->use_reltol          = pastix_data->iparm[IPARM_COMPRESS_RELTOL];
     lr->tolerance           = pastix_data->dparm[DPARM_COMPRESS_TOLERANCE];
-
-    pastix_lr_minratio      = pastix_data->dparm[DPARM_COMPRESS_MIN_RATIO];
-    pastix_lr_ortho         = pastix_data->iparm[IPARM_COMPRESS_ORTHO];
+    lr->compress_min_ratio  = pastix_data->dparm[DPARM_COMPRESS_MIN_RATIO];
+    lr->compress_ortho      = pastix_data->iparm[IPARM_COMPRESS_ORTHO];
+    lr->compress_lowprec    = pastix_data->iparm[IPARM_COMPRESS_LOWPREC];
+    lr->use_sketch          = pastix_data->iparm[IPARM_COMPRESS_SKETCH];
 
     bcsc = pastix_data->bcsc;
-    lr->core_ge2lr = ge2lrMethods[ pastix_data->iparm[IPARM_COMPRESS_METHOD] ][bcsc->flttype-2];
-    lr->core_rradd = rraddMethods[ pastix_data->iparm[IPARM_COMPRESS_METHOD] ][bcsc->flttype-2];
+
+    /* Select the arithmetic of the factors */
+    flttype = bcsc->flttype;
+    if ( pastix_data->iparm[IPARM_MIXED] ) {
+        if ( pastix_data->schur_n > 0 ) {
+            errorPrintW( "pastix_subtask_bcsc2ctab: IPARM_MIXED is not available with a Schur complement, it is ignored" );
+        }
+        else {
+            flttype = bvec_lowprec( bcsc->flttype );
+        }
+    }
+    pastix_data->solvmatr->flttype = flttype;
+
+    /* The single precision bases are only available with double precision factors */
+    if ( lr->compress_lowprec ) {
+        if ( bvec_lowprec( flttype ) == flttype ) {
+            lr->compress_lowprec = 0;
+        }
+        else if ( (pastix_data->inter_node_procnbr > 1) ||
+                  (pastix_data->iparm[IPARM_SCHEDULER] == PastixSchedParsec) ||
+                  (pastix_data->iparm[IPARM_SCHEDULER] == PastixSchedStarPU) )
+        {
+            errorPrintW( "pastix_subtask_bcsc2ctab: IPARM_COMPRESS_LOWPREC is only available with the internal schedulers on shared memory, it is ignored" );
+            lr->compress_lowprec = 0;
+        }
+    }
+
+    /*
+     * The compression policy selects the method of each block with the GEMM
+     * model of the factorization arithmetic
+     */
+    lr->compress_policy = pastix_data->iparm[IPARM_COMPRESS_POLICY];
+    lr->policy_coefs    = NULL;
+    if ( lr->compress_policy && (pastix_data->cpu_models != NULL) ) {
+        lr->policy_coefs = pastix_data->cpu_models->coefficients[flttype-2][PastixKernelGEMMBlok2d2d];
+    }
+
+    lr->core_ge2lr = ge2lrMethods[ pastix_data->iparm[IPARM_COMPRESS_METHOD] ][flttype-2];
+    lr->core_rradd = rraddMethods[ pastix_data->iparm[IPARM_COMPRESS_METHOD] ][flttype-2];
 
     if ( pastix_data->iparm[IPARM_COMPRESS_WHEN] == PastixCompressWhenBegin ) {
         if ( lr->compress_preselect == -1 ) {
             lr->compress_preselect = 1;
         }
-        core_get_rklimit = core_get_rklimit_begin;
+        lr->core_rklimit = core_get_rklimit_begin;
     }
     else {
         if ( lr->compress_preselect == -1 ) {
@@ -250,7 +322,7 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
                 lr->compress_preselect = 1;
             }
         }
-        core_get_rklimit = core_get_rklimit_end;
+        lr->core_rklimit = core_get_rklimit_end;
     }
 
     pastix_data->solvmatr->factotype = pastix_data->iparm[IPARM_FACTORIZATION];
@@ -258,15 +330,36 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
     /*
      * Fill in the internal coeftab structure. We consider that if this step is
      * called the bcsc values have changed, or a factorization have already been
-     * performed, so we need to update the coeftab arrays.
+     * performed, so we need to update the coeftab arrays. If the coeftab has
+     * already been initialized with the structure of the bcsc, it is refilled
+     * through the scatter map. The runtime descriptors are always rebuilt. The
+     * scatter map is not used in mixed-precision. The single precision copy of
+     * the previous factors, if any, is released.
      */
-    if (pastix_data->bcsc != NULL)
+    coeftabLowPrecisionExit( pastix_data );
+
+    if ( (bcsc->map != NULL) && bcsc->map->ctabinit &&
+         ((int)flttype == bcsc->flttype) &&
+         (pastix_data->iparm[IPARM_SCHEDULER] != PastixSchedParsec) &&
+         (pastix_data->iparm[IPARM_SCHEDULER] != PastixSchedStarPU) )
     {
-        coeftabExit( pastix_data->solvmatr );
+        coeftabRefill( pastix_data,
+                       pastix_data->iparm[IPARM_FACTORIZATION] == PastixFactLU ? PastixLUCoef : PastixLCoef );
     }
+    else
+    {
+        if (pastix_data->bcsc != NULL)
+        {
+            coeftabExit( pastix_data->solvmatr );
+        }
+
+        coeftabInit( pastix_data,
+                     pastix_data->iparm[IPARM_FACTORIZATION] == PastixFactLU ? PastixLUCoef : PastixLCoef );
 
-    coeftabInit( pastix_data,
-                 pastix_data->iparm[IPARM_FACTORIZATION] == PastixFactLU ? PastixLUCoef : PastixLCoef );
+        if ( bcsc->map != NULL ) {
+            bcsc->map->ctabinit = ((int)flttype == bcsc->flttype);
+        }
+    }
 
     switch( pastix_data->iparm[IPARM_FACTORIZATION] ) {
     case PastixFactLLH:
@@ -294,7 +387,7 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
         }
         /* Create the matrix descriptor */
         parsec_sparse_matrix_init( pastix_data->solvmatr,
-                                   pastix_size_of( bcsc->flttype ), mtxtype,
+                                   pastix_size_of( flttype ), mtxtype,
                                    pastix_data->inter_node_procnbr,
                                    pastix_data->inter_node_procnum );
     }
@@ -305,7 +398,7 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
     {
         /* Create the matrix descriptor */
         starpu_sparse_matrix_init( pastix_data->solvmatr,
-                                   pastix_size_of( bcsc->flttype ), mtxtype,
+                                   pastix_size_of( flttype ), mtxtype,
                                    pastix_data->inter_node_procnbr,
                                    pastix_data->inter_node_procnum );
     }
@@ -325,6 +418,67 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
     return PASTIX_SUCCESS;
 }
 
+/**
+ *******************************************************************************
+ *
+ * @brief Select the cblks whose updates are computed by the small GEMM kernel.
+ *
+ * A 1D dense cblk is selected if the performance model of the GEMM kernels
+ * predicts that the call overhead dominates its largest update: the product of
+ * all its off-diagonal rows by the largest off-diagonal block. This is
+ * typically the case of the cblks in the lower levels of the elimination tree.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] solvmtx
+ *          The solver matrix structure. On exit, the gemmsmall field of the
+ *          cblks is updated.
+ *
+ * @param[in] coefs
+ *          The coefficients of the model of the 1D GEMM kernel in the
+ *          arithmetic of the factorization.
+ *
+ *******************************************************************************
+ *
+ * @return The number of selected cblks.
+ *
+ *******************************************************************************/
+static pastix_int_t
+sopalin_gemmsmall_init( SolverMatrix *solvmtx,
+                        const double *coefs )
+{
+    SolverCblk  *cblk = solvmtx->cblktab;
+    SolverBlok  *blok;
+    pastix_int_t i, M, N, K;
+    pastix_int_t nbsmall = 0;
+
+    for( i=0; i<solvmtx->cblknbr; i++, cblk++ ) {
+        cblk->gemmsmall = 0;
+
+        if ( cblk->cblktype & (CBLK_LAYOUT_2D | CBLK_COMPRESSED | CBLK_FANIN | CBLK_RECV) ) {
+            continue;
+        }
+
+        blok = cblk->fblokptr + 1;
+        if ( blok >= cblk[1].fblokptr ) {
+            continue;
+        }
+
+        K = cblk_colnbr( cblk );
+        M = cblk->stride - blok->coefind;
+        N = 0;
+        for( ; blok<cblk[1].fblokptr; blok++ ) {
+            N = pastix_imax( N, blok_rownbr( blok ) );
+        }
+
+        if ( modelsGemmIsSmall( coefs, M, N, K ) ) {
+            cblk->gemmsmall = 1;
+            nbsmall++;
+        }
+    }
+    return nbsmall;
+}
+
 /**
  *******************************************************************************
  *
@@ -354,12 +508,13 @@ pastix_subtask_bcsc2ctab( pastix_data_t *pastix_data )
 int
 pastix_subtask_sopalin( pastix_data_t *pastix_data )
 {
-    sopalin_data_t  sopalin_data;
-    SolverBackup_t *sbackup;
-    pastix_bcsc_t  *bcsc;
-    PASTIX_Comm     pastix_comm;
-    pastix_int_t   *iparm;
-    double         *dparm;
+    sopalin_data_t    sopalin_data;
+    SolverBackup_t   *sbackup;
+    pastix_bcsc_t    *bcsc;
+    pastix_coeftype_t flttype;
+    PASTIX_Comm       pastix_comm;
+    pastix_int_t     *iparm;
+    double           *dparm;
 
     /*
      * Check parameters
@@ -391,6 +546,9 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
     iparm = pastix_data->iparm;
     dparm = pastix_data->dparm;
 
+    /* Arithmetic of the factors, that may differ from the bcsc one in mixed-precision */
+    flttype = pastix_data->solvmatr->flttype;
+
     /* Prepare the sopalin_data structure */
     {
         double threshold;
@@ -410,7 +568,7 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
              * intriduced in the pb when the pivot is too small
              */
             double eps;
-            if ( (bcsc->flttype == PastixFloat) || (bcsc->flttype == PastixComplex32) ) {
+            if ( (flttype == PastixFloat) || (flttype == PastixComplex32) ) {
                 eps = LAPACKE_slamch_work( 'e' );
             }
             else {
@@ -425,8 +583,18 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
         sopalin_data.solvmtx->diagthreshold = threshold;
         sopalin_data.solvmtx->nbpivots      = 0;
 
-        sopalin_data.cpu_coefs = &(pastix_data->cpu_models->coefficients[bcsc->flttype-2]);
-        sopalin_data.gpu_coefs = &(pastix_data->gpu_models->coefficients[bcsc->flttype-2]);
+        sopalin_data.cpu_coefs = &(pastix_data->cpu_models->coefficients[flttype-2]);
+        sopalin_data.gpu_coefs = &(pastix_data->gpu_models->coefficients[flttype-2]);
+
+        /*
+         * The selection only depends on the analysis and on the arithmetic of
+         * the factors, so it is done once for all the factorizations
+         */
+        if ( sopalin_data.solvmtx->gemmsmalltype != flttype ) {
+            sopalin_gemmsmall_init( sopalin_data.solvmtx,
+                                    (*sopalin_data.cpu_coefs)[PastixKernelGEMMCblk1d1d] );
+            sopalin_data.solvmtx->gemmsmalltype = flttype;
+        }
     }
 
     sbackup = solverBackupInit( pastix_data->solvmatr );
@@ -435,10 +603,11 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
         void (*factofct)( pastix_data_t *, sopalin_data_t *);
         double timer, timer_local, flops, flops_g = 0.;
 
-        factofct = sopalinFacto[ pastix_data->iparm[IPARM_FACTORIZATION] ][bcsc->flttype-2];
+        factofct = sopalinFacto[ pastix_data->iparm[IPARM_FACTORIZATION] ][flttype-2];
         assert(factofct);
 
         kernelsTraceStart( pastix_data );
+        solverIdleInit( pastix_data->solvmatr );
         clockSyncStart( timer, pastix_comm );
         clockStart(timer_local);
 
@@ -476,6 +645,10 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
                           pastix_print_unit(  flops_g ),
                           (long)pastix_data->iparm[IPARM_STATIC_PIVOTING] );
         }
+        if ( iparm[IPARM_VERBOSE] > PastixVerboseNo ) {
+            solverIdlePrint( pastix_data->solvmatr, pastix_data->inter_node_procnum,
+                             iparm[IPARM_VERBOSE] );
+        }
 
 #if defined(PASTIX_WITH_PARSEC) && defined(PASTIX_DEBUG_PARSEC)
         {
@@ -494,6 +667,12 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
     solverBackupRestore( pastix_data->solvmatr, sbackup );
     solverBackupExit( sbackup );
 
+    /* Store the low-rank bases left by the 2D and team paths in single precision */
+    coeftabCompact( pastix_data );
+
+    /* Build the single precision copy of the factors used by the solves */
+    coeftabLowPrecisionInit( pastix_data );
+
 #if defined(PASTIX_NUMFACT_DUMP_SOLVER)
     {
         FILE *stream = NULL;
@@ -513,7 +692,7 @@ pastix_subtask_sopalin( pastix_data_t *pastix_data )
          (pastix_data->iparm[IPARM_COMPRESS_WHEN] != PastixCompressNever) )
     {
         /* Compute the memory gain */
-        coeftabMemory[bcsc->flttype-2]( pastix_data->solvmatr );
+        coeftabMemory[flttype-2]( pastix_data->solvmatr );
     }
 
     /* Invalidate following steps, and add factorization step to the ones performed */
@@ -66,28 +66,34 @@ thread_zdiag_static( isched_thread_t *ctx, void *args )
     int ldb   = arg->ldb;
     SolverCblk *cblk;
     Task       *t;
-    pastix_int_t i, ii, cblknbr;
+    pastix_int_t i, ii, r, cblknbr;
     pastix_int_t tasknbr, *tasktab;
     pastix_solv_mode_t mode = pastix_data->iparm[IPARM_SCHUR_SOLV_MODE];
     int rank = ctx->rank;
+    int size = ctx->global_ctx->world_size;
 
-    tasknbr = datacode->ttsknbr[rank];
-    tasktab = datacode->ttsktab[rank];
     cblknbr = (mode == PastixSolvModeSchur) ? datacode->cblknbr : datacode->cblkschur;
 
-    for (ii=0; ii<tasknbr; ii++) {
-        i = tasktab[ii];
-        t = datacode->tasktab + i;
+    /* The task lists are distributed in a round-robin fashion when the solve
+     * runs with a different number of threads */
+    for (r=rank; r<datacode->bublnbr; r+=size) {
+        tasknbr = datacode->ttsknbr[r];
+        tasktab = datacode->ttsktab[r];
 
-        if ( t->cblknum >= cblknbr ) {
-            continue;
-        }
-        cblk = datacode->cblktab + t->cblknum;
-        if ( cblk->ownerid != datacode->clustnum ) {
-            continue;
+        for (ii=0; ii<tasknbr; ii++) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( t->cblknum >= cblknbr ) {
+                continue;
+            }
+            cblk = datacode->cblktab + t->cblknum;
+            if ( cblk->ownerid != datacode->clustnum ) {
+                continue;
+            }
+            solve_cblk_zdiag( cblk, nrhs,
+                              b + cblk->lcolidx, ldb, NULL );
         }
-        solve_cblk_zdiag( cblk, nrhs,
-                          b + cblk->lcolidx, ldb, NULL );
     }
 }
 
@@ -123,17 +123,264 @@ struct args_zgetrf_t
 {
     sopalin_data_t     *sopalin_data;
     volatile int32_t    taskcnt;
+    solver_tasks2d_t    tasks2d;
+    solver_team_t       team;
+    solver_subtrees_t   subtrees;
 };
 
+/**
+ * @brief Return the pointer to the coefficients of a block in the given
+ * coeftab, or NULL if the cblk is compressed.
+ */
+static inline pastix_complex64_t *
+zgetrf_blok_coeftab( const SolverCblk *cblk,
+                     const SolverBlok *blok,
+                     void             *coeftab )
+{
+    if ( cblk->cblktype & CBLK_COMPRESSED ) {
+        return NULL;
+    }
+    return ((pastix_complex64_t *)coeftab) + blok->coefind;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Factorize the diagonal block of a 2D cblk, and release its TRSM tasks.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[inout] cblk
+ *          The 2D cblk to factorize.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+static inline void
+dynamic_zgetrf_panel2d( SolverMatrix           *datacode,
+                        const solver_tasks2d_t *tasks2d,
+                        SolverCblk             *cblk,
+                        int                     rank )
+{
+    /* Compression between 1D and 2D updates */
+    if ( (cblk->cblktype & CBLK_COMPRESSED) &&
+         (datacode->lowrank.compress_when == PastixCompressWhenDuring) )
+    {
+        cpucblk_zcompress( datacode, PastixLUCoef, cblk );
+    }
+
+    cpucblk_zgetrfsp1d_getrf( datacode, cblk, cblk->lcoeftab, cblk->ucoeftab );
+    solverTasks2dReleasePanel( datacode, tasks2d, cblk, rank );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Execute a block-level task of a 2D cblk, and release its dependencies.
+ *
+ * The GEMM tasks lock the blocks of the facing cblk that they update, in
+ * ascending order, with solverTasks2dLockGemm() before calling the block
+ * kernels, and release them with solverTasks2dUnlockGemm().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[in] task
+ *          The task to execute.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+static inline void
+dynamic_zgetrf_task2d( SolverMatrix           *datacode,
+                       const solver_tasks2d_t *tasks2d,
+                       const solver_task2d_t  *task,
+                       int                     rank )
+{
+    SolverCblk         *cblk = datacode->cblktab + task->cblknum;
+    pastix_complex64_t *L    = cblk->lcoeftab;
+    pastix_complex64_t *U    = cblk->ucoeftab;
+    const SolverBlok   *blokA, *blokB, *blokC;
+    SolverCblk         *fcblk;
+
+    blokA = cblk->fblokptr + task->blok_mk;
+
+    if ( task->type == TASK2D_TRSM ) {
+        cpublok_ztrsmsp( PastixLCoef, PastixRight, PastixUpper,
+                         PastixNoTrans, PastixNonUnit,
+                         cblk, task->blok_mk, L, zgetrf_blok_coeftab( cblk, blokA, L ),
+                         &(datacode->lowrank) );
+        cpublok_ztrsmsp( PastixUCoef, PastixRight, PastixUpper,
+                         PastixNoTrans, PastixUnit,
+                         cblk, task->blok_mk, U, zgetrf_blok_coeftab( cblk, blokA, U ),
+                         &(datacode->lowrank) );
+        solverTasks2dReleaseTrsm( datacode, tasks2d, task, rank );
+    }
+    else {
+        blokB = cblk->fblokptr + task->blok_nk;
+        fcblk = datacode->cblktab + blokB->fcblknm;
+        blokC = fcblk->fblokptr + task->blok_mn;
+
+        solverTasks2dLockGemm( datacode, task );
+        /* Update on L */
+        cpublok_zgemmsp( PastixLCoef, PastixUCoef, PastixTrans,
+                         cblk, fcblk,
+                         task->blok_mk, task->blok_nk, task->blok_mn,
+                         zgetrf_blok_coeftab( cblk,  blokA, L ),
+                         zgetrf_blok_coeftab( cblk,  blokB, U ),
+                         zgetrf_blok_coeftab( fcblk, blokC, fcblk->lcoeftab ),
+                         &(datacode->lowrank) );
+
+        /* Update on U, the diagonal block is fully updated in L */
+        if ( task->m != task->n ) {
+            cpublok_zgemmsp( PastixUCoef, PastixLCoef, PastixTrans,
+                             cblk, fcblk,
+                             task->blok_mk, task->blok_nk, task->blok_mn,
+                             zgetrf_blok_coeftab( cblk,  blokA, U ),
+                             zgetrf_blok_coeftab( cblk,  blokB, L ),
+                             zgetrf_blok_coeftab( fcblk, blokC, fcblk->ucoeftab ),
+                             &(datacode->lowrank) );
+        }
+        solverTasks2dUnlockGemm( datacode, task );
+        solverTasks2dReleaseGemm( datacode, tasks2d, task, rank );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Apply the update generated by one off-diagonal block of a cblk of the
+ * tail of the elimination tree, shared with the idle threads.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] args
+ *          Unused.
+ *
+ * @param[in] cblk
+ *          The factorized cblk.
+ *
+ * @param[in] blok
+ *          The off-diagonal block generating the update.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ *******************************************************************************/
+static void
+dynamic_zgetrf_team_update( SolverMatrix *datacode,
+                            void         *args,
+                            SolverCblk   *cblk,
+                            SolverBlok   *blok,
+                            void         *work,
+                            pastix_int_t  lwork )
+{
+    pastix_complex64_t *L = cblk->lcoeftab;
+    pastix_complex64_t *U = cblk->ucoeftab;
+    SolverCblk         *fcblk = datacode->cblktab + blok->fcblknm;
+
+    /* Update on L */
+    cpucblk_zgemmsp( PastixLCoef, PastixUCoef, PastixTrans,
+                     cblk, blok, fcblk,
+                     L, U, fcblk->lcoeftab,
+                     work, lwork, &(datacode->lowrank) );
+
+    /* Update on U */
+    if ( blok+1 < cblk[1].fblokptr ) {
+        cpucblk_zgemmsp( PastixUCoef, PastixLCoef, PastixTrans,
+                         cblk, blok, fcblk,
+                         U, L, fcblk->ucoeftab,
+                         work, lwork, &(datacode->lowrank) );
+    }
+    (void)args;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Factorize all the cblks of a leaf subtree in increasing order.
+ *
+ * The cblks of the subtree are never released by their dependencies, and
+ * they are all factorized by the thread that popped the root of the subtree.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] subtrees
+ *          The subtrees structure.
+ *
+ * @param[in] cblknum
+ *          The index of the root of the subtree.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************
+ *
+ * @return The number of factorized cblks.
+ *
+ *******************************************************************************/
+static inline int32_t
+dynamic_zgetrf_subtree( SolverMatrix            *datacode,
+                        const solver_subtrees_t *subtrees,
+                        pastix_int_t             cblknum,
+                        pastix_complex64_t      *work,
+                        pastix_int_t             lwork,
+                        int                      rank )
+{
+    SolverCblk  *cblk;
+    pastix_int_t s = solverSubtreesGet( subtrees, cblknum );
+    pastix_int_t i;
+
+    for ( i = subtrees->cblkptr[s]; i < subtrees->cblkptr[s+1]; i++ ) {
+        cblk = datacode->cblktab + subtrees->cblktab[i];
+        cblk->threadid = rank;
+        cpucblk_zgetrfsp1d( datacode, cblk,
+                            work, lwork );
+    }
+    return subtrees->cblkptr[s+1] - subtrees->cblkptr[s];
+}
+
 void
 thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
 {
     struct args_zgetrf_t *arg = (struct args_zgetrf_t*)args;
     sopalin_data_t       *sopalin_data = arg->sopalin_data;
+    solver_tasks2d_t     *tasks2d = &(arg->tasks2d);
+    solver_team_t        *team = &(arg->team);
+    solver_subtrees_t    *subtrees = &(arg->subtrees);
     SolverMatrix         *datacode = sopalin_data->solvmtx;
     SolverCblk           *cblk;
     Task                 *t;
-    pastix_queue_t       *computeQueue;
+    pastix_queue_t       *computeQueue = NULL;
+    pastix_deque_t       *computeDeque = NULL;
     pastix_complex64_t   *work;
     pastix_int_t          i, ii, lwork;
     pastix_int_t          tasknbr, *tasktab, cblknum;
@@ -146,20 +393,40 @@ thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
         lwork = pastix_imax( lwork, 2 * datacode->blokmax );
     }
     MALLOC_INTERN( work, lwork, pastix_complex64_t );
-    MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
-
-    tasknbr      = datacode->ttsknbr[rank];
-    tasktab      = datacode->ttsktab[rank];
-    computeQueue = datacode->computeQueue[rank];
-    pqueueInit( computeQueue, tasknbr );
-
-    /* Initialize the local task queue with available cblks */
-    for (ii=0; ii<tasknbr; ii++) {
-        i = tasktab[ii];
-        t = datacode->tasktab + i;
+    tasknbr = datacode->ttsknbr[rank];
+    tasktab = datacode->ttsktab[rank];
 
-        if ( !(t->ctrbcnt) ) {
-            pqueuePush1( computeQueue, t->cblknum, t->prionum );
+    if ( datacode->computeDeque ) {
+        MALLOC_INTERN( datacode->computeDeque[rank], 1, pastix_deque_t );
+        computeDeque = datacode->computeDeque[rank];
+        pdequeInit( computeDeque, tasknbr );
+
+        /*
+         * Initialize the local deque with available cblks in reverse priority
+         * order, such that the most urgent ones are popped first
+         */
+        for (ii=tasknbr-1; ii>=0; ii--) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pdequePush( computeDeque, t->cblknum );
+            }
+        }
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
+        computeQueue = datacode->computeQueue[rank];
+        pqueueInit( computeQueue, tasknbr );
+
+        /* Initialize the local task queue with available cblks */
+        for (ii=0; ii<tasknbr; ii++) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pqueuePush1( computeQueue, t->cblknum, t->prionum );
+            }
         }
     }
 
@@ -168,13 +435,13 @@ thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
 
     while( arg->taskcnt > 0 )
     {
-        cblknum = pqueuePop(computeQueue);
+        cblknum = popQueue( datacode, rank );
 
 #if defined(PASTIX_WITH_MPI)
         /* Nothing to do, let's make progress on comunications */
         if( cblknum == -1 ) {
             cpucblk_zmpi_progress( PastixLUCoef, datacode, rank );
-            cblknum = pqueuePop(computeQueue);
+            cblknum = popQueue( datacode, rank );
         }
 #endif
 
@@ -188,8 +455,18 @@ thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
                                   ctx->global_ctx->world_size );
         }
 
-        /* Still no job, let's loop again */
+        /* Still no job, let's help the team of a tail cblk, and loop again */
         if ( cblknum == -1 ) {
+            solverTeamHelp( datacode, team, work, lwork, rank );
+            continue;
+        }
+
+        /* Block-level task of a 2D cblk */
+        if ( cblknum >= datacode->cblknbr ) {
+            dynamic_zgetrf_task2d( datacode, tasks2d,
+                                   tasks2d->tasktab + (cblknum - datacode->cblknbr),
+                                   rank );
+            local_taskcnt++;
             continue;
         }
 
@@ -199,6 +476,28 @@ thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
         }
         cblk->threadid = rank;
 
+        /* Factorize the whole leaf subtree of the root */
+        if ( solverSubtreesGet( subtrees, cblknum ) != -1 ) {
+            local_taskcnt += dynamic_zgetrf_subtree( datacode, subtrees, cblknum,
+                                                     work, lwork, rank );
+            continue;
+        }
+
+        if ( tasks2d->tasktab && (cblk->cblktype & CBLK_TASKS_2D) ) {
+            dynamic_zgetrf_panel2d( datacode, tasks2d, cblk, rank );
+            local_taskcnt++;
+            continue;
+        }
+
+        /* Share the updates of the tail cblks with the idle threads */
+        if ( solverTeamIsTail( team, cblknum ) ) {
+            cpucblk_zgetrfsp1d_panel( datacode, cblk, cblk->lcoeftab, cblk->ucoeftab );
+            solverTeamRun( datacode, team, cblk, dynamic_zgetrf_team_update, NULL,
+                           work, lwork, rank );
+            local_taskcnt++;
+            continue;
+        }
+
         /* Compute */
         cpucblk_zgetrfsp1d( datacode, cblk,
                             work, lwork );
@@ -208,8 +507,14 @@ thread_zgetrf_dynamic( isched_thread_t *ctx, void *args )
 
     /* Make sure that everyone is done before freeing */
     isched_barrier_wait( &(ctx->global_ctx->barrier) );
-    pqueueExit( computeQueue );
-    memFree_null( computeQueue );
+    if ( computeDeque ) {
+        pdequeExit( computeDeque );
+        memFree_null( computeDeque );
+    }
+    else {
+        pqueueExit( computeQueue );
+        memFree_null( computeQueue );
+    }
 }
 
 void
@@ -218,15 +523,82 @@ dynamic_zgetrf( pastix_data_t  *pastix_data,
 {
     SolverMatrix        *datacode = sopalin_data->solvmtx;
     int32_t              taskcnt = datacode->tasknbr;
-    struct args_zgetrf_t args_zgetrf = { sopalin_data, taskcnt };
+    pastix_int_t         i;
+    int                  thrdnbr;
+    struct args_zgetrf_t args_zgetrf;
+
+    /* The cblks of the Schur complement are skipped */
+    for (i=0; i<datacode->tasknbr; i++) {
+        if ( datacode->cblktab[ datacode->tasktab[i].cblknum ].cblktype & CBLK_IN_SCHUR ) {
+            taskcnt--;
+        }
+    }
 
-    /* Allocate the computeQueue */
-    MALLOC_INTERN( datacode->computeQueue,
-                   pastix_data->isched->world_size, pastix_queue_t * );
+    /*
+     * The 2D cblks are factorized with block-level tasks in shared memory. With
+     * multiple processes, they are kept as 1D tasks to handle the fanin cblks,
+     * as well as with a fused forward solve that is applied by the 1D panels.
+     */
+    args_zgetrf.sopalin_data = sopalin_data;
+    if ( (pastix_data->iparm[IPARM_TASKS2D_LEVEL] != 0) &&
+         (pastix_data->procnbr == 1) &&
+         (datacode->fwdsolve == NULL) )
+    {
+        taskcnt += solverTasks2dInit( datacode, &(args_zgetrf.tasks2d) );
+    }
+    else {
+        memset( &(args_zgetrf.tasks2d), 0, sizeof(solver_tasks2d_t) );
+    }
+    args_zgetrf.taskcnt = taskcnt;
+
+    /*
+     * The updates of the cblks of the tail of the elimination tree are shared
+     * with the idle threads in shared memory.
+     */
+    thrdnbr = pastix_data->isched->world_size;
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_TEAM] == 0) ||
+         (pastix_data->procnbr > 1) )
+    {
+        thrdnbr = 1;
+    }
+    solverTeamInit( datacode, &(args_zgetrf.team), thrdnbr );
+
+    /*
+     * The leaf subtrees below the cost threshold, clustered by the analysis,
+     * are factorized as single tasks in shared memory. The structure shares
+     * the arrays of the analysis.
+     */
+    if ( (datacode->subtrees != NULL) && (pastix_data->procnbr == 1) ) {
+        args_zgetrf.subtrees = *(datacode->subtrees);
+        solverSubtreesHold( datacode, datacode->subtrees );
+    }
+    else {
+        memset( &(args_zgetrf.subtrees), 0, sizeof(solver_subtrees_t) );
+    }
+
+    /*
+     * Allocate the computeQueue, or the work-stealing deques if requested.
+     * With multiple processes, the reception of remote contributions may
+     * release a task on behalf of another thread, so the locked heaps are
+     * always used.
+     */
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_QUEUE] == PastixDynQueueDeque) &&
+         (pastix_data->procnbr == 1) )
+    {
+        MALLOC_INTERN( datacode->computeDeque,
+                       pastix_data->isched->world_size, pastix_deque_t * );
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue,
+                       pastix_data->isched->world_size, pastix_queue_t * );
+    }
 
     isched_parallel_call( pastix_data->isched, thread_zgetrf_dynamic, &args_zgetrf );
 
     memFree_null( datacode->computeQueue );
+    memFree_null( datacode->computeDeque );
+    solverTasks2dExit( &(args_zgetrf.tasks2d) );
+    solverTeamExit( &(args_zgetrf.team) );
 
 #if defined(PASTIX_WITH_MPI)
     MPI_Barrier( pastix_data->inter_node_comm );
@@ -145,18 +145,137 @@ struct args_zhetrf_t
 {
     sopalin_data_t     *sopalin_data;
     volatile int32_t    taskcnt;
+    solver_team_t       team;
+    solver_subtrees_t   subtrees;
 };
 
+/**
+ *******************************************************************************
+ *
+ * @brief Apply the update generated by one off-diagonal block of a cblk of the
+ * tail of the elimination tree, shared with the idle threads.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] args
+ *          The DLh workspace of the thread that factorized the cblk, NULL if
+ *          the cblk is not stored with the 2D layout.
+ *
+ * @param[in] cblk
+ *          The factorized cblk.
+ *
+ * @param[in] blok
+ *          The off-diagonal block generating the update.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ *******************************************************************************/
+static void
+dynamic_zhetrf_team_update( SolverMatrix *datacode,
+                            void         *args,
+                            SolverCblk   *cblk,
+                            SolverBlok   *blok,
+                            void         *work,
+                            pastix_int_t  lwork )
+{
+    pastix_complex64_t *L     = cblk->lcoeftab;
+    pastix_complex64_t *DLh   = (pastix_complex64_t *)args;
+    SolverCblk         *fcblk = datacode->cblktab + blok->fcblknm;
+
+    /* Update on L */
+    if ( DLh == NULL ) {
+        core_zhetrfsp1d_gemm( cblk, blok, fcblk,
+                              L, fcblk->lcoeftab,
+                              work );
+    }
+    else {
+        cpucblk_zgemmsp( PastixLCoef, PastixUCoef, PastixTrans,
+                         cblk, blok, fcblk,
+                         L, DLh, fcblk->lcoeftab,
+                         work, lwork, &(datacode->lowrank) );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Factorize all the cblks of a leaf subtree in increasing order.
+ *
+ * The cblks of the subtree are never released by their dependencies, and
+ * they are all factorized by the thread that popped the root of the subtree.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] subtrees
+ *          The subtrees structure.
+ *
+ * @param[in] cblknum
+ *          The index of the root of the subtree.
+ *
+ * @param[inout] work1
+ *          The DLt workspace of the calling thread.
+ *
+ * @param[inout] work2
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork2
+ *          The size of work2.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************
+ *
+ * @return The number of factorized cblks.
+ *
+ *******************************************************************************/
+static inline int32_t
+dynamic_zhetrf_subtree( SolverMatrix            *datacode,
+                        const solver_subtrees_t *subtrees,
+                        pastix_int_t             cblknum,
+                        pastix_complex64_t      *work1,
+                        pastix_complex64_t      *work2,
+                        pastix_int_t             lwork2,
+                        int                      rank )
+{
+    SolverCblk  *cblk;
+    pastix_int_t s = solverSubtreesGet( subtrees, cblknum );
+    pastix_int_t i, N;
+
+    for ( i = subtrees->cblkptr[s]; i < subtrees->cblkptr[s+1]; i++ ) {
+        cblk = datacode->cblktab + subtrees->cblktab[i];
+        cblk->threadid = rank;
+
+        N = cblk_colnbr( cblk );
+        cpucblk_zhetrfsp1d( datacode, cblk,
+                            work1 - (N*N), work2, lwork2 );
+    }
+    return subtrees->cblkptr[s+1] - subtrees->cblkptr[s];
+}
+
 void
 thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
 {
     struct args_zhetrf_t *arg = (struct args_zhetrf_t *)args;
     sopalin_data_t       *sopalin_data = arg->sopalin_data;
+    solver_team_t        *team = &(arg->team);
+    solver_subtrees_t    *subtrees = &(arg->subtrees);
     SolverMatrix         *datacode = sopalin_data->solvmtx;
     SolverCblk           *cblk;
     Task                 *t;
-    pastix_queue_t       *computeQueue;
-    pastix_complex64_t   *work1, *work2;
+    pastix_queue_t       *computeQueue = NULL;
+    pastix_deque_t       *computeDeque = NULL;
+    pastix_complex64_t   *work1, *work2, *DLh;
     pastix_int_t          N, i, ii, lwork1, lwork2;
     pastix_int_t          tasknbr, *tasktab, cblknum;
     int32_t               local_taskcnt = 0;
@@ -170,20 +289,40 @@ thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
     }
     MALLOC_INTERN( work1, lwork1, pastix_complex64_t );
     MALLOC_INTERN( work2, lwork2, pastix_complex64_t );
-    MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
-
-    tasknbr      = datacode->ttsknbr[rank];
-    tasktab      = datacode->ttsktab[rank];
-    computeQueue = datacode->computeQueue[rank];
-    pqueueInit( computeQueue, tasknbr );
-
-    /* Initialize the local task queue with available cblks */
-    for (ii=0; ii<tasknbr; ii++) {
-        i = tasktab[ii];
-        t = datacode->tasktab + i;
+    tasknbr = datacode->ttsknbr[rank];
+    tasktab = datacode->ttsktab[rank];
 
-        if ( !(t->ctrbcnt) ) {
-            pqueuePush1( computeQueue, t->cblknum, t->prionum );
+    if ( datacode->computeDeque ) {
+        MALLOC_INTERN( datacode->computeDeque[rank], 1, pastix_deque_t );
+        computeDeque = datacode->computeDeque[rank];
+        pdequeInit( computeDeque, tasknbr );
+
+        /*
+         * Initialize the local deque with available cblks in reverse priority
+         * order, such that the most urgent ones are popped first
+         */
+        for (ii=tasknbr-1; ii>=0; ii--) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pdequePush( computeDeque, t->cblknum );
+            }
+        }
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
+        computeQueue = datacode->computeQueue[rank];
+        pqueueInit( computeQueue, tasknbr );
+
+        /* Initialize the local task queue with available cblks */
+        for (ii=0; ii<tasknbr; ii++) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pqueuePush1( computeQueue, t->cblknum, t->prionum );
+            }
         }
     }
 
@@ -192,13 +331,13 @@ thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
 
     while( arg->taskcnt > 0 )
     {
-        cblknum = pqueuePop(computeQueue);
+        cblknum = popQueue( datacode, rank );
 
 #if defined(PASTIX_WITH_MPI)
         /* Nothing to do, let's make progress on comunications */
         if( cblknum == -1 ) {
             cpucblk_zmpi_progress( PastixLCoef, datacode, rank );
-            cblknum = pqueuePop(computeQueue);
+            cblknum = popQueue( datacode, rank );
         }
 #endif
 
@@ -212,8 +351,9 @@ thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
                                   ctx->global_ctx->world_size );
         }
 
-        /* Still no job, let's loop again */
+        /* Still no job, let's help the team of a tail cblk, and loop again */
         if ( cblknum == -1 ) {
+            solverTeamHelp( datacode, team, work2, lwork2, rank );
             continue;
         }
 
@@ -223,8 +363,25 @@ thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
         }
         cblk->threadid = rank;
 
+        /* Factorize the whole leaf subtree of the root */
+        if ( solverSubtreesGet( subtrees, cblknum ) != -1 ) {
+            local_taskcnt += dynamic_zhetrf_subtree( datacode, subtrees, cblknum,
+                                                     work1, work2, lwork2, rank );
+            continue;
+        }
+
         N = cblk_colnbr( cblk );
 
+        /* Share the updates of the tail cblks with the idle threads */
+        if ( solverTeamIsTail( team, cblknum ) ) {
+            DLh = (cblk->cblktype & CBLK_LAYOUT_2D) ? work1 - (N*N) : NULL;
+            cpucblk_zhetrfsp1d_panel( datacode, cblk, cblk->lcoeftab, DLh );
+            solverTeamRun( datacode, team, cblk, dynamic_zhetrf_team_update, DLh,
+                           work2, lwork2, rank );
+            local_taskcnt++;
+            continue;
+        }
+
         /* Compute */
         cpucblk_zhetrfsp1d( datacode, cblk,
                             /*
@@ -241,8 +398,14 @@ thread_zhetrf_dynamic( isched_thread_t *ctx, void *args )
 
     /* Make sure that everyone is done before freeing */
     isched_barrier_wait( &(ctx->global_ctx->barrier) );
-    pqueueExit( computeQueue );
-    memFree_null( computeQueue );
+    if ( computeDeque ) {
+        pdequeExit( computeDeque );
+        memFree_null( computeDeque );
+    }
+    else {
+        pqueueExit( computeQueue );
+        memFree_null( computeQueue );
+    }
 }
 
 void
@@ -251,15 +414,67 @@ dynamic_zhetrf( pastix_data_t  *pastix_data,
 {
     SolverMatrix        *datacode = sopalin_data->solvmtx;
     int32_t              taskcnt = datacode->tasknbr;
-    struct args_zhetrf_t args_zhetrf = { sopalin_data, taskcnt };
+    pastix_int_t         i;
+    int                  thrdnbr;
+    struct args_zhetrf_t args_zhetrf;
+
+    /* The cblks of the Schur complement are skipped */
+    for (i=0; i<datacode->tasknbr; i++) {
+        if ( datacode->cblktab[ datacode->tasktab[i].cblknum ].cblktype & CBLK_IN_SCHUR ) {
+            taskcnt--;
+        }
+    }
+    args_zhetrf.sopalin_data = sopalin_data;
+    args_zhetrf.taskcnt      = taskcnt;
+
+    /*
+     * The updates of the cblks of the tail of the elimination tree are shared
+     * with the idle threads in shared memory.
+     */
+    thrdnbr = pastix_data->isched->world_size;
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_TEAM] == 0) ||
+         (pastix_data->procnbr > 1) )
+    {
+        thrdnbr = 1;
+    }
+    solverTeamInit( datacode, &(args_zhetrf.team), thrdnbr );
+
+    /*
+     * The leaf subtrees below the cost threshold, clustered by the analysis,
+     * are factorized as single tasks in shared memory. The structure shares
+     * the arrays of the analysis.
+     */
+    if ( (datacode->subtrees != NULL) && (pastix_data->procnbr == 1) ) {
+        args_zhetrf.subtrees = *(datacode->subtrees);
+        solverSubtreesHold( datacode, datacode->subtrees );
+    }
+    else {
+        memset( &(args_zhetrf.subtrees), 0, sizeof(solver_subtrees_t) );
+    }
 
-    /* Allocate the computeQueue */
-    MALLOC_INTERN( datacode->computeQueue,
-                   pastix_data->isched->world_size, pastix_queue_t * );
+
+    /*
+     * Allocate the computeQueue, or the work-stealing deques if requested.
+     * With multiple processes, the reception of remote contributions may
+     * release a task on behalf of another thread, so the locked heaps are
+     * always used.
+     */
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_QUEUE] == PastixDynQueueDeque) &&
+         (pastix_data->procnbr == 1) )
+    {
+        MALLOC_INTERN( datacode->computeDeque,
+                       pastix_data->isched->world_size, pastix_deque_t * );
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue,
+                       pastix_data->isched->world_size, pastix_queue_t * );
+    }
 
     isched_parallel_call( pastix_data->isched, thread_zhetrf_dynamic, &args_zhetrf );
 
     memFree_null( datacode->computeQueue );
+    memFree_null( datacode->computeDeque );
+    solverTeamExit( &(args_zhetrf.team) );
 
 #if defined(PASTIX_WITH_MPI)
     MPI_Barrier( pastix_data->inter_node_comm );
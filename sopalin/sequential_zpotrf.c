@@ -123,17 +123,237 @@ struct args_zpotrf_t
 {
     sopalin_data_t     *sopalin_data;
     volatile int32_t    taskcnt;
+    solver_tasks2d_t    tasks2d;
+    solver_team_t       team;
+    solver_subtrees_t   subtrees;
 };
 
+/**
+ * @brief Return the pointer to the coefficients of a block in the given
+ * coeftab, or NULL if the cblk is compressed.
+ */
+static inline pastix_complex64_t *
+zpotrf_blok_coeftab( const SolverCblk *cblk,
+                     const SolverBlok *blok,
+                     void             *coeftab )
+{
+    if ( cblk->cblktype & CBLK_COMPRESSED ) {
+        return NULL;
+    }
+    return ((pastix_complex64_t *)coeftab) + blok->coefind;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Factorize the diagonal block of a 2D cblk, and release its TRSM tasks.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[inout] cblk
+ *          The 2D cblk to factorize.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+static inline void
+dynamic_zpotrf_panel2d( SolverMatrix           *datacode,
+                        const solver_tasks2d_t *tasks2d,
+                        SolverCblk             *cblk,
+                        int                     rank )
+{
+    /* Compression between 1D and 2D updates */
+    if ( (cblk->cblktype & CBLK_COMPRESSED) &&
+         (datacode->lowrank.compress_when == PastixCompressWhenDuring) )
+    {
+        cpucblk_zcompress( datacode, PastixLCoef, cblk );
+    }
+
+    cpucblk_zpotrfsp1d_potrf( datacode, cblk, cblk->lcoeftab );
+    solverTasks2dReleasePanel( datacode, tasks2d, cblk, rank );
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Execute a block-level task of a 2D cblk, and release its dependencies.
+ *
+ * The GEMM tasks lock the blocks of the facing cblk that they update, in
+ * ascending order, with solverTasks2dLockGemm() before calling the block
+ * kernels, and release them with solverTasks2dUnlockGemm().
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] tasks2d
+ *          The block-level tasks structure.
+ *
+ * @param[in] task
+ *          The task to execute.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************/
+static inline void
+dynamic_zpotrf_task2d( SolverMatrix           *datacode,
+                       const solver_tasks2d_t *tasks2d,
+                       const solver_task2d_t  *task,
+                       int                     rank )
+{
+    SolverCblk         *cblk = datacode->cblktab + task->cblknum;
+    pastix_complex64_t *L    = cblk->lcoeftab;
+    const SolverBlok   *blokA, *blokB, *blokC;
+    SolverCblk         *fcblk;
+
+    blokA = cblk->fblokptr + task->blok_mk;
+
+    if ( task->type == TASK2D_TRSM ) {
+        cpublok_ztrsmsp( PastixLCoef, PastixRight, PastixLower,
+                         PastixConjTrans, PastixNonUnit,
+                         cblk, task->blok_mk, L, zpotrf_blok_coeftab( cblk, blokA, L ),
+                         &(datacode->lowrank) );
+        solverTasks2dReleaseTrsm( datacode, tasks2d, task, rank );
+    }
+    else {
+        blokB = cblk->fblokptr + task->blok_nk;
+        fcblk = datacode->cblktab + blokB->fcblknm;
+        blokC = fcblk->fblokptr + task->blok_mn;
+
+        solverTasks2dLockGemm( datacode, task );
+        cpublok_zgemmsp( PastixLCoef, PastixLCoef, PastixConjTrans,
+                         cblk, fcblk,
+                         task->blok_mk, task->blok_nk, task->blok_mn,
+                         zpotrf_blok_coeftab( cblk,  blokA, L ),
+                         zpotrf_blok_coeftab( cblk,  blokB, L ),
+                         zpotrf_blok_coeftab( fcblk, blokC, fcblk->lcoeftab ),
+                         &(datacode->lowrank) );
+        solverTasks2dUnlockGemm( datacode, task );
+        solverTasks2dReleaseGemm( datacode, tasks2d, task, rank );
+    }
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Apply the update generated by one off-diagonal block of a cblk of the
+ * tail of the elimination tree, shared with the idle threads.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] args
+ *          Unused.
+ *
+ * @param[in] cblk
+ *          The factorized cblk.
+ *
+ * @param[in] blok
+ *          The off-diagonal block generating the update.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ *******************************************************************************/
+static void
+dynamic_zpotrf_team_update( SolverMatrix *datacode,
+                            void         *args,
+                            SolverCblk   *cblk,
+                            SolverBlok   *blok,
+                            void         *work,
+                            pastix_int_t  lwork )
+{
+    pastix_complex64_t *L = cblk->lcoeftab;
+    SolverCblk         *fcblk = datacode->cblktab + blok->fcblknm;
+
+    cpucblk_zgemmsp( PastixLCoef, PastixLCoef, PastixConjTrans,
+                     cblk, blok, fcblk,
+                     L, L, fcblk->lcoeftab,
+                     work, lwork, &(datacode->lowrank) );
+    (void)args;
+}
+
+/**
+ *******************************************************************************
+ *
+ * @brief Factorize all the cblks of a leaf subtree in increasing order.
+ *
+ * The cblks of the subtree are never released by their dependencies, and
+ * they are all factorized by the thread that popped the root of the subtree.
+ *
+ *******************************************************************************
+ *
+ * @param[inout] datacode
+ *          The solver matrix structure.
+ *
+ * @param[in] subtrees
+ *          The subtrees structure.
+ *
+ * @param[in] cblknum
+ *          The index of the root of the subtree.
+ *
+ * @param[inout] work
+ *          The workspace of the calling thread.
+ *
+ * @param[in] lwork
+ *          The size of the workspace.
+ *
+ * @param[in] rank
+ *          The rank of the calling thread.
+ *
+ *******************************************************************************
+ *
+ * @return The number of factorized cblks.
+ *
+ *******************************************************************************/
+static inline int32_t
+dynamic_zpotrf_subtree( SolverMatrix            *datacode,
+                        const solver_subtrees_t *subtrees,
+                        pastix_int_t             cblknum,
+                        pastix_complex64_t      *work,
+                        pastix_int_t             lwork,
+                        int                      rank )
+{
+    SolverCblk  *cblk;
+    pastix_int_t s = solverSubtreesGet( subtrees, cblknum );
+    pastix_int_t i;
+
+    for ( i = subtrees->cblkptr[s]; i < subtrees->cblkptr[s+1]; i++ ) {
+        cblk = datacode->cblktab + subtrees->cblktab[i];
+        cblk->threadid = rank;
+        cpucblk_zpotrfsp1d( datacode, cblk,
+                            work, lwork );
+    }
+    return subtrees->cblkptr[s+1] - subtrees->cblkptr[s];
+}
+
 void
 thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
 {
     struct args_zpotrf_t *arg = (struct args_zpotrf_t*)args;
     sopalin_data_t       *sopalin_data = arg->sopalin_data;
+    solver_tasks2d_t     *tasks2d = &(arg->tasks2d);
+    solver_team_t        *team = &(arg->team);
+    solver_subtrees_t    *subtrees = &(arg->subtrees);
     SolverMatrix         *datacode = sopalin_data->solvmtx;
     SolverCblk           *cblk;
     Task                 *t;
-    pastix_queue_t       *computeQueue;
+    pastix_queue_t       *computeQueue = NULL;
+    pastix_deque_t       *computeDeque = NULL;
     pastix_complex64_t   *work;
     pastix_int_t          i, ii, lwork;
     pastix_int_t          tasknbr, *tasktab, cblknum;
@@ -146,20 +366,40 @@ thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
         lwork = pastix_imax( lwork, 2 * datacode->blokmax );
     }
     MALLOC_INTERN( work, lwork, pastix_complex64_t );
-    MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
-
-    tasknbr      = datacode->ttsknbr[rank];
-    tasktab      = datacode->ttsktab[rank];
-    computeQueue = datacode->computeQueue[rank];
-    pqueueInit( computeQueue, tasknbr );
-
-    /* Initialize the local task queue with available cblks */
-    for (ii=0; ii<tasknbr; ii++) {
-        i = tasktab[ii];
-        t = datacode->tasktab + i;
+    tasknbr = datacode->ttsknbr[rank];
+    tasktab = datacode->ttsktab[rank];
 
-        if ( !(t->ctrbcnt) ) {
-            pqueuePush1( computeQueue, t->cblknum, t->prionum );
+    if ( datacode->computeDeque ) {
+        MALLOC_INTERN( datacode->computeDeque[rank], 1, pastix_deque_t );
+        computeDeque = datacode->computeDeque[rank];
+        pdequeInit( computeDeque, tasknbr );
+
+        /*
+         * Initialize the local deque with available cblks in reverse priority
+         * order, such that the most urgent ones are popped first
+         */
+        for (ii=tasknbr-1; ii>=0; ii--) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pdequePush( computeDeque, t->cblknum );
+            }
+        }
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
+        computeQueue = datacode->computeQueue[rank];
+        pqueueInit( computeQueue, tasknbr );
+
+        /* Initialize the local task queue with available cblks */
+        for (ii=0; ii<tasknbr; ii++) {
+            i = tasktab[ii];
+            t = datacode->tasktab + i;
+
+            if ( solverSubtreesIsReady( subtrees, t->cblknum, t->ctrbcnt ) ) {
+                pqueuePush1( computeQueue, t->cblknum, t->prionum );
+            }
         }
     }
 
@@ -168,13 +408,13 @@ thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
 
     while( arg->taskcnt > 0 )
     {
-        cblknum = pqueuePop(computeQueue);
+        cblknum = popQueue( datacode, rank );
 
 #if defined(PASTIX_WITH_MPI)
         /* Nothing to do, let's make progress on comunications */
         if( cblknum == -1 ) {
             cpucblk_zmpi_progress( PastixLCoef, datacode, rank );
-            cblknum = pqueuePop(computeQueue);
+            cblknum = popQueue( datacode, rank );
         }
 #endif
 
@@ -188,8 +428,18 @@ thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
                                   ctx->global_ctx->world_size );
         }
 
-        /* Still no job, let's loop again */
+        /* Still no job, let's help the team of a tail cblk, and loop again */
         if ( cblknum == -1 ) {
+            solverTeamHelp( datacode, team, work, lwork, rank );
+            continue;
+        }
+
+        /* Block-level task of a 2D cblk */
+        if ( cblknum >= datacode->cblknbr ) {
+            dynamic_zpotrf_task2d( datacode, tasks2d,
+                                   tasks2d->tasktab + (cblknum - datacode->cblknbr),
+                                   rank );
+            local_taskcnt++;
             continue;
         }
 
@@ -199,6 +449,28 @@ thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
         }
         cblk->threadid = rank;
 
+        /* Factorize the whole leaf subtree of the root */
+        if ( solverSubtreesGet( subtrees, cblknum ) != -1 ) {
+            local_taskcnt += dynamic_zpotrf_subtree( datacode, subtrees, cblknum,
+                                                     work, lwork, rank );
+            continue;
+        }
+
+        if ( tasks2d->tasktab && (cblk->cblktype & CBLK_TASKS_2D) ) {
+            dynamic_zpotrf_panel2d( datacode, tasks2d, cblk, rank );
+            local_taskcnt++;
+            continue;
+        }
+
+        /* Share the updates of the tail cblks with the idle threads */
+        if ( solverTeamIsTail( team, cblknum ) ) {
+            cpucblk_zpotrfsp1d_panel( datacode, cblk, cblk->lcoeftab );
+            solverTeamRun( datacode, team, cblk, dynamic_zpotrf_team_update, NULL,
+                           work, lwork, rank );
+            local_taskcnt++;
+            continue;
+        }
+
         /* Compute */
         cpucblk_zpotrfsp1d( datacode, cblk,
                             work, lwork );
@@ -208,8 +480,14 @@ thread_zpotrf_dynamic( isched_thread_t *ctx, void *args )
 
     /* Make sure that everyone is done before freeing */
     isched_barrier_wait( &(ctx->global_ctx->barrier) );
-    pqueueExit( computeQueue );
-    memFree_null( computeQueue );
+    if ( computeDeque ) {
+        pdequeExit( computeDeque );
+        memFree_null( computeDeque );
+    }
+    else {
+        pqueueExit( computeQueue );
+        memFree_null( computeQueue );
+    }
 }
 
 void
@@ -218,15 +496,82 @@ dynamic_zpotrf( pastix_data_t  *pastix_data,
 {
     SolverMatrix        *datacode = sopalin_data->solvmtx;
     int32_t              taskcnt = datacode->tasknbr;
-    struct args_zpotrf_t args_zpotrf = { sopalin_data, taskcnt };
+    pastix_int_t         i;
+    int                  thrdnbr;
+    struct args_zpotrf_t args_zpotrf;
+
+    /* The cblks of the Schur complement are skipped */
+    for (i=0; i<datacode->tasknbr; i++) {
+        if ( datacode->cblktab[ datacode->tasktab[i].cblknum ].cblktype & CBLK_IN_SCHUR ) {
+            taskcnt--;
+        }
+    }
 
-    /* Allocate the computeQueue */
-    MALLOC_INTERN( datacode->computeQueue,
-                   pastix_data->isched->world_size, pastix_queue_t * );
+    /*
+     * The 2D cblks are factorized with block-level tasks in shared memory. With
+     * multiple processes, they are kept as 1D tasks to handle the fanin cblks,
+     * as well as with a fused forward solve that is applied by the 1D panels.
+     */
+    args_zpotrf.sopalin_data = sopalin_data;
+    if ( (pastix_data->iparm[IPARM_TASKS2D_LEVEL] != 0) &&
+         (pastix_data->procnbr == 1) &&
+         (datacode->fwdsolve == NULL) )
+    {
+        taskcnt += solverTasks2dInit( datacode, &(args_zpotrf.tasks2d) );
+    }
+    else {
+        memset( &(args_zpotrf.tasks2d), 0, sizeof(solver_tasks2d_t) );
+    }
+    args_zpotrf.taskcnt = taskcnt;
+
+    /*
+     * The updates of the cblks of the tail of the elimination tree are shared
+     * with the idle threads in shared memory.
+     */
+    thrdnbr = pastix_data->isched->world_size;
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_TEAM] == 0) ||
+         (pastix_data->procnbr > 1) )
+    {
+        thrdnbr = 1;
+    }
+    solverTeamInit( datacode, &(args_zpotrf.team), thrdnbr );
+
+    /*
+     * The leaf subtrees below the cost threshold, clustered by the analysis,
+     * are factorized as single tasks in shared memory. The structure shares
+     * the arrays of the analysis.
+     */
+    if ( (datacode->subtrees != NULL) && (pastix_data->procnbr == 1) ) {
+        args_zpotrf.subtrees = *(datacode->subtrees);
+        solverSubtreesHold( datacode, datacode->subtrees );
+    }
+    else {
+        memset( &(args_zpotrf.subtrees), 0, sizeof(solver_subtrees_t) );
+    }
+
+    /*
+     * Allocate the computeQueue, or the work-stealing deques if requested.
+     * With multiple processes, the reception of remote contributions may
+     * release a task on behalf of another thread, so the locked heaps are
+     * always used.
+     */
+    if ( (pastix_data->iparm[IPARM_DYNAMIC_QUEUE] == PastixDynQueueDeque) &&
+         (pastix_data->procnbr == 1) )
+    {
+        MALLOC_INTERN( datacode->computeDeque,
+                       pastix_data->isched->world_size, pastix_deque_t * );
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue,
+                       pastix_data->isched->world_size, pastix_queue_t * );
+    }
 
     isched_parallel_call( pastix_data->isched, thread_zpotrf_dynamic, &args_zpotrf );
 
     memFree_null( datacode->computeQueue );
+    memFree_null( datacode->computeDeque );
+    solverTasks2dExit( &(args_zpotrf.tasks2d) );
+    solverTeamExit( &(args_zpotrf.team) );
 
 #if defined(PASTIX_WITH_MPI)
     MPI_Barrier( pastix_data->inter_node_comm );
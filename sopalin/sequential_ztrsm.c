@@ -110,6 +110,7 @@ struct args_ztrsm_t
     int nrhs;
     pastix_complex64_t *b;
     int ldb;
+    volatile int32_t taskcnt;
 };
 
 void
@@ -163,7 +164,7 @@ thread_ztrsm_static( isched_thread_t *ctx, void *args )
             cblk = datacode->cblktab + t->cblknum;
 
             /* Wait */
-            do { } while( cblk->ctrbcnt );
+            cblk_wait_deps( datacode, cblk, rank );
 
             solve_cblk_ztrsmsp_backward( mode, side, uplo, trans, diag,
                                          datacode, cblk, nrhs, b, ldb );
@@ -196,7 +197,7 @@ thread_ztrsm_static( isched_thread_t *ctx, void *args )
                 continue;
 
             /* Wait */
-            do { } while( cblk->ctrbcnt );
+            cblk_wait_deps( datacode, cblk, rank );
 
             solve_cblk_ztrsmsp_forward( mode, side, uplo, trans, diag,
                                         datacode, cblk, nrhs, b, ldb );
@@ -209,10 +210,194 @@ static_ztrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int dia
               sopalin_data_t *sopalin_data,
               int nrhs, pastix_complex64_t *b, int ldb )
 {
-    struct args_ztrsm_t args_ztrsm = {pastix_data, side, uplo, trans, diag, sopalin_data, nrhs, b, ldb};
+    struct args_ztrsm_t args_ztrsm = {pastix_data, side, uplo, trans, diag, sopalin_data, nrhs, b, ldb, 0};
     isched_parallel_call( pastix_data->isched, thread_ztrsm_static, &args_ztrsm );
 }
 
+void
+thread_ztrsm_dynamic( isched_thread_t *ctx, void *args )
+{
+    struct args_ztrsm_t *arg = (struct args_ztrsm_t*)args;
+    pastix_data_t      *pastix_data  = arg->pastix_data;
+    sopalin_data_t     *sopalin_data = arg->sopalin_data;
+    SolverMatrix       *datacode = sopalin_data->solvmtx;
+    pastix_complex64_t *b = arg->b;
+    int side  = arg->side;
+    int uplo  = arg->uplo;
+    int trans = arg->trans;
+    int diag  = arg->diag;
+    int nrhs  = arg->nrhs;
+    int ldb   = arg->ldb;
+    SolverCblk     *cblk;
+    Task           *t;
+    pastix_queue_t *computeQueue = NULL;
+    pastix_deque_t *computeDeque = NULL;
+    pastix_int_t    i, ii, r, cblknum;
+    pastix_int_t    tasknbr, *tasktab;
+    pastix_solv_mode_t mode = pastix_data->iparm[IPARM_SCHUR_SOLV_MODE];
+    int32_t local_taskcnt = 0;
+    int     rank = ctx->rank;
+    int     size = ctx->global_ctx->world_size;
+    int     dest = (ctx->rank + 1)%size;
+    int     backward;
+
+    /*
+     * The task lists of the analysis are distributed in a round-robin fashion
+     * when the solve runs with a different number of threads (see
+     * pastixSolveContextInit())
+     */
+    tasknbr = 0;
+    for (r=rank; r<datacode->bublnbr; r+=size) {
+        tasknbr += datacode->ttsknbr[r];
+    }
+
+    backward = ( ( (side == PastixLeft)  && (uplo == PastixUpper) && (trans == PastixNoTrans) ) ||
+                 ( (side == PastixLeft)  && (uplo == PastixLower) && (trans != PastixNoTrans) ) ||
+                 ( (side == PastixRight) && (uplo == PastixUpper) && (trans != PastixNoTrans) ) ||
+                 ( (side == PastixRight) && (uplo == PastixLower) && (trans == PastixNoTrans) ) );
+
+    if ( datacode->computeDeque ) {
+        MALLOC_INTERN( datacode->computeDeque[rank], 1, pastix_deque_t );
+        computeDeque = datacode->computeDeque[rank];
+        pdequeInit( computeDeque, tasknbr );
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue[rank], 1, pastix_queue_t );
+        computeQueue = datacode->computeQueue[rank];
+        pqueueInit( computeQueue, tasknbr );
+    }
+
+    /*
+     * Init ctrbcnt in parallel, and push the cblks without contributions in
+     * the local queue. The deque is filled by decreasing priority order, such
+     * that the most urgent cblks are popped first.
+     */
+    for (r=rank; r<datacode->bublnbr; r+=size) {
+        tasknbr = datacode->ttsknbr[r];
+        tasktab = datacode->ttsktab[r];
+
+        for (ii=0; ii<tasknbr; ii++) {
+            i = backward ? tasktab[ii] : tasktab[tasknbr-1-ii];
+            t = datacode->tasktab + i;
+            cblk = datacode->cblktab + t->cblknum;
+
+            if ( backward ) {
+                if ( (cblk->cblktype & CBLK_IN_SCHUR) && (mode != PastixSolvModeSchur) ) {
+                    cblk->ctrbcnt = 0;
+                }
+                else {
+                    cblk->ctrbcnt = cblk[1].fblokptr - cblk[0].fblokptr - 1;
+                }
+            }
+            else {
+                cblk->ctrbcnt = cblk[1].brownum - cblk[0].brownum;
+
+                if ( (cblk->cblktype & CBLK_IN_SCHUR) && (mode != PastixSolvModeSchur) ) {
+                    continue;
+                }
+            }
+
+            if ( !(cblk->ctrbcnt) ) {
+                if ( computeDeque ) {
+                    pdequePush( computeDeque, t->cblknum );
+                }
+                else {
+                    pqueuePush1( computeQueue, t->cblknum,
+                                 backward ? -(double)(t->cblknum) : (double)(t->cblknum) );
+                }
+            }
+        }
+    }
+
+    /* Make sure that all ctrbcnt are initialized, and all queues allocated */
+    isched_barrier_wait( &(ctx->global_ctx->barrier) );
+
+    while( arg->taskcnt > 0 )
+    {
+        cblknum = popQueue( datacode, rank );
+
+        /* No more local job, let's steal our neighbours */
+        if( cblknum == -1 ) {
+            if ( local_taskcnt ) {
+                pastix_atomic_sub_32b( &(arg->taskcnt), local_taskcnt );
+                local_taskcnt = 0;
+            }
+            cblknum = stealQueue( datacode, rank, &dest, size );
+        }
+
+        /* Still no job, let's loop again */
+        if ( cblknum == -1 ) {
+            continue;
+        }
+
+        cblk = datacode->cblktab + cblknum;
+        cblk->threadid = rank;
+
+        if ( backward ) {
+            solve_cblk_ztrsmsp_backward( mode, side, uplo, trans, diag,
+                                         datacode, cblk, nrhs, b, ldb );
+        }
+        else {
+            solve_cblk_ztrsmsp_forward( mode, side, uplo, trans, diag,
+                                        datacode, cblk, nrhs, b, ldb );
+        }
+        local_taskcnt++;
+    }
+
+    /* Make sure that everyone is done before freeing */
+    isched_barrier_wait( &(ctx->global_ctx->barrier) );
+    if ( computeDeque ) {
+        pdequeExit( computeDeque );
+        memFree_null( computeDeque );
+    }
+    else {
+        pqueueExit( computeQueue );
+        memFree_null( computeQueue );
+    }
+}
+
+void
+dynamic_ztrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int diag,
+               sopalin_data_t *sopalin_data,
+               int nrhs, pastix_complex64_t *b, int ldb )
+{
+    SolverMatrix      *datacode = sopalin_data->solvmtx;
+    pastix_solv_mode_t mode     = pastix_data->iparm[IPARM_SCHUR_SOLV_MODE];
+    int32_t            taskcnt  = datacode->tasknbr;
+    pastix_int_t       i;
+    struct args_ztrsm_t args_ztrsm = {pastix_data, side, uplo, trans, diag, sopalin_data, nrhs, b, ldb, 0};
+
+    /* Forward like: the cblks of the Schur complement are not solved */
+    if ( !( ( (side == PastixLeft)  && (uplo == PastixUpper) && (trans == PastixNoTrans) ) ||
+            ( (side == PastixLeft)  && (uplo == PastixLower) && (trans != PastixNoTrans) ) ||
+            ( (side == PastixRight) && (uplo == PastixUpper) && (trans != PastixNoTrans) ) ||
+            ( (side == PastixRight) && (uplo == PastixLower) && (trans == PastixNoTrans) ) ) &&
+         (mode != PastixSolvModeSchur) )
+    {
+        for (i=0; i<datacode->tasknbr; i++) {
+            if ( datacode->cblktab[ datacode->tasktab[i].cblknum ].cblktype & CBLK_IN_SCHUR ) {
+                taskcnt--;
+            }
+        }
+    }
+    args_ztrsm.taskcnt = taskcnt;
+
+    /* Allocate the computeQueue, or the work-stealing deques if requested */
+    if ( pastix_data->iparm[IPARM_DYNAMIC_QUEUE] == PastixDynQueueDeque ) {
+        MALLOC_INTERN( datacode->computeDeque,
+                       pastix_data->isched->world_size, pastix_deque_t * );
+    }
+    else {
+        MALLOC_INTERN( datacode->computeQueue,
+                       pastix_data->isched->world_size, pastix_queue_t * );
+    }
+
+    isched_parallel_call( pastix_data->isched, thread_ztrsm_dynamic, &args_ztrsm );
+
+    memFree_null( datacode->computeQueue );
+    memFree_null( datacode->computeDeque );
+}
+
 #if defined(PASTIX_WITH_MPI)
 void
 runtime_ztrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int diag,
@@ -286,7 +471,7 @@ static void (*ztrsm_table[5])(pastix_data_t *, int, int, int, int, sopalin_data_
 #else
     NULL,
 #endif
-    static_ztrsm
+    dynamic_ztrsm
 };
 
 void
@@ -25,6 +25,22 @@ struct sopalin_data_s {
 };
 typedef struct sopalin_data_s sopalin_data_t;
 
+/**
+ * @brief Private view of a factorized problem used by the concurrent solves.
+ *
+ * The view is a copy of the pastix_data structure pointing to its own
+ * parameters, thread pool and solver matrix. The solver matrix shares the
+ * blocks and the coefficients of the factorization, but owns a copy of the
+ * column blocks, such that the contribution counters, the ready queues and the
+ * idle counters of the solve are private to the context.
+ */
+struct pastix_solve_context_s {
+    pastix_data_t pastix_data;       /**< Private view of the problem            */
+    SolverMatrix  solvmtx;           /**< Solver matrix with private column blocks */
+    pastix_int_t  iparm[IPARM_SIZE]; /**< Private copy of the integer parameters */
+    double        dparm[DPARM_SIZE]; /**< Private copy of the floating parameters */
+};
+
 void sopalin_ztrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int diag, sopalin_data_t *sopalin_data, int nrhs, pastix_complex64_t *b, int ldb );
 void sopalin_ctrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int diag, sopalin_data_t *sopalin_data, int nrhs, pastix_complex32_t *b, int ldb );
 void sopalin_dtrsm( pastix_data_t *pastix_data, int side, int uplo, int trans, int diag, sopalin_data_t *sopalin_data, int nrhs, double *b, int ldb );
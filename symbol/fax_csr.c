@@ -220,6 +220,127 @@ faxCSRGenPA( const pastix_graph_t *graphA, const pastix_int_t *perm, fax_csr_t *
     return PASTIX_SUCCESS;
 }
 
+/**
+ * @brief Compress the rows of the columns of one cblk in the block wise graph.
+ *
+ * The two workspaces must be large enough to store the merged sets, the
+ * result is copied in graphL->rows[k].
+ */
+static inline void
+fax_csr_cblk_compress_one( const fax_csr_t    *graphA,
+                           const pastix_int_t *rangtab,
+                           pastix_int_t        k,
+                           fax_csr_t          *graphL,
+                           pastix_int_t       *tmp1,
+                           pastix_int_t       *tmp2 )
+{
+    pastix_int_t  i, j, nnznbr;
+    pastix_int_t *tmp;
+
+    /*
+     * Let's accumulate the row presents in the column blok k in tmp1
+     * Then use tmp2 to merge the elements of the next column, and tmp to switch
+     * pointers.
+     */
+    /* Put the diagonal elements (In case A does not contains them) */
+    j = 0;
+    for ( i = rangtab[k]; i < rangtab[k + 1]; i++ ) {
+        tmp1[j++] = i;
+    }
+    nnznbr = j;
+
+    for ( i = rangtab[k]; i < rangtab[k + 1]; i++ ) {
+        j = 0;
+
+        /* We take only the elements greater than i */
+        while ( ( j < graphA->nnz[i] ) && ( graphA->rows[i][j] <= i ) ) {
+            j++;
+        }
+
+        /* Merge the actual list with the edges of the ith vertex */
+        nnznbr =
+            pastix_intset_union( nnznbr, tmp1, graphA->nnz[i] - j, graphA->rows[i] + j, tmp2 );
+
+        /* Swap tmp1 and the merged set tmp */
+        tmp  = tmp1;
+        tmp1 = tmp2;
+        tmp2 = tmp;
+    }
+
+#if !defined( NDEBUG ) && defined( PASTIX_DEBUG_SYMBOL )
+    /* Check that the first elements are the diagonal ones */
+    {
+        pastix_int_t ind;
+        ind = 0;
+        assert( nnznbr >= ( rangtab[k + 1] - rangtab[k] ) );
+        for ( j = rangtab[k]; j < rangtab[k + 1]; j++ ) {
+            assert( tmp1[ind] == j );
+            ind++;
+        }
+        assert( nnznbr > 0 );
+    }
+#endif
+
+    /* Update graphL */
+    graphL->nnz[k] = nnznbr;
+    MALLOC_INTERN( graphL->rows[k], nnznbr, pastix_int_t );
+    memcpy( graphL->rows[k], tmp1, sizeof( pastix_int_t ) * nnznbr );
+}
+
+/**
+ * @brief Arguments of the multi-threaded compression of the graph.
+ */
+struct args_fax_compress_s {
+    const fax_csr_t      *graphA;
+    const pastix_order_t *order;
+    fax_csr_t            *graphL;
+};
+
+/**
+ * @brief Compress the cblks of the graph in a cyclic distribution over the
+ * threads.
+ *
+ * The workspaces of each thread are sized by the number of entries of the
+ * columns of the cblks, instead of the size of the graph, to keep the memory
+ * overhead of the parallel version low.
+ */
+static void
+thread_fax_csr_cblk_compress( isched_thread_t *ctx, void *args )
+{
+    struct args_fax_compress_s *arg     = (struct args_fax_compress_s *)args;
+    const fax_csr_t            *graphA  = arg->graphA;
+    const pastix_int_t         *rangtab = arg->order->rangtab;
+    pastix_int_t                cblknbr = arg->order->cblknbr;
+    pastix_int_t                rank    = (pastix_int_t)ctx->rank;
+    pastix_int_t                size    = (pastix_int_t)ctx->global_ctx->world_size;
+    pastix_int_t               *tmp1    = NULL;
+    pastix_int_t               *tmp2    = NULL;
+    pastix_int_t                lwork   = 0;
+    pastix_int_t                i, k, nnznbr;
+
+    for ( k = rank; k < cblknbr; k += size ) {
+        /* Upper bound of the number of rows of the cblk */
+        nnznbr = rangtab[k + 1] - rangtab[k];
+        for ( i = rangtab[k]; i < rangtab[k + 1]; i++ ) {
+            nnznbr += graphA->nnz[i];
+        }
+        nnznbr = pastix_imin( nnznbr, graphA->n );
+
+        if ( nnznbr > lwork ) {
+            memFree( tmp1 );
+            memFree( tmp2 );
+            lwork = nnznbr;
+            MALLOC_INTERN( tmp1, lwork, pastix_int_t );
+            MALLOC_INTERN( tmp2, lwork, pastix_int_t );
+        }
+
+        fax_csr_cblk_compress_one( graphA, rangtab, k, arg->graphL, tmp1, tmp2 );
+    }
+
+    memFree( tmp1 );
+    memFree( tmp2 );
+}
+
 /**
  *******************************************************************************
  *
@@ -228,6 +349,9 @@ faxCSRGenPA( const pastix_graph_t *graphA, const pastix_int_t *perm, fax_csr_t *
  * @brief Compact a element wise graph of a matrix A, according to the
  * associated partition.
  *
+ * The cblks are independent, and are compressed in parallel if a scheduler
+ * with more than one thread is given.
+ *
  *******************************************************************************
  *
  * @param[in] graphA
@@ -243,76 +367,35 @@ faxCSRGenPA( const pastix_graph_t *graphA, const pastix_int_t *perm, fax_csr_t *
  * @param[inout] work
  *          Workspace of size >= max( degree(L_i) ), so >= grapA->n.
  *
+ * @param[in] isched
+ *          The internal scheduler used to compress the graph in parallel. If
+ *          NULL, the graph is compressed sequentially.
+ *
  *******************************************************************************/
 void
 faxCSRCblkCompress( const fax_csr_t      *graphA,
                     const pastix_order_t *order,
                     fax_csr_t            *graphL,
-                    pastix_int_t         *work )
+                    pastix_int_t         *work,
+                    isched_t             *isched )
 {
-    pastix_int_t        i, j, k, nnznbr;
+    pastix_int_t        k;
     const pastix_int_t  cblknbr = order->cblknbr;
     const pastix_int_t *rangtab = order->rangtab;
     pastix_int_t       *work2;
-    pastix_int_t       *tmp, *tmp1, *tmp2;
-
-    MALLOC_INTERN( work2, graphA->n, pastix_int_t );
-    tmp1 = work;
-    tmp2 = work2;
 
     assert( order->baseval == 0 );
     faxCSRInit( cblknbr, graphL );
 
-    /*
-     * Let's accumulate the row presents in the column blok k in tmp1
-     * Then use tmp2 to merge the elements of the next column, and tmp to switch
-     * pointers.
-     */
-    for ( k = 0; k < cblknbr; k++ ) {
-        /* Put the diagonal elements (In case A does not contains them) */
-        j = 0;
-        for ( i = rangtab[k]; i < rangtab[k + 1]; i++ ) {
-            tmp1[j++] = i;
-        }
-        nnznbr = j;
-
-        for ( i = rangtab[k]; i < rangtab[k + 1]; i++ ) {
-            j = 0;
-
-            /* We take only the elements greater than i */
-            while ( ( j < graphA->nnz[i] ) && ( graphA->rows[i][j] <= i ) ) {
-                j++;
-            }
-
-            /* Merge the actual list with the edges of the ith vertex */
-            nnznbr =
-                pastix_intset_union( nnznbr, tmp1, graphA->nnz[i] - j, graphA->rows[i] + j, tmp2 );
-
-            /* Swap tmp1 and the merged set tmp */
-            tmp  = tmp1;
-            tmp1 = tmp2;
-            tmp2 = tmp;
-        }
-
-#if !defined( NDEBUG ) && defined( PASTIX_DEBUG_SYMBOL )
-        /* Check that the first elements are the diagonal ones */
-        {
-            pastix_int_t ind;
-            ind = 0;
-            assert( nnznbr >= ( rangtab[k + 1] - rangtab[k] ) );
-            for ( j = rangtab[k]; j < rangtab[k + 1]; j++ ) {
-                assert( tmp1[ind] == j );
-                ind++;
-            }
-            assert( nnznbr > 0 );
-        }
-#endif
-
-        /* Update graphL */
-        graphL->nnz[k] = nnznbr;
-        MALLOC_INTERN( graphL->rows[k], nnznbr, pastix_int_t );
-        memcpy( graphL->rows[k], tmp1, sizeof( pastix_int_t ) * nnznbr );
+    if ( ( isched != NULL ) && ( isched->world_size > 1 ) ) {
+        struct args_fax_compress_s args = { graphA, order, graphL };
+        isched_parallel_call( isched, thread_fax_csr_cblk_compress, &args );
+        return;
     }
 
+    MALLOC_INTERN( work2, graphA->n, pastix_int_t );
+    for ( k = 0; k < cblknbr; k++ ) {
+        fax_csr_cblk_compress_one( graphA, rangtab, k, graphL, work, work2 );
+    }
     memFree( work2 );
 }
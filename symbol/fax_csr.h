@@ -40,21 +40,25 @@ void faxCSRCompact( fax_csr_t *csr );
 void faxCSRCblkCompress( const fax_csr_t      *graphA,
                          const pastix_order_t *order,
                          fax_csr_t            *graphL,
-                         pastix_int_t         *work );
+                         pastix_int_t         *work,
+                         isched_t             *isched );
 
 pastix_int_t faxCSRFactDirect( const fax_csr_t      *graphA,
                                const pastix_order_t *order,
-                               fax_csr_t            *graphL );
+                               fax_csr_t            *graphL,
+                               isched_t             *isched );
 pastix_int_t faxCSRFactILUk( const fax_csr_t      *graphA,
                              const pastix_order_t *order,
                              pastix_int_t          level,
-                             fax_csr_t            *graphL );
+                             fax_csr_t            *graphL,
+                             isched_t             *isched );
 
 void faxCSRAmalgamate( int             ilu,
                        double          rat_cblk,
                        double          rat_blas,
                        fax_csr_t      *graphL,
                        pastix_order_t *order,
+                       isched_t       *isched,
                        PASTIX_Comm     pastix_comm );
 
 /**
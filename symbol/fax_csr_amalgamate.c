@@ -354,6 +354,82 @@ amalgamate_merge_col( pastix_int_t a, pastix_int_t b, fax_csr_t *P, pastix_int_t
     memcpy( P->rows[b], tmp, n * sizeof( pastix_int_t ) );
 }
 
+/**
+ * @brief Arguments of the multi-threaded computation of the merge costs.
+ */
+struct args_amalgamate_s {
+    const fax_csr_t    *graphL;
+    const pastix_int_t *treetab;
+    const pastix_int_t *colweight;
+    pastix_int_t       *nnzadd;
+    double             *gain;
+    double ( *cblktime )( pastix_int_t, const pastix_int_t *, pastix_int_t );
+};
+
+/**
+ * @brief Compute the fill to merge each node with its father in a cyclic
+ * distribution over the threads.
+ */
+static void
+thread_amalgamate_init_cost( isched_thread_t *ctx, void *args )
+{
+    struct args_amalgamate_s *arg  = (struct args_amalgamate_s *)args;
+    pastix_int_t              rank = (pastix_int_t)ctx->rank;
+    pastix_int_t              size = (pastix_int_t)ctx->global_ctx->world_size;
+    pastix_int_t              i, father;
+
+    for ( i = rank; i < arg->graphL->n; i += size ) {
+        father = arg->treetab[i];
+        if ( ( father == -1 ) || ( father == i ) ) {
+            arg->nnzadd[i] = INFINI;
+            arg->gain[i]   = INFINI;
+            continue;
+        }
+
+        arg->nnzadd[i] = amalgamate_merge_cost( i, father, arg->graphL, arg->colweight );
+        arg->gain[i]   = (double)( arg->nnzadd[i] );
+    }
+}
+
+/**
+ * @brief Compute the BLAS gain to merge each node with its father in a cyclic
+ * distribution over the threads.
+ *
+ * Each thread uses its own workspace, sized by the number of rows of the
+ * merged nodes.
+ */
+static void
+thread_amalgamate_blas_gain( isched_thread_t *ctx, void *args )
+{
+    struct args_amalgamate_s *arg   = (struct args_amalgamate_s *)args;
+    const fax_csr_t          *P     = arg->graphL;
+    pastix_int_t              rank  = (pastix_int_t)ctx->rank;
+    pastix_int_t              size  = (pastix_int_t)ctx->global_ctx->world_size;
+    pastix_int_t             *tmp   = NULL;
+    pastix_int_t              lwork = 0;
+    pastix_int_t              i, father, nnznbr;
+
+    for ( i = rank; i < P->n; i += size ) {
+        father = arg->treetab[i];
+        if ( father == -1 || father == i ) {
+            arg->gain[i] = INFINI;
+            continue;
+        }
+
+        nnznbr = P->nnz[i] + P->nnz[father];
+        if ( nnznbr > lwork ) {
+            memFree( tmp );
+            lwork = nnznbr;
+            MALLOC_INTERN( tmp, lwork, pastix_int_t );
+        }
+
+        arg->gain[i] = amalgamate_merge_gain( i, father, P, arg->colweight, tmp, arg->cblktime ) /
+                       arg->nnzadd[i];
+    }
+
+    memFree( tmp );
+}
+
 /**
  *******************************************************************************
  *
@@ -397,6 +473,11 @@ amalgamate_merge_col( pastix_int_t a, pastix_int_t b, fax_csr_t *P, pastix_int_t
  *          On entry the initial ordering structure associated to L.
  *          On exit, the update ordering structure with the amalgamation of close nodes.
  *
+ * @param[in] isched
+ *          The internal scheduler used to compute the initial merge costs in
+ *          parallel. If NULL, the computation is sequential. The merges are
+ *          always sequential to keep the greedy order of the algorithm.
+ *
  * @param[in] pastix_comm
  *          MPI communicator. Used only for printf in this function.
  *
@@ -407,6 +488,7 @@ faxCSRAmalgamate( int             ilu,
                   double          rat_blas,
                   fax_csr_t      *graphL,
                   pastix_order_t *order,
+                  isched_t       *isched,
                   PASTIX_Comm     pastix_comm )
 {
     double ( *cblktime )( pastix_int_t, const pastix_int_t *, pastix_int_t );
@@ -437,6 +519,7 @@ faxCSRAmalgamate( int             ilu,
     pastix_queue_t heap;
     int            blas_gain = 0;
     int            procnum;
+    int            parallel  = ( isched != NULL ) && ( isched->world_size > 1 );
 
     (void)pastix_comm;
 
@@ -573,16 +656,23 @@ faxCSRAmalgamate( int             ilu,
     /****************************************************************/
     MALLOC_INTERN( nnzadd, n, pastix_int_t );
     MALLOC_INTERN( gain, n, double );
-    for ( i = 0; i < n; i++ ) {
-        father = oldtreetab[i];
-        if ( ( father == -1 ) || ( father == i ) ) {
-            nnzadd[i] = INFINI;
-            gain[i]   = INFINI;
-            continue;
-        }
+    if ( parallel ) {
+        struct args_amalgamate_s args = { graphL, oldtreetab, colweight,
+                                          nnzadd, gain, cblktime };
+        isched_parallel_call( isched, thread_amalgamate_init_cost, &args );
+    }
+    else {
+        for ( i = 0; i < n; i++ ) {
+            father = oldtreetab[i];
+            if ( ( father == -1 ) || ( father == i ) ) {
+                nnzadd[i] = INFINI;
+                gain[i]   = INFINI;
+                continue;
+            }
 
-        nnzadd[i] = amalgamate_merge_cost( i, father, graphL, colweight );
-        gain[i]   = (double)( nnzadd[i] );
+            nnzadd[i] = amalgamate_merge_cost( i, father, graphL, colweight );
+            gain[i]   = (double)( nnzadd[i] );
+        }
     }
 
     /*****************************************************/
@@ -726,18 +816,33 @@ restart:
 
         /* Recompute the gain using BLAS model to restart the second round */
         pqueueInit( &heap, ( n - nbcblk_merged ) );
-        for ( i = 0; i < n; i++ ) {
-            father = oldtreetab[i];
-            if ( father == -1 || father == i ) {
-                gain[i] = INFINI;
-                continue;
+        if ( parallel ) {
+            struct args_amalgamate_s args = { graphL, oldtreetab, colweight,
+                                              nnzadd, gain, cblktime };
+            isched_parallel_call( isched, thread_amalgamate_blas_gain, &args );
+
+            /* Push the nodes in the same order as the sequential version */
+            for ( i = 0; i < n; i++ ) {
+                if ( ( colweight[i] > 0 ) && ( oldtreetab[i] > 0 ) && ( oldtreetab[i] != i ) &&
+                     ( gain[i] <= 0. ) ) {
+                    pqueuePush1( &heap, i, gain[i] );
+                }
             }
-            gain[i] =
-                amalgamate_merge_gain( i, father, graphL, colweight, tmp, cblktime ) / nnzadd[i];
+        }
+        else {
+            for ( i = 0; i < n; i++ ) {
+                father = oldtreetab[i];
+                if ( father == -1 || father == i ) {
+                    gain[i] = INFINI;
+                    continue;
+                }
+                gain[i] =
+                    amalgamate_merge_gain( i, father, graphL, colweight, tmp, cblktime ) / nnzadd[i];
 
-            if ( ( colweight[i] > 0 ) && ( oldtreetab[i] > 0 ) && ( oldtreetab[i] != i ) &&
-                 ( gain[i] <= 0. ) ) {
-                pqueuePush1( &heap, i, gain[i] );
+                if ( ( colweight[i] > 0 ) && ( oldtreetab[i] > 0 ) && ( oldtreetab[i] != i ) &&
+                     ( gain[i] <= 0. ) ) {
+                    pqueuePush1( &heap, i, gain[i] );
+                }
             }
         }
 
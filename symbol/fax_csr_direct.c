@@ -18,6 +18,207 @@
 #include "pastix/order.h"
 #include "fax_csr.h"
 
+/**
+ * @brief Merge the rows of the cblk k, outside of its diagonal block, in the
+ * rows of its father.
+ *
+ * The workspace tmp must be large enough to store the union of both sets.
+ */
+static inline void
+fax_csr_direct_merge( fax_csr_t          *graphL,
+                      const pastix_int_t *rangtab,
+                      pastix_int_t        k,
+                      pastix_int_t        father,
+                      pastix_int_t       *tmp )
+{
+    pastix_int_t  i = 0;
+    pastix_int_t  nnznbr;
+    pastix_int_t *ja = graphL->rows[k];
+
+    /* Take only the trows outside the cblk */
+    while ( ( i < graphL->nnz[k] ) && ( ja[i] < rangtab[k+1] ) ) {
+        i++;
+    }
+
+    nnznbr = pastix_intset_union( graphL->nnz[k] - i,
+                                  graphL->rows[k] + i,
+                                  graphL->nnz[father],
+                                  graphL->rows[father],
+                                  tmp );
+
+    memFree( graphL->rows[father] );
+    MALLOC_INTERN( graphL->rows[father], nnznbr, pastix_int_t );
+    memcpy( graphL->rows[father], tmp, sizeof( pastix_int_t ) * nnznbr );
+    graphL->nnz[father] = nnznbr;
+}
+
+/**
+ * @brief Arguments of the multi-threaded symbolic factorization of the
+ * subtrees.
+ */
+struct args_fax_direct_s {
+    fax_csr_t          *graphL;
+    const pastix_int_t *rangtab;
+    const pastix_int_t *treetab;
+    const pastix_int_t *subttab;
+    const pastix_int_t *cblkptr;
+    const pastix_int_t *cblktab;
+    pastix_int_t        subtnbr;
+    volatile int32_t    subtnext;
+};
+
+/**
+ * @brief Factorize the independent subtrees of the elimination tree.
+ *
+ * The subtrees are dynamically distributed over the threads, and the cblks of
+ * a subtree are processed in increasing order, such that the sons are merged
+ * in their father before the father is merged itself. The roots of the
+ * subtrees are merged in their father by the sequential part.
+ */
+static void
+thread_fax_csr_direct( isched_thread_t *ctx, void *args )
+{
+    struct args_fax_direct_s *arg    = (struct args_fax_direct_s *)args;
+    fax_csr_t                *graphL = arg->graphL;
+    pastix_int_t             *tmp    = NULL;
+    pastix_int_t              lwork  = 0;
+    pastix_int_t              i, k, s, father, nnznbr;
+    (void)ctx;
+
+    while ( arg->subtnext < arg->subtnbr ) {
+        s = pastix_atomic_inc_32b( &( arg->subtnext ) ) - 1;
+        if ( s >= arg->subtnbr ) {
+            break;
+        }
+
+        for ( i = arg->cblkptr[s]; i < arg->cblkptr[s + 1]; i++ ) {
+            k      = arg->cblktab[i];
+            father = arg->treetab[k];
+            if ( ( father == k ) || ( father <= 0 ) || ( arg->subttab[father] != s ) ) {
+                continue;
+            }
+
+            nnznbr = graphL->nnz[k] + graphL->nnz[father];
+            if ( nnznbr > lwork ) {
+                memFree( tmp );
+                lwork = nnznbr;
+                MALLOC_INTERN( tmp, lwork, pastix_int_t );
+            }
+            fax_csr_direct_merge( graphL, arg->rangtab, k, father, tmp );
+        }
+    }
+
+    memFree( tmp );
+}
+
+/**
+ * @brief Compute the symbolic factorization in parallel over the independent
+ * subtrees of the elimination tree.
+ *
+ * The subtrees are cut such that each of them holds less than 1/(4 thrdnbr) of
+ * the entries of the compressed graph. The cblks above the subtrees are
+ * processed sequentially once all the subtrees are factorized. The set union
+ * being commutative, the generated graph is identical to the sequential one.
+ */
+static inline void
+fax_csr_direct_parallel( fax_csr_t            *graphL,
+                         const pastix_order_t *order,
+                         pastix_int_t         *tmp,
+                         isched_t             *isched )
+{
+    struct args_fax_direct_s args;
+    pastix_int_t             cblknbr = order->cblknbr;
+    const pastix_int_t      *treetab = order->treetab;
+    pastix_int_t            *weight, *cblknbr_subt, *subttab, *cblkptr, *cblktab;
+    pastix_int_t             k, s, father, total, threshold;
+
+    MALLOC_INTERN( weight,       cblknbr, pastix_int_t );
+    MALLOC_INTERN( cblknbr_subt, cblknbr, pastix_int_t );
+    MALLOC_INTERN( subttab,      cblknbr, pastix_int_t );
+
+    /* Accumulate the weight of the subtrees, the father is after its sons */
+    total = 0;
+    for ( k = 0; k < cblknbr; k++ ) {
+        weight[k]       = graphL->nnz[k];
+        cblknbr_subt[k] = 1;
+    }
+    for ( k = 0; k < cblknbr; k++ ) {
+        father = treetab[k];
+        total += graphL->nnz[k];
+        if ( ( father != k ) && ( father > 0 ) ) {
+            assert( father > k );
+            weight[father]       += weight[k];
+            cblknbr_subt[father] += cblknbr_subt[k];
+        }
+    }
+    threshold = total / ( 4 * isched->world_size );
+
+    /* Flag the subtrees from the roots of the elimination tree */
+    args.subtnbr = 0;
+    for ( k = cblknbr - 1; k >= 0; k-- ) {
+        father = treetab[k];
+        if ( ( father != k ) && ( father > 0 ) && ( subttab[father] != -1 ) ) {
+            subttab[k] = subttab[father];
+        }
+        else if ( ( weight[k] <= threshold ) && ( cblknbr_subt[k] > 1 ) ) {
+            subttab[k] = args.subtnbr;
+            args.subtnbr++;
+        }
+        else {
+            subttab[k] = -1;
+        }
+    }
+    memFree( weight );
+
+    /* Build the list of the cblks of each subtree in increasing order */
+    MALLOC_INTERN( cblkptr, args.subtnbr + 1, pastix_int_t );
+    memset( cblkptr, 0, ( args.subtnbr + 1 ) * sizeof( pastix_int_t ) );
+    for ( k = 0; k < cblknbr; k++ ) {
+        if ( subttab[k] != -1 ) {
+            cblkptr[subttab[k] + 1]++;
+        }
+    }
+    for ( s = 0; s < args.subtnbr; s++ ) {
+        cblkptr[s + 1] += cblkptr[s];
+    }
+
+    MALLOC_INTERN( cblktab, pastix_imax( cblkptr[args.subtnbr], 1 ), pastix_int_t );
+    memcpy( cblknbr_subt, cblkptr, args.subtnbr * sizeof( pastix_int_t ) );
+    for ( k = 0; k < cblknbr; k++ ) {
+        s = subttab[k];
+        if ( s != -1 ) {
+            cblktab[cblknbr_subt[s]] = k;
+            cblknbr_subt[s]++;
+        }
+    }
+    memFree( cblknbr_subt );
+
+    args.graphL   = graphL;
+    args.rangtab  = order->rangtab;
+    args.treetab  = treetab;
+    args.subttab  = subttab;
+    args.cblkptr  = cblkptr;
+    args.cblktab  = cblktab;
+    args.subtnext = 0;
+    if ( args.subtnbr > 0 ) {
+        isched_parallel_call( isched, thread_fax_csr_direct, &args );
+    }
+
+    /* Merge the roots of the subtrees and the cblks above them */
+    for ( k = 0; k < cblknbr; k++ ) {
+        father = treetab[k];
+        if ( ( father != k ) && ( father > 0 ) &&
+             ( ( subttab[k] == -1 ) || ( subttab[father] != subttab[k] ) ) )
+        {
+            fax_csr_direct_merge( graphL, order->rangtab, k, father, tmp );
+        }
+    }
+
+    memFree( subttab );
+    memFree( cblkptr );
+    memFree( cblktab );
+}
+
 /**
  *******************************************************************************
  *
@@ -26,6 +227,10 @@
  * @brief Compute the non zero pattern of the direct factorization of a matrix
  * A, given the supernode partition associated.
  *
+ * If a scheduler with more than one thread is given, the independent subtrees
+ * of the elimination tree are factorized in parallel, and the generated graph
+ * is identical to the sequential one.
+ *
  *******************************************************************************
  *
  * @param[in] graphA
@@ -39,6 +244,10 @@
  *          matrix.  On entry, a pointer to a graph structure. No need for
  *          initialization.  On exit, the structure contains the computed graph.
  *
+ * @param[in] isched
+ *          The internal scheduler used to parallelize the computation. If NULL,
+ *          the computation is sequential.
+ *
  *******************************************************************************
  *
  * @retval >=0, the number of non zero entries in the generated graph.
@@ -46,12 +255,14 @@
  *
  *******************************************************************************/
 pastix_int_t
-faxCSRFactDirect( const fax_csr_t *graphA, const pastix_order_t *order, fax_csr_t *graphL )
+faxCSRFactDirect( const fax_csr_t      *graphA,
+                  const pastix_order_t *order,
+                  fax_csr_t            *graphL,
+                  isched_t             *isched )
 {
     pastix_int_t        i, k, nnz;
-    pastix_int_t        nnznbr, father;
+    pastix_int_t        father;
     pastix_int_t       *tmp     = NULL;
-    pastix_int_t       *ja      = NULL;
     pastix_int_t        cblknbr;
     const pastix_int_t *rangtab;
     const pastix_int_t *treetab;
@@ -83,32 +294,20 @@ faxCSRFactDirect( const fax_csr_t *graphA, const pastix_order_t *order, fax_csr_
     MALLOC_INTERN( tmp, graphA->n, pastix_int_t );
 
     /* Compute the nnz structure of each supernode in A */
-    faxCSRCblkCompress( graphA, order, graphL, tmp );
+    faxCSRCblkCompress( graphA, order, graphL, tmp, isched );
 
     /* Compute the symbolic factorization */
-    for ( k = 0; k < cblknbr; k++, treetab++ ) {
-        father = *treetab;
-
-        /* Merge son's nodes into father's list */
-        if ( ( father != k ) && ( father > 0 ) ) {
-            i  = 0;
-            ja = graphL->rows[k];
+    if ( ( isched != NULL ) && ( isched->world_size > 1 ) ) {
+        fax_csr_direct_parallel( graphL, order, tmp, isched );
+    }
+    else {
+        for ( k = 0; k < cblknbr; k++, treetab++ ) {
+            father = *treetab;
 
-            /* Take only the trows outside the cblk */
-            while ( ( i < graphL->nnz[k] ) && ( ja[i] < rangtab[k+1] ) ) {
-                i++;
+            /* Merge son's nodes into father's list */
+            if ( ( father != k ) && ( father > 0 ) ) {
+                fax_csr_direct_merge( graphL, rangtab, k, father, tmp );
             }
-
-            nnznbr = pastix_intset_union( graphL->nnz[k] - i,
-                                          graphL->rows[k] + i,
-                                          graphL->nnz[father],
-                                          graphL->rows[father],
-                                          tmp );
-
-            memFree( graphL->rows[father] );
-            MALLOC_INTERN( graphL->rows[father], nnznbr, pastix_int_t );
-            memcpy( graphL->rows[father], tmp, sizeof( pastix_int_t ) * nnznbr );
-            graphL->nnz[father] = nnznbr;
         }
     }
 
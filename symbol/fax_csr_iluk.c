@@ -18,6 +18,122 @@
 #include "pastix/order.h"
 #include "fax_csr.h"
 
+/**
+ * @brief Compute the non zero pattern of the row i of the levelized incomplete
+ * factor.
+ *
+ * The visited array must be initialized to -1 before the first call, and is
+ * reused for the following rows. The length, stack and ja arrays are
+ * workspaces of size graphA->n.
+ *
+ * @return The number of non zero entries of the row.
+ */
+static inline pastix_int_t
+fax_csr_iluk_row( const fax_csr_t *graphA,
+                  pastix_int_t     level,
+                  pastix_int_t     i,
+                  fax_csr_t       *graphL,
+                  pastix_int_t    *visited,
+                  pastix_int_t    *length,
+                  pastix_int_t    *stack,
+                  pastix_int_t    *ja )
+{
+    pastix_int_t *adj;
+    pastix_int_t  used;
+    pastix_int_t  h, j, k, t;
+
+    /** Reset the stack number of elements **/
+    stack[0] = i;
+    used     = 1;
+
+    length[i]  = 0;
+    visited[i] = i;
+
+    ja[0] = i; /** Put the diagonal term **/
+    k     = 1;
+
+    /** BFS phase **/
+    while ( used > 0 ) {
+        used--;
+        h   = stack[used];
+        adj = graphA->rows[h];
+        for ( j = 0; j < graphA->nnz[h]; j++ ) {
+            t = adj[j];
+            if ( visited[t] != i ) {
+                visited[t] = i;
+                if ( ( t < i ) && ( length[h] < level ) ) {
+                    stack[used] = t;
+                    used++;
+                    length[t] = length[h] + 1;
+                }
+                if ( t > i ) {
+                    ja[k++] = t;
+                }
+            }
+        }
+    }
+
+    assert( k > 0 );
+
+    graphL->nnz[i] = k;
+    MALLOC_INTERN( graphL->rows[i], k, pastix_int_t );
+    memcpy( graphL->rows[i], ja, k * sizeof( pastix_int_t ) );
+
+    intSort1asc1( graphL->rows[i], graphL->nnz[i] );
+
+    return k;
+}
+
+/**
+ * @brief Arguments of the multi-threaded levelized incomplete factorization.
+ */
+struct args_fax_iluk_s {
+    const fax_csr_t *graphA;
+    pastix_int_t     level;
+    fax_csr_t       *graphL;
+    long            *nnz;
+};
+
+/**
+ * @brief Compute the rows of the incomplete factor in a cyclic distribution
+ * over the threads.
+ *
+ * The rows are independent from each other, each thread uses its own
+ * workspaces of size graphA->n.
+ */
+static void
+thread_fax_csr_iluk( isched_thread_t *ctx, void *args )
+{
+    struct args_fax_iluk_s *arg    = (struct args_fax_iluk_s *)args;
+    const fax_csr_t        *graphA = arg->graphA;
+    pastix_int_t            rank   = (pastix_int_t)ctx->rank;
+    pastix_int_t            size   = (pastix_int_t)ctx->global_ctx->world_size;
+    pastix_int_t           *visited, *length, *stack, *ja;
+    pastix_int_t            i;
+    long                    nnz = 0;
+
+    MALLOC_INTERN( visited, graphA->n, pastix_int_t );
+    MALLOC_INTERN( length,  graphA->n, pastix_int_t );
+    MALLOC_INTERN( stack,   graphA->n, pastix_int_t );
+    MALLOC_INTERN( ja,      graphA->n, pastix_int_t );
+
+    for ( i = 0; i < graphA->n; i++ ) {
+        visited[i] = -1;
+        length[i]  = 0;
+    }
+
+    for ( i = rank; i < graphA->n; i += size ) {
+        nnz += fax_csr_iluk_row( graphA, arg->level, i, arg->graphL,
+                                 visited, length, stack, ja );
+    }
+    arg->nnz[rank] = nnz;
+
+    memFree_null( ja );
+    memFree_null( visited );
+    memFree_null( length );
+    memFree_null( stack );
+}
+
 /**
  *******************************************************************************
  *
@@ -47,6 +163,10 @@
  *          On entry, a pointer to a graph structure. No need for initialization.
  *          On exit, the structure contains the computed graph.
  *
+ * @param[in] isched
+ *          The internal scheduler used to compute the rows in parallel. If
+ *          NULL, the computation is sequential.
+ *
  *******************************************************************************
  *
  * @retval >=0, the number of non zero entries in the generated graph.
@@ -57,15 +177,14 @@ pastix_int_t
 faxCSRFactILUk( const fax_csr_t      *graphA,
                 const pastix_order_t *order,
                 pastix_int_t          level,
-                fax_csr_t            *graphL )
+                fax_csr_t            *graphL,
+                isched_t             *isched )
 {
     pastix_int_t *visited = NULL;
     pastix_int_t *length  = NULL;
     pastix_int_t *stack   = NULL;
-    pastix_int_t *adj     = NULL;
     pastix_int_t *ja      = NULL;
-    pastix_int_t  used;
-    pastix_int_t  h, i, j, k, t;
+    pastix_int_t  i, j;
     long          nnz;
     fax_csr_t     tmpgrah;
 
@@ -87,71 +206,54 @@ faxCSRFactILUk( const fax_csr_t      *graphA,
 
     /** Allocated the working array **/
     MALLOC_INTERN( visited, graphA->n, pastix_int_t );
-    MALLOC_INTERN( length,  graphA->n, pastix_int_t );
-    MALLOC_INTERN( stack,   graphA->n, pastix_int_t );
-    MALLOC_INTERN( ja,      graphA->n, pastix_int_t );
     nnz = 0;
 
-    /** Initialized visited ***/
-    for ( j = 0; j < graphA->n; j++ ) {
-        visited[j] = -1;
-        length[j]  = 0;
-    }
+    faxCSRInit( graphA->n, graphL );
 
     /** Apply GS_Urow for each row **/
-    faxCSRInit( graphA->n, graphL );
-    for ( i = 0; i < graphA->n; i++ ) {
-        /** Reset the stack number of elements **/
-        stack[0] = i;
-        used     = 1;
+    if ( ( isched != NULL ) && ( isched->world_size > 1 ) ) {
+        struct args_fax_iluk_s args;
+        long                  *nnzloc;
 
-        length[i]  = 0;
-        visited[i] = i;
-
-        ja[0] = i; /** Put the diagonal term **/
-        k     = 1;
-
-        /** BFS phase **/
-        while ( used > 0 ) {
-            used--;
-            h   = stack[used];
-            adj = graphA->rows[h];
-            for ( j = 0; j < graphA->nnz[h]; j++ ) {
-                t = adj[j];
-                if ( visited[t] != i ) {
-                    visited[t] = i;
-                    if ( ( t < i ) && ( length[h] < level ) ) {
-                        stack[used] = t;
-                        used++;
-                        length[t] = length[h] + 1;
-                    }
-                    if ( t > i ) {
-                        ja[k++] = t;
-                    }
-                }
-            }
-        }
+        MALLOC_INTERN( nnzloc, isched->world_size, long );
+        args.graphA = graphA;
+        args.level  = level;
+        args.graphL = graphL;
+        args.nnz    = nnzloc;
+        isched_parallel_call( isched, thread_fax_csr_iluk, &args );
 
-        assert( k > 0 );
+        for ( i = 0; i < isched->world_size; i++ ) {
+            nnz += nnzloc[i];
+        }
+        memFree_null( nnzloc );
+    }
+    else {
+        MALLOC_INTERN( length, graphA->n, pastix_int_t );
+        MALLOC_INTERN( stack,  graphA->n, pastix_int_t );
+        MALLOC_INTERN( ja,     graphA->n, pastix_int_t );
 
-        graphL->nnz[i] = k;
-        MALLOC_INTERN( graphL->rows[i], k, pastix_int_t );
-        memcpy( graphL->rows[i], ja, k * sizeof( pastix_int_t ) );
+        /** Initialized visited ***/
+        for ( j = 0; j < graphA->n; j++ ) {
+            visited[j] = -1;
+            length[j]  = 0;
+        }
 
-        intSort1asc1( graphL->rows[i], graphL->nnz[i] );
+        for ( i = 0; i < graphA->n; i++ ) {
+            nnz += fax_csr_iluk_row( graphA, level, i, graphL,
+                                     visited, length, stack, ja );
+        }
 
-        nnz += k;
+        memFree_null( ja );
+        memFree_null( length );
+        memFree_null( stack );
     }
 
     /* Compress with the elementary partition */
     tmpgrah = *graphL;
-    faxCSRCblkCompress( &tmpgrah, order, graphL, visited );
+    faxCSRCblkCompress( &tmpgrah, order, graphL, visited, isched );
     faxCSRClean( &tmpgrah );
 
-    memFree_null( ja );
     memFree_null( visited );
-    memFree_null( length );
-    memFree_null( stack );
 
     graphL->total_nnz = nnz;
     return nnz;
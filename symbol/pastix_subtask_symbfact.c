@@ -239,7 +239,8 @@ pastix_subtask_symbfact( pastix_data_t *pastix_data )
             pastixSymbolFaxILUk( pastix_data->symbmtx, /* Symbol Matrix   */
                                  iparm[IPARM_LEVEL_OF_FILL],
                                  graph,
-                                 ordemesh );
+                                 ordemesh,
+                                 pastix_data->isched );
         }
 
         /* Set the beginning of the Schur complement */
@@ -244,7 +244,8 @@ int          pastixSymbolFaxDirect ( symbol_matrix_t      *symbptr,
 int          pastixSymbolFaxILUk   ( symbol_matrix_t      *symbptr,
                                      pastix_int_t          levelk,
                                      const pastix_graph_t *graphA,
-                                     const pastix_order_t *ordeptr );
+                                     const pastix_order_t *ordeptr,
+                                     isched_t             *isched );
 void         pastixSymbolRustine   ( symbol_matrix_t *symbptr, symbol_matrix_t *symbptr2 );
 void         pastixSymbolBuildRowtab( symbol_matrix_t *symbptr );
 pastix_int_t pastixSymbolGetFacingBloknum( const symbol_matrix_t *symbptr,
@@ -45,6 +45,10 @@
  *          On exit, contains the symbol matrix associated to the graph P and
  *          the supernode partition given.
  *
+ * @param[in] isched
+ *          The internal scheduler used to compute the scalar incomplete factor
+ *          in parallel. If NULL, the computation is sequential.
+ *
  *******************************************************************************
  *
  * @retval 0  on success.
@@ -55,7 +59,8 @@ int
 pastixSymbolFaxILUk( symbol_matrix_t      *symbptr,
                      pastix_int_t          levelk,
                      const pastix_graph_t *graphA,
-                     const pastix_order_t *ordeptr )
+                     const pastix_order_t *ordeptr,
+                     isched_t             *isched )
 {
     pastix_int_t  i, j, k, l;
     pastix_int_t  cblknum;
@@ -89,7 +94,7 @@ pastixSymbolFaxILUk( symbol_matrix_t      *symbptr,
 
     /* Create the graph of L */
     memset( &graphL, 0, sizeof(fax_csr_t) );
-    faxCSRFactILUk( &graphPA, ordeptr, levelk, &graphL );
+    faxCSRFactILUk( &graphPA, ordeptr, levelk, &graphL, isched );
     faxCSRClean( &graphPA );
 
     assert( cblknbr == graphL.n );
@@ -97,7 +97,8 @@ int main (int argc, char **argv)
     bcscInit( spm,
               pastix_data->ordemesh,
               pastix_data->solvmatr,
-              spm->mtxtype == SpmGeneral, &bcsc );
+              spm->mtxtype == SpmGeneral,
+              pastix_data->isched, &bcsc );
 
     printf(" -- BCSC Norms Test --\n");
     printf(" Datatype: %s\n", fltnames[spm->flttype] );
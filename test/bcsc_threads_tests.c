@@ -0,0 +1,205 @@
+/**
+ *
+ * @file bcsc_threads_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests that the block csc built with several threads is identical to the one
+ * built with a single thread.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include <bcsc.h>
+#include "isched.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+char* fltnames[] = { "Pattern", "", "Float", "Double", "Complex32", "Complex64" };
+char* mtxnames[] = { "General", "Symmetric", "Hermitian" };
+
+/**
+ * @brief Compare the structure and the values of two block csc.
+ */
+static int
+bcsc_compare( const pastix_bcsc_t *bcscseq,
+              const pastix_bcsc_t *bcscthr )
+{
+    const bcsc_cblk_t *cblkseq = bcscseq->cscftab;
+    const bcsc_cblk_t *cblkthr = bcscthr->cscftab;
+    pastix_int_t nnz = 0;
+    size_t       eltsize;
+    pastix_int_t k;
+
+    if ( (bcscseq->gN      != bcscthr->gN)      ||
+         (bcscseq->n       != bcscthr->n)       ||
+         (bcscseq->mtxtype != bcscthr->mtxtype) ||
+         (bcscseq->flttype != bcscthr->flttype) ||
+         (bcscseq->cscfnbr != bcscthr->cscfnbr) )
+    {
+        return 1;
+    }
+
+    /* Column pointers */
+    for (k = 0; k < bcscseq->cscfnbr; k++, cblkseq++, cblkthr++) {
+        if ( (cblkseq->colnbr  != cblkthr->colnbr)  ||
+             (cblkseq->cblknum != cblkthr->cblknum) ||
+             memcmp( cblkseq->coltab, cblkthr->coltab,
+                     (cblkseq->colnbr + 1) * sizeof(pastix_int_t) ) )
+        {
+            return 2;
+        }
+    }
+
+    if ( bcscseq->cscfnbr > 0 ) {
+        cblkseq = bcscseq->cscftab + bcscseq->cscfnbr - 1;
+        nnz = cblkseq->coltab[ cblkseq->colnbr ];
+    }
+    if ( nnz == 0 ) {
+        return 0;
+    }
+
+    /* Rows */
+    if ( memcmp( bcscseq->rowtab, bcscthr->rowtab, nnz * sizeof(pastix_int_t) ) ) {
+        return 3;
+    }
+
+    /* Values */
+    eltsize = pastix_size_of( bcscseq->flttype );
+    if ( memcmp( bcscseq->Lvalues, bcscthr->Lvalues, nnz * eltsize ) ) {
+        return 4;
+    }
+
+    if ( (bcscseq->Uvalues == bcscseq->Lvalues) !=
+         (bcscthr->Uvalues == bcscthr->Lvalues) )
+    {
+        return 5;
+    }
+    if ( (bcscseq->Uvalues != NULL) &&
+         (bcscseq->Uvalues != bcscseq->Lvalues) )
+    {
+        if ( (bcscthr->Uvalues == NULL) ||
+             memcmp( bcscseq->Uvalues, bcscthr->Uvalues, nnz * eltsize ) )
+        {
+            return 6;
+        }
+    }
+    return 0;
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /* Pointer to a storage structure needed by pastix  */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                    */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                   */
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user               */
+    spmatrix_t     *spm, spm2;
+    pastix_bcsc_t   bcscseq, bcscthr;
+    isched_t       *ischedseq, *ischedthr;
+    double          timeseq, timethr;
+    char           *filename;           /* Filename(s) given by user                        */
+    int thrdnbr;
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    /**
+     * Initialize the PaStiX library
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    /**
+     * Run preprocessing steps required to generate the blocked csc
+     */
+    pastix_task_analyze( pastix_data, spm );
+
+    /**
+     * Generate the blocked csc with one, and several threads
+     */
+    thrdnbr = ( iparm[IPARM_THREAD_NBR] > 1 ) ? iparm[IPARM_THREAD_NBR] : 4;
+    ischedseq = ischedInit( 1,       NULL );
+    ischedthr = ischedInit( thrdnbr, NULL );
+
+    timeseq = bcscInit( spm,
+                        pastix_data->ordemesh,
+                        pastix_data->solvmatr,
+                        spm->mtxtype == SpmGeneral,
+                        ischedseq, &bcscseq );
+
+    timethr = bcscInit( spm,
+                        pastix_data->ordemesh,
+                        pastix_data->solvmatr,
+                        spm->mtxtype == SpmGeneral,
+                        ischedthr, &bcscthr );
+
+    printf(" -- BCSC Threads Test --\n");
+    printf(" Datatype: %s\n", fltnames[spm->flttype] );
+    printf("   Matrix type : %s\n", mtxnames[spm->mtxtype - SpmGeneral] );
+    printf("   Init time   : %e s (1 thread) / %e s (%d threads)\n",
+           timeseq, timethr, thrdnbr );
+
+    printf("   Block csc comparison: ");
+    ret = bcsc_compare( &bcscseq, &bcscthr );
+    PRINT_RES(ret);
+
+    bcscExit( &bcscseq );
+    bcscExit( &bcscthr );
+    ischedFinalize( ischedseq );
+    ischedFinalize( ischedthr );
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_data );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
@@ -109,6 +109,7 @@ int main ( int argc, char **argv )
               pastix_data->ordemesh,
               pastix_data->solvmatr,
               spm->mtxtype == SpmGeneral,
+              pastix_data->isched,
               pastix_data->bcsc );
 
     if ( check ) {
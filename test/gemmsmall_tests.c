@@ -0,0 +1,191 @@
+/**
+ *
+ * @file gemmsmall_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests the factorization with the updates computed by the small GEMM kernel.
+ *
+ * The model of the 1D GEMM kernel is replaced by one with a large call
+ * overhead, such that every 1D cblk is selected for the small kernel. The
+ * selection is checked through several factorizations with the same analysis,
+ * as well as the residual of the solution without refinement.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include "blend/solver.h"
+#include "common/models.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+/**
+ * @brief Number of factorizations with the same analysis.
+ */
+#define GEMMSMALL_NFACT 2
+
+/**
+ * @brief Replace the model of the 1D GEMM kernel by one whose call overhead
+ * dominates any update.
+ */
+static void
+gemmsmall_force( pastix_model_t *model )
+{
+    double *coefs;
+    int     a, i;
+
+    for (a = 0; a < 4; a++) {
+        coefs = model->coefficients[a][PastixKernelGEMMCblk1d1d];
+        for (i = 0; i < 8; i++) {
+            coefs[i] = 0.;
+        }
+        coefs[0] = 1.;
+        coefs[7] = 1.e-12;
+    }
+}
+
+/**
+ * @brief Check that all the 1D cblks with updates are selected for the small
+ * GEMM kernel.
+ *
+ * @return 0 if the selection is the expected one, 1 otherwise.
+ */
+static int
+gemmsmall_check( const SolverMatrix *solvmtx,
+                 pastix_int_t       *nbsmall )
+{
+    const SolverCblk *cblk = solvmtx->cblktab;
+    pastix_int_t      i, nbelig = 0;
+    int               elig;
+
+    *nbsmall = 0;
+    for (i = 0; i < solvmtx->cblknbr; i++, cblk++) {
+        elig = !(cblk->cblktype & (CBLK_LAYOUT_2D | CBLK_COMPRESSED | CBLK_FANIN | CBLK_RECV)) &&
+            (cblk->fblokptr + 1 < cblk[1].fblokptr);
+
+        if ( cblk->gemmsmall && !elig ) {
+            return 1;
+        }
+        nbelig   += elig;
+        *nbsmall += cblk->gemmsmall;
+    }
+    return (nbelig == 0) || (*nbsmall != nbelig) ||
+        (solvmtx->gemmsmalltype != solvmtx->flttype);
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /* Pointer to a storage structure needed by pastix  */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                    */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                   */
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user               */
+    spmatrix_t     *spm, spm2;
+    char           *filename;           /* Filename(s) given by user                        */
+    void           *x, *b;
+    size_t          size;
+    pastix_int_t    nbsmall;
+    double          normA, eps;
+    int             nrhs = 1;
+    int             f;
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    /**
+     * Initialize the PaStiX library
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+    gemmsmall_force( pastix_data->cpu_models );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    pastix_task_analyze( pastix_data, spm );
+
+    normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /* The solution is checked without refinement to not hide wrong factors */
+    eps = ( (spm->flttype == SpmFloat) || (spm->flttype == SpmComplex32) ) ? 1e-6 : 1e-12;
+
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x    = malloc( size );
+    b    = malloc( size );
+
+    printf(" -- Small GEMM Kernel Test --\n");
+
+    for (f = 0; f < GEMMSMALL_NFACT; f++) {
+        pastix_task_numfact( pastix_data, spm );
+
+        printf("   Factorization %d:\n", f );
+        printf("     Selection : ");
+        ret = gemmsmall_check( pastix_data->solvmatr, &nbsmall );
+        PRINT_RES( ret );
+        printf("     Small cblks : %ld / %ld\n",
+               (long)nbsmall, (long)pastix_data->solvmatr->cblknbr );
+
+        spmGenRHS( SpmRhsRndX, nrhs, spm, NULL, spm->n, b, spm->n );
+        memcpy( x, b, size );
+        pastix_task_solve( pastix_data, nrhs, x, spm->n );
+
+        printf("     Residual  : ");
+        ret = spmCheckAxb( eps, nrhs, spm, NULL, spm->n, b, spm->n, x, spm->n );
+        PRINT_RES( ret );
+    }
+
+    free( x );
+    free( b );
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_data );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
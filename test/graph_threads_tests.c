@@ -0,0 +1,171 @@
+/**
+ *
+ * @file graph_threads_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests that the centralized graph prepared with several threads is identical
+ * to the one prepared sequentially.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include "graph/graph.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+char* mtxnames[] = { "General", "Symmetric", "Hermitian" };
+
+/**
+ * @brief Compare two graphs.
+ */
+static int
+graph_compare( const pastix_graph_t *graphseq,
+               const pastix_graph_t *graphthr )
+{
+    pastix_int_t nnz;
+
+    if ( (graphseq->gN != graphthr->gN) ||
+         (graphseq->n  != graphthr->n ) )
+    {
+        return 1;
+    }
+
+    if ( memcmp( graphseq->colptr, graphthr->colptr,
+                 (graphseq->n + 1) * sizeof(pastix_int_t) ) )
+    {
+        return 2;
+    }
+
+    nnz = graphseq->colptr[ graphseq->n ] - graphseq->colptr[0];
+    if ( (nnz > 0) &&
+         memcmp( graphseq->rows, graphthr->rows, nnz * sizeof(pastix_int_t) ) )
+    {
+        return 3;
+    }
+    return 0;
+}
+
+/**
+ * @brief Prepare the graph of the spm with the given instance.
+ */
+static double
+graph_run( pastix_data_t     *pastix_data,
+           const spmatrix_t  *spm,
+           pastix_graph_t   **graph )
+{
+    double timer;
+
+    clockStart( timer );
+    graphPrepare( pastix_data, spm, graph );
+    clockStop( timer );
+
+    return clockVal( timer );
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_seq = NULL;  /* Sequential instance                             */
+    pastix_data_t  *pastix_thr = NULL;  /* Threaded instance                               */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                   */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                  */
+    pastix_int_t    iparm_seq[IPARM_SIZE];
+    double          dparm_seq[DPARM_SIZE];
+    pastix_int_t    iparm_thr[IPARM_SIZE];
+    double          dparm_thr[DPARM_SIZE];
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user              */
+    spmatrix_t     *spm, spm2;
+    pastix_graph_t *graphseq = NULL;
+    pastix_graph_t *graphthr = NULL;
+    double          timeseq, timethr;
+    char           *filename;           /* Filename(s) given by user                       */
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    /**
+     * Prepare the graph with one, and several threads
+     */
+    memcpy( iparm_seq, iparm, IPARM_SIZE * sizeof(pastix_int_t) );
+    memcpy( dparm_seq, dparm, DPARM_SIZE * sizeof(double) );
+    memcpy( iparm_thr, iparm, IPARM_SIZE * sizeof(pastix_int_t) );
+    memcpy( dparm_thr, dparm, DPARM_SIZE * sizeof(double) );
+
+    iparm_seq[IPARM_THREAD_NBR] = 1;
+    if ( iparm_thr[IPARM_THREAD_NBR] < 2 ) {
+        iparm_thr[IPARM_THREAD_NBR] = 4;
+    }
+
+    pastixInit( &pastix_seq, MPI_COMM_WORLD, iparm_seq, dparm_seq );
+    pastixInit( &pastix_thr, MPI_COMM_WORLD, iparm_thr, dparm_thr );
+
+    timeseq = graph_run( pastix_seq, spm, &graphseq );
+    timethr = graph_run( pastix_thr, spm, &graphthr );
+
+    printf(" -- Threaded Graph Preparation Test --\n");
+    printf("   Matrix type : %s\n", mtxnames[spm->mtxtype - SpmGeneral] );
+    printf("   Prepare time: %e s (1 thread) / %e s (%d threads)\n",
+           timeseq, timethr, (int)iparm_thr[IPARM_THREAD_NBR] );
+
+    printf("   Graph comparison: ");
+    ret = graph_compare( graphseq, graphthr );
+    PRINT_RES(ret);
+
+    graphExit( graphseq );
+    graphExit( graphthr );
+    memFree_null( graphseq );
+    memFree_null( graphthr );
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_thr );
+    pastixFinalize( &pastix_seq );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ *
+ * @file isched_time.c
+ *
+ * Tests and measures the fork/join latency of the internal scheduler.
+ * An empty parallel section is launched a large number of times, and each
+ * thread increments a shared counter to check that every call has been
+ * executed once by all the threads.
+ *
+ * @copyright 2015-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <pastix.h>
+#include "common.h"
+
+/**
+ * @brief Arguments of the empty parallel section
+ */
+struct args_isched_s {
+    volatile int32_t counter;
+};
+
+static void
+isched_time_empty( isched_thread_t *ctx, void *args )
+{
+    struct args_isched_s *arg = (struct args_isched_s*)args;
+    pastix_atomic_inc_32b( &(arg->counter) );
+    (void)ctx;
+}
+
+int main ( int argc, char **argv )
+{
+    pastix_data_t       *pastix_data = NULL;
+    pastix_int_t         iparm[IPARM_SIZE];  /*< Integer in/out parameters for pastix */
+    pastix_fixdbl_t      dparm[DPARM_SIZE];  /*< Floating in/out parameters for pastix */
+    spm_driver_t         driver   = (spm_driver_t)-1;
+    char                *filename = NULL;
+    int                  check    = 1;
+    int                  i, nbcalls, size;
+    int                  rc = 0;
+    struct args_isched_s args = { 0 };
+    Clock                timer;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+    iparm[IPARM_VERBOSE] = PastixVerboseNot;
+
+    /**
+     * Get options from command line
+     * Prevent from failing if no arguments is given
+     */
+    if ( argc > 1 ) {
+        pastixGetOptions( argc, argv,
+                          iparm, dparm,
+                          &check, &driver, &filename );
+        free( filename );
+    }
+
+    /**
+     * Initialize the PaStiX library
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    size    = pastix_data->isched->world_size;
+    nbcalls = pastix_getenv_get_value_int( "PASTIX_ISCHED_NBCALLS", 100000 );
+
+    /* Warmup */
+    for ( i = 0; i < 100; i++ ) {
+        isched_parallel_call( pastix_data->isched, isched_time_empty, &args );
+    }
+    args.counter = 0;
+
+    clockStart( timer );
+    for ( i = 0; i < nbcalls; i++ ) {
+        isched_parallel_call( pastix_data->isched, isched_time_empty, &args );
+    }
+    clockStop( timer );
+
+    if ( args.counter != (nbcalls * size) ) {
+        fprintf( stderr, "isched_time: %d executions instead of %d\n",
+                 (int)args.counter, nbcalls * size );
+        rc = 1;
+    }
+
+    printf( "   Fork/join latency with %d threads: %e s (%d calls) %s\n",
+            size, clockVal(timer) / (double)nbcalls, nbcalls,
+            rc ? "FAILED" : "SUCCESS" );
+
+    pastixFinalize( &pastix_data );
+
+    return rc;
+}
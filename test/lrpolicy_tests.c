@@ -0,0 +1,273 @@
+/**
+ *
+ * @file lrpolicy_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests the per-block compression policy through several factorizations with
+ * the same analysis.
+ *
+ * Before each factorization, the method that the policy selects for each block
+ * is computed from the rank history left by the previous factorization. After
+ * the factorization, the history of each block is checked against this
+ * selection, and the residual of the solution is checked.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include "blend/solver.h"
+#include "kernels/pastix_lowrank.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+/**
+ * @brief Number of factorizations with the same analysis.
+ */
+#define LRPOLICY_NFACT 3
+
+/**
+ * @brief Loop over the two sides of each off-diagonal block of the compressed
+ * cblks.
+ */
+#define lrpolicy_foreach( _solvmtx_, _cblk_, _blok_, _side_ )           \
+    for ( (_cblk_) = (_solvmtx_)->cblktab;                              \
+          (_cblk_) < (_solvmtx_)->cblktab + (_solvmtx_)->cblknbr;       \
+          (_cblk_)++ )                                                  \
+        if ( (_cblk_)->cblktype & CBLK_COMPRESSED )                     \
+            for ( (_blok_) = (_cblk_)->fblokptr + 1;                    \
+                  (_blok_) < (_cblk_)[1].fblokptr;                      \
+                  (_blok_)++ )                                          \
+                for ( (_side_) = 0; (_side_) < 2; (_side_)++ )
+
+/**
+ * @brief Store the rank history of the blocks, and the method that the policy
+ * selects from it for the next factorization.
+ *
+ * @return The number of blocks for which a selection has been made.
+ */
+static pastix_int_t
+lrpolicy_predict( const SolverMatrix *solvmtx,
+                  int32_t            *rkhist,
+                  int32_t            *expected,
+                  int                *method,
+                  pastix_int_t       *counts )
+{
+    const SolverCblk *cblk;
+    const SolverBlok *blok;
+    pastix_int_t      i = 0, nbpred = 0;
+    int               side;
+
+    lrpolicy_foreach( solvmtx, cblk, blok, side ) {
+        rkhist[i]   = blok->rkhist[side];
+        expected[i] = blok->rkhist[side];
+        method[i]   = -1;
+
+        /* Blocks never reached by the compression are not predicted */
+        if ( rkhist[i] != -2 ) {
+            method[i] = core_lrpolicy( &(solvmtx->lowrank),
+                                       blok_rownbr( blok ), cblk_colnbr( cblk ),
+                                       cblk->updtwdth, expected + i );
+            counts[ method[i] + 1 ]++;
+            nbpred++;
+        }
+        i++;
+    }
+    return nbpred;
+}
+
+/**
+ * @brief Check the rank history of the blocks after a factorization against
+ * the selection of the policy.
+ *
+ * @return 0 if the history of every block is consistent, the number of
+ * inconsistent blocks otherwise.
+ */
+static pastix_int_t
+lrpolicy_check( const SolverMatrix *solvmtx,
+                const int32_t      *rkhist,
+                const int32_t      *expected,
+                const int          *method,
+                int                 first )
+{
+    const SolverCblk *cblk;
+    const SolverBlok *blok;
+    pastix_int_t      i = 0, nberr = 0;
+    int               side;
+    int32_t           rk;
+
+    lrpolicy_foreach( solvmtx, cblk, blok, side ) {
+        rk = blok->rkhist[side];
+
+        if ( rkhist[i] == -2 ) {
+            /*
+             * Only the first factorization reaches new blocks, and they are
+             * either compressed or kept in full-rank
+             */
+            if ( (rk != -2) && (!first || (rk < -1)) ) {
+                nberr++;
+            }
+        }
+        else if ( method[i] == -1 ) {
+            /* The block is kept in full-rank, and its history is updated */
+            if ( rk != expected[i] ) {
+                nberr++;
+            }
+        }
+        else {
+            /* The block is compressed, or found incompressible */
+            if ( rk < -1 ) {
+                nberr++;
+            }
+        }
+        i++;
+    }
+    return nberr;
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /* Pointer to a storage structure needed by pastix  */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                    */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                   */
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user               */
+    spmatrix_t     *spm, spm2;
+    SolverMatrix   *solvmtx;
+    char           *filename;           /* Filename(s) given by user                        */
+    void           *x, *b;
+    size_t          size;
+    int32_t        *rkhist, *expected;
+    int            *method;
+    pastix_int_t    counts[PastixCompressMethodNbr+1];
+    pastix_int_t    nbblok, nbpred, nberr;
+    double          normA;
+    int             nrhs = 1;
+    int             f, m;
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    /**
+     * The policy is only applied when the blocks are compressed at the end
+     */
+    iparm[IPARM_COMPRESS_WHEN]   = PastixCompressWhenEnd;
+    iparm[IPARM_COMPRESS_POLICY] = 1;
+
+    /**
+     * Initialize the PaStiX library
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    pastix_task_analyze( pastix_data, spm );
+
+    normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    solvmtx = pastix_data->solvmatr;
+    nbblok  = 2 * solvmtx->bloknbr;
+    rkhist   = malloc( nbblok * sizeof(int32_t) );
+    expected = malloc( nbblok * sizeof(int32_t) );
+    method   = malloc( nbblok * sizeof(int) );
+
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x    = malloc( size );
+    b    = malloc( size );
+
+    printf(" -- Compression Policy Test --\n");
+
+    for (f = 0; f < LRPOLICY_NFACT; f++) {
+        memset( counts, 0, (PastixCompressMethodNbr+1) * sizeof(pastix_int_t) );
+
+        /*
+         * No block has a history before the first factorization, and the
+         * low-rank parameters used by the prediction are set by it
+         */
+        nbpred = lrpolicy_predict( solvmtx, rkhist, expected, method, counts );
+
+        pastix_task_numfact( pastix_data, spm );
+
+        printf("   Factorization %d:\n", f );
+        printf("     Predicted blocks : %ld\n", (long)nbpred );
+        printf("     Full-rank        : %ld\n", (long)counts[0] );
+        for (m = 0; m < PastixCompressMethodNbr; m++) {
+            if ( counts[m+1] > 0 ) {
+                printf("     %-16s : %ld\n", compmeth_shnames[m], (long)counts[m+1] );
+            }
+        }
+
+        printf("     Rank history     : ");
+        nberr = lrpolicy_check( solvmtx, rkhist, expected, method, f == 0 );
+        PRINT_RES( (int)nberr );
+
+        spmGenRHS( SpmRhsRndX, nrhs, spm, NULL, spm->n, b, spm->n );
+        memcpy( x, b, size );
+        pastix_task_solve( pastix_data, nrhs, x, spm->n );
+        pastix_task_refine( pastix_data, spm->n, nrhs, b, spm->n, x, spm->n );
+
+        printf("     Residual         : ");
+        ret = spmCheckAxb( dparm[DPARM_EPSILON_REFINEMENT], nrhs, spm,
+                           NULL, spm->n, b, spm->n, x, spm->n );
+        PRINT_RES( ret );
+    }
+
+    free( rkhist );
+    free( expected );
+    free( method );
+    free( x );
+    free( b );
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_data );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
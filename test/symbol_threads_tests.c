@@ -0,0 +1,243 @@
+/**
+ *
+ * @file symbol_threads_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests that the threaded amalgamation and symbolic factorization generate the
+ * same ordering and symbol matrix as the sequential ones.
+ *
+ * The ordering is computed once, and given as a personal ordering without
+ * supernodes to one instance with a single thread, and to one instance with
+ * several threads. Both instances then find the supernodes, amalgamate them,
+ * and run the symbolic factorization, and the results are compared.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include "pastix/order.h"
+#include "symbol/symbol.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+/**
+ * @brief Compare two integer arrays of size n, that can both be NULL.
+ */
+static inline int
+cmp_inttab( const pastix_int_t *A,
+            const pastix_int_t *B,
+            pastix_int_t        n )
+{
+    if ( (A == NULL) || (B == NULL) ) {
+        return (A != B);
+    }
+    return memcmp( A, B, n * sizeof(pastix_int_t) ) != 0;
+}
+
+/**
+ * @brief Compare the orderings of the two instances.
+ */
+static int
+order_compare( const pastix_order_t *ordeseq,
+               const pastix_order_t *ordethr )
+{
+    if ( (ordeseq->vertnbr != ordethr->vertnbr) ||
+         (ordeseq->cblknbr != ordethr->cblknbr) )
+    {
+        return 1;
+    }
+    if ( cmp_inttab( ordeseq->permtab, ordethr->permtab, ordeseq->vertnbr ) ||
+         cmp_inttab( ordeseq->peritab, ordethr->peritab, ordeseq->vertnbr ) )
+    {
+        return 2;
+    }
+    if ( cmp_inttab( ordeseq->rangtab, ordethr->rangtab, ordeseq->cblknbr + 1 ) ||
+         cmp_inttab( ordeseq->treetab, ordethr->treetab, ordeseq->cblknbr ) )
+    {
+        return 3;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compare the symbol matrices of the two instances.
+ */
+static int
+symbol_compare( const symbol_matrix_t *symbseq,
+                const symbol_matrix_t *symbthr )
+{
+    const symbol_cblk_t *cblkseq, *cblkthr;
+    const symbol_blok_t *blokseq, *blokthr;
+    pastix_int_t i;
+
+    if ( (symbseq->baseval != symbthr->baseval) ||
+         (symbseq->cblknbr != symbthr->cblknbr) ||
+         (symbseq->bloknbr != symbthr->bloknbr) ||
+         (symbseq->nodenbr != symbthr->nodenbr) )
+    {
+        return 1;
+    }
+
+    cblkseq = symbseq->cblktab;
+    cblkthr = symbthr->cblktab;
+    for (i = 0; i <= symbseq->cblknbr; i++, cblkseq++, cblkthr++ ) {
+        if ( (cblkseq->fcolnum != cblkthr->fcolnum) ||
+             (cblkseq->lcolnum != cblkthr->lcolnum) ||
+             (cblkseq->bloknum != cblkthr->bloknum) )
+        {
+            return 2;
+        }
+    }
+
+    blokseq = symbseq->bloktab;
+    blokthr = symbthr->bloktab;
+    for (i = 0; i < symbseq->bloknbr; i++, blokseq++, blokthr++ ) {
+        if ( (blokseq->frownum != blokthr->frownum) ||
+             (blokseq->lrownum != blokthr->lrownum) ||
+             (blokseq->lcblknm != blokthr->lcblknm) ||
+             (blokseq->fcblknm != blokthr->fcblknm) )
+        {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Amalgamate the given ordering, and run the symbolic factorization.
+ */
+static void
+symbol_run( pastix_data_t        *pastix_data,
+            const spmatrix_t     *spm,
+            const pastix_order_t *ordemesh )
+{
+    pastix_order_t myorder;
+
+    pastixOrderAlloc( &myorder, ordemesh->vertnbr, 0 );
+    myorder.baseval = ordemesh->baseval;
+    memcpy( myorder.permtab, ordemesh->permtab, ordemesh->vertnbr * sizeof(pastix_int_t) );
+    memcpy( myorder.peritab, ordemesh->peritab, ordemesh->vertnbr * sizeof(pastix_int_t) );
+
+    pastix_data->iparm[IPARM_ORDERING] = PastixOrderPersonal;
+    pastix_subtask_order( pastix_data, spm, &myorder );
+    pastix_subtask_symbfact( pastix_data );
+
+    pastixOrderExit( &myorder );
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_ref = NULL;  /* Instance computing the ordering                 */
+    pastix_data_t  *pastix_seq = NULL;  /* Sequential instance                             */
+    pastix_data_t  *pastix_thr = NULL;  /* Threaded instance                               */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                   */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                  */
+    pastix_int_t    iparm_seq[IPARM_SIZE];
+    double          dparm_seq[DPARM_SIZE];
+    pastix_int_t    iparm_thr[IPARM_SIZE];
+    double          dparm_thr[DPARM_SIZE];
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user              */
+    spmatrix_t     *spm, spm2;
+    char           *filename;           /* Filename(s) given by user                       */
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    /**
+     * Compute the ordering once
+     */
+    memcpy( iparm_seq, iparm, IPARM_SIZE * sizeof(pastix_int_t) );
+    memcpy( dparm_seq, dparm, DPARM_SIZE * sizeof(double) );
+    memcpy( iparm_thr, iparm, IPARM_SIZE * sizeof(pastix_int_t) );
+    memcpy( dparm_thr, dparm, DPARM_SIZE * sizeof(double) );
+
+    pastixInit( &pastix_ref, MPI_COMM_WORLD, iparm, dparm );
+    pastix_subtask_order( pastix_ref, spm, NULL );
+
+    /**
+     * Amalgamation and symbolic factorization with one, and several threads
+     */
+    iparm_seq[IPARM_THREAD_NBR] = 1;
+    if ( iparm_thr[IPARM_THREAD_NBR] < 2 ) {
+        iparm_thr[IPARM_THREAD_NBR] = 4;
+    }
+
+    pastixInit( &pastix_seq, MPI_COMM_WORLD, iparm_seq, dparm_seq );
+    pastixInit( &pastix_thr, MPI_COMM_WORLD, iparm_thr, dparm_thr );
+
+    symbol_run( pastix_seq, spm, pastix_ref->ordemesh );
+    symbol_run( pastix_thr, spm, pastix_ref->ordemesh );
+
+    printf(" -- Threaded Symbolic Factorization Test --\n");
+    printf("   Threads        : %d\n", (int)iparm_thr[IPARM_THREAD_NBR] );
+    printf("   Incomplete     : %d (level %d)\n",
+           (int)iparm[IPARM_INCOMPLETE], (int)iparm[IPARM_LEVEL_OF_FILL] );
+    printf("   Order time     : %e s (1 thread) / %e s (%d threads)\n",
+           dparm_seq[DPARM_ORDER_TIME], dparm_thr[DPARM_ORDER_TIME],
+           (int)iparm_thr[IPARM_THREAD_NBR] );
+    printf("   Symbfact time  : %e s (1 thread) / %e s (%d threads)\n",
+           dparm_seq[DPARM_SYMBFACT_TIME], dparm_thr[DPARM_SYMBFACT_TIME],
+           (int)iparm_thr[IPARM_THREAD_NBR] );
+
+    printf("   Amalgamated ordering: ");
+    ret = order_compare( pastix_seq->ordemesh, pastix_thr->ordemesh );
+    PRINT_RES(ret);
+
+    printf("   Symbol matrix: ");
+    ret = symbol_compare( pastix_seq->symbmtx, pastix_thr->symbmtx );
+    PRINT_RES(ret);
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_thr );
+    pastixFinalize( &pastix_seq );
+    pastixFinalize( &pastix_ref );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,210 @@
+/**
+ *
+ * @file updtplan_tests.c
+ *
+ * @copyright 2020-2020 Bordeaux INP, CNRS (LaBRI UMR 5800), Inria,
+ *                      Univ. Bordeaux. All rights reserved.
+ *
+ * Tests the factorization with and without the update plans of the blocks.
+ *
+ * The plans are computed with the default limit, without any plan, and with
+ * a limit small enough for some cblks to have more off-diagonal blocks than
+ * the limit, such that the kernels mix the plans and the search of the facing
+ * blocks. For each of them, the plans are checked against the search, and the
+ * solution of the factorization is checked without refinement.
+ *
+ * @version 6.1.0
+ * @author Mathieu Faverge
+ * @date 2020-03-01
+ *
+ **/
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pastix.h>
+#include "common.h"
+#include <spm.h>
+#include "blend/solver.h"
+
+#define PRINT_RES(_ret_)                        \
+    if(_ret_) {                                 \
+        printf("FAILED(%d)\n", _ret_);          \
+        err++;                                  \
+    }                                           \
+    else {                                      \
+        printf("SUCCESS\n");                    \
+    }
+
+/**
+ * @brief Small limit on the number of blocks for the mixed case.
+ */
+#define UPDTPLAN_MAXBLOK_SMALL 4
+
+/**
+ * @brief Check the update plans of the blocks against the search of the
+ * facing blocks.
+ *
+ * @return 0 if the plans are consistent with maxblok, and every plan gives
+ * the facing block of the search, an error code otherwise.
+ */
+static int
+updtplan_check( const SolverMatrix *solvmtx,
+                pastix_int_t        maxblok,
+                pastix_int_t       *nbplan,
+                pastix_int_t       *nbwide )
+{
+    const SolverCblk *cblk, *fcblk;
+    SolverBlok       *blok, *iterblok, *fblok;
+    pastix_int_t      k, bloknbr;
+
+    *nbplan = 0;
+    *nbwide = 0;
+
+    cblk = solvmtx->cblktab;
+    for (k = 0; k < solvmtx->cblknbr; k++, cblk++) {
+        bloknbr = cblk[1].fblokptr - cblk[0].fblokptr - 1;
+        *nbwide += ( bloknbr > maxblok );
+
+        for (blok = cblk[0].fblokptr + 1; blok < cblk[1].fblokptr; blok++) {
+            if ( blok->updtplan == NULL ) {
+                continue;
+            }
+            if ( bloknbr > maxblok ) {
+                return 1;
+            }
+            (*nbplan)++;
+
+            fcblk = solvmtx->cblktab + blok->fcblknm;
+            fblok = fcblk->fblokptr;
+            for (iterblok = blok; iterblok < cblk[1].fblokptr; iterblok++) {
+                while ( !is_block_inside_fblock( iterblok, fblok ) ) {
+                    fblok++;
+                }
+                if ( fcblk->fblokptr + blok->updtplan[ iterblok - blok ] != fblok ) {
+                    return 2;
+                }
+            }
+        }
+    }
+
+    /* The plans are built as soon as a cblk has at most maxblok blocks */
+    if ( (maxblok > 0) && (*nbplan == 0) ) {
+        return 3;
+    }
+    if ( (maxblok == 0) && (solvmtx->updtnbr != 0) ) {
+        return 4;
+    }
+    return 0;
+}
+
+int main (int argc, char **argv)
+{
+    pastix_data_t  *pastix_data = NULL; /* Pointer to a storage structure needed by pastix  */
+    pastix_int_t    iparm[IPARM_SIZE];  /* integer parameters for pastix                    */
+    double          dparm[DPARM_SIZE];  /* floating parameters for pastix                   */
+    spm_driver_t    driver;             /* Matrix driver(s) requested by user               */
+    spmatrix_t     *spm, spm2;
+    char           *filename;           /* Filename(s) given by user                        */
+    void           *x, *x0, *b;
+    size_t          size;
+    pastix_int_t    maxbloks[3] = { SOLVER_UPDTPLAN_MAXBLOK, 0, UPDTPLAN_MAXBLOK_SMALL };
+    const char     *names[3]    = { "Default plans", "No plan", "Mixed plans" };
+    pastix_int_t    nbplan, nbwide;
+    double          normA, eps;
+    int             nrhs = 1;
+    int             i;
+    int ret = PASTIX_SUCCESS;
+    int err = 0;
+
+    /**
+     * Initialize parameters to default values
+     */
+    pastixInitParam( iparm, dparm );
+
+    /**
+     * Get options from command line
+     */
+    pastixGetOptions( argc, argv,
+                      iparm, dparm,
+                      NULL, &driver, &filename );
+
+    /**
+     * Initialize the PaStiX library
+     */
+    pastixInit( &pastix_data, MPI_COMM_WORLD, iparm, dparm );
+
+    spm = malloc( sizeof( spmatrix_t ) );
+    spmReadDriver( driver, filename, spm );
+    free(filename);
+
+    ret = spmCheckAndCorrect( spm, &spm2 );
+    if ( ret != 0 ) {
+        spmExit( spm );
+        *spm = spm2;
+    }
+
+    if ( spm->flttype == SpmPattern ) {
+        spmGenFakeValues( spm );
+    }
+
+    pastix_task_analyze( pastix_data, spm );
+
+    normA = spmNorm( SpmFrobeniusNorm, spm );
+    spmScalMatrix( 1./normA, spm );
+
+    /* The solution is checked without refinement to not hide wrong factors */
+    eps = ( (spm->flttype == SpmFloat) || (spm->flttype == SpmComplex32) ) ? 1e-6 : 1e-12;
+
+    size = pastix_size_of( spm->flttype ) * spm->n * nrhs;
+    x    = malloc( size );
+    x0   = malloc( size );
+    b    = malloc( size );
+    spmGenRHS( SpmRhsRndX, nrhs, spm, x0, spm->n, b, spm->n );
+
+    printf(" -- Update Plans Test --\n");
+
+    for (i = 0; i < 3; i++) {
+        solverUpdatePlanInit( pastix_data->solvmatr, maxbloks[i] );
+
+        printf("   %s (%ld blocks at most):\n", names[i], (long)maxbloks[i] );
+        printf("     Plans     : ");
+        ret = updtplan_check( pastix_data->solvmatr, maxbloks[i], &nbplan, &nbwide );
+        PRINT_RES( ret );
+        printf("     Blocks with a plan     : %ld\n", (long)nbplan );
+        printf("     Cblks above the limit  : %ld\n", (long)nbwide );
+
+        /* The mixed case requires cblks on both sides of the limit */
+        if ( (maxbloks[i] == UPDTPLAN_MAXBLOK_SMALL) && (nbwide == 0) ) {
+            printf("     Mixed case: FAILED(no cblk above the limit)\n");
+            err++;
+        }
+
+        pastix_task_numfact( pastix_data, spm );
+
+        memcpy( x, b, size );
+        pastix_task_solve( pastix_data, nrhs, x, spm->n );
+
+        printf("     Residual  : ");
+        ret = spmCheckAxb( eps, nrhs, spm, x0, spm->n, b, spm->n, x, spm->n );
+        PRINT_RES( ret );
+    }
+
+    free( x );
+    free( x0 );
+    free( b );
+
+    spmExit( spm );
+    free( spm );
+    pastixFinalize( &pastix_data );
+
+    if( err == 0 ) {
+        printf(" -- All tests PASSED --\n");
+        return EXIT_SUCCESS;
+    }
+    else
+    {
+        printf(" -- %d tests FAILED --\n", err);
+        return EXIT_FAILURE;
+    }
+}
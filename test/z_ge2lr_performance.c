@@ -110,7 +110,7 @@ z_lowrank_ge2lr_performance( FILE *f, int nbruns,
         core_zlrfree(&lrA);
 
         clockStart(timer);
-        lowrank->core_ge2lr( lowrank->use_reltol, lowrank->tolerance,
+        lowrank->core_ge2lr( lowrank, lowrank->use_reltol, lowrank->tolerance,
                              minMN, m, n, A->fr, lda, &lrA );
         clockStop(timer);
         assert( timer >= 0. );
@@ -191,8 +191,12 @@ int main( int argc, char **argv )
     lowrank.compress_min_height = 0;
     lowrank.use_reltol          = params.use_reltol;
     lowrank.tolerance           = params.tol_cmp;
+    lowrank.compress_min_ratio  = 1.;
+    lowrank.compress_ortho      = PastixCompressOrthoCGS;
+    lowrank.use_sketch          = 0;
     lowrank.core_ge2lr          = core_zge2lr_svd;
     lowrank.core_rradd          = core_zrradd_svd;
+    lowrank.core_rklimit        = core_get_rklimit_end;
 
     for (n=params.n[0]; n<=params.n[1]; n+=params.n[2]) {
         A.m  = n;
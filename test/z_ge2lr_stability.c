@@ -102,7 +102,7 @@ z_lowrank_stability_ge2lr( const pastix_lr_t   *lowrank,
     /*
      * Fully compress the matrix A
      */
-    lowrank->core_ge2lr( 1, -1., minMN, m, n, A->fr, lda, &lrA );
+    lowrank->core_ge2lr( lowrank, 1, -1., minMN, m, n, A->fr, lda, &lrA );
 
     /* Let's check we have the maximal rank */
     assert( lrA.rk == minMN );
@@ -152,8 +152,12 @@ int main( int argc, char **argv )
     lowrank.compress_min_height = 0;
     lowrank.use_reltol          = 1;
     lowrank.tolerance           = params.tol_gen;
+    lowrank.compress_min_ratio  = 1.;
+    lowrank.compress_ortho      = PastixCompressOrthoCGS;
+    lowrank.use_sketch          = 0;
     lowrank.core_ge2lr          = core_zge2lr_svd;
     lowrank.core_rradd          = core_zrradd_svd;
+    lowrank.core_rklimit        = core_get_rklimit_end;
 
     tolerance = params.tol_gen;
     threshold = params.threshold;
@@ -376,7 +376,7 @@ z_lowrank_genmat_comp( const pastix_lr_t *lowrank,
 {
     A->fr = malloc( A->ld * A->n * sizeof(pastix_complex64_t) );
     z_lowrank_genmat( mode, lowrank->tolerance, threshold, A );
-    lowrank->core_ge2lr( lowrank->use_reltol, lowrank->tolerance, pastix_imin( A->m, A->n ),
+    lowrank->core_ge2lr( lowrank, lowrank->use_reltol, lowrank->tolerance, pastix_imin( A->m, A->n ),
                          A->m, A->n, A->fr, A->ld, &(A->lr) );
 }
 
@@ -445,7 +445,7 @@ z_lowrank_check_ge2lr( pastix_lr_t   *lowrank,
          * Compress and then uncompress
          */
         timer = clockGetLocal();
-        lowrank->core_ge2lr( lowrank->use_reltol, lowrank->tolerance, minMN,
+        lowrank->core_ge2lr( lowrank, lowrank->use_reltol, lowrank->tolerance, minMN,
                              m, n, A->fr, ld, &(A->lr) );
         timer = clockGetLocal() - timer;
         assert( timer >= 0. );
@@ -566,7 +566,7 @@ z_lowrank_check_rradd( pastix_lr_t         *lowrank,
     double              norm_diff, res;
     Clock               timer;
     pastix_int_t        rkCmax;
-    pastix_int_t        rankmax = core_get_rklimit( B->m, B->n );
+    pastix_int_t        rankmax = core_get_rklimit( lowrank, B->m, B->n );
     int                 rc = 0;
 
     assert( C->m == B->m );
@@ -59,16 +59,17 @@ int main( int argc, char **argv )
         .compress_min_height = 0,
         .use_reltol          = 0,
         .tolerance           = tolerance,
+        .compress_min_ratio  = 1.,
+        .compress_ortho      = PastixCompressOrthoCGS,
         .core_ge2lr          = core_zge2lr_svd,
         .core_rradd          = core_zrradd_svd,
+        .core_rklimit        = core_get_rklimit_max,
     };
     int ranks[3], r, s, i, j, l, meth;
     int err  = 0;
     int ret  = 0;
     int mode = 0;
 
-    core_get_rklimit = core_get_rklimit_max;
-
     for(use_reltol=0; use_reltol<2; use_reltol++) {
         lowrank.use_reltol = use_reltol;
         for (s=100; s<=200; s = 2*s) {
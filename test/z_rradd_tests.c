@@ -42,6 +42,23 @@
         printf("SUCCESS\n");                    \
     }
 
+/**
+ * @brief Default low-rank parameters of the tests
+ */
+static const pastix_lr_t z_rradd_lowrank = {
+    .compress_when       = PastixCompressWhenEnd,
+    .compress_method     = PastixCompressMethodPQRCP,
+    .compress_min_width  = 0,
+    .compress_min_height = 0,
+    .use_reltol          = 0,
+    .tolerance           = 0.,
+    .compress_min_ratio  = 1.,
+    .compress_ortho      = PastixCompressOrthoCGS,
+    .core_ge2lr          = core_zge2lr_svd,
+    .core_rradd          = core_zrradd_svd,
+    .core_rklimit        = core_get_rklimit_end,
+};
+
 int
 z_rradd_test( int mode, int use_reltol, double tolerance,
               pastix_int_t offx, pastix_int_t offy,
@@ -52,16 +69,10 @@ z_rradd_test( int mode, int use_reltol, double tolerance,
     pastix_complex64_t zalpha = -1.;
     double threshold = tolerance * tolerance;
     int i, ret, rc = 0;
-    pastix_lr_t lowrank = {
-        .compress_when       = PastixCompressWhenEnd,
-        .compress_method     = PastixCompressMethodPQRCP,
-        .compress_min_width  = 0,
-        .compress_min_height = 0,
-        .use_reltol          = use_reltol,
-        .tolerance           = tolerance,
-        .core_ge2lr          = core_zge2lr_svd,
-        .core_rradd          = core_zrradd_svd,
-    };
+    pastix_lr_t lowrank = z_rradd_lowrank;
+
+    lowrank.use_reltol = use_reltol;
+    lowrank.tolerance  = tolerance;
 
     /*
      * Lets' generate the test matrices:
@@ -95,7 +106,7 @@ z_rradd_test( int mode, int use_reltol, double tolerance,
                                   Cfr, C.ld, NULL );
 
     /* Compress C with the same citeria to get an upper bound of the rank */
-    lowrank.core_ge2lr( use_reltol, tolerance, pastix_imin( C.m, C.n ),
+    lowrank.core_ge2lr( &lowrank, use_reltol, tolerance, pastix_imin( C.m, C.n ),
                         C.m, C.n, C.fr, C.ld, &(C.lr) );
 
     fprintf( stdout, "%7s %4s %12s %12s %12s %12s (RankC=%d)\n",
@@ -200,7 +211,7 @@ int z_rradd_long()
                         for (use_reltol=0; use_reltol < 2; use_reltol++ ) {
                             printf( "  -- Test RRADD MA=LDA=%d, NA=%d, RA=%d, MB=LDB=%d, NB=%d, RB=%d, rkmax=%ld, %s\n",
                                     A.m, A.n, A.rk, B.m, B.n, B.rk,
-                                    (long)core_get_rklimit( B.m, B.n ), use_reltol ? "relative" : "absolute" );
+                                    (long)core_get_rklimit( &z_rradd_lowrank, B.m, B.n ), use_reltol ? "relative" : "absolute" );
 
                             ret = z_rradd_test( 0, use_reltol, tolerance, offx, offy, &A, &B );
                             PRINT_RES(ret);
@@ -278,7 +289,7 @@ int z_rradd_short()
         for (use_reltol=0; use_reltol < 2; use_reltol++ ) {
             printf( "  -- Test RRADD MA=LDA=%d, NA=%d, RA=%d, MB=LDB=%d, NB=%d, RB=%d, rkmax=%ld, %s\n",
                     A.m, A.n, A.rk, B.m, B.n, B.rk,
-                    (long)core_get_rklimit( B.m, B.n ), use_reltol ? "relative" : "absolute" );
+                    (long)core_get_rklimit( &z_rradd_lowrank, B.m, B.n ), use_reltol ? "relative" : "absolute" );
 
             ret = z_rradd_test( 0, use_reltol, tolerance, offx, offy, &A, &B );
             PRINT_RES(ret);